@@ -3,10 +3,33 @@ set(KSC_SOURCES
     SOURCE/SHARED/SCENE/Scene.h
     SOURCE/SHARED/SCENE/SceneFactory.cpp
     SOURCE/SHARED/SCENE/SceneFactory.h
+    SOURCE/SHARED/SCENE/SceneCompiler.cpp
+    SOURCE/SHARED/SCENE/SceneCompiler.h
+    SOURCE/SHARED/SCENE/SceneHitIndex.cpp
+    SOURCE/SHARED/SCENE/SceneHitIndex.h
+    SOURCE/SHARED/SCENE/SceneArena.cpp
+    SOURCE/SHARED/SCENE/SceneArena.h
+    SOURCE/SHARED/SCENE/nanosvg_impl.cpp
+    SOURCE/SHARED/SCENE_CACHE/SceneCache.cpp
+    SOURCE/SHARED/SCENE_CACHE/SceneCache.h
+    SOURCE/SHARED/SCENE_CACHE/ScenePrefetcher.cpp
+    SOURCE/SHARED/SCENE_CACHE/ScenePrefetcher.h
     SOURCE/SHARED/ZONE/Zone.cpp
     SOURCE/SHARED/ZONE/Zone.h
+    SOURCE/SHARED/ZONE/ZoneTable.cpp
+    SOURCE/SHARED/ZONE/ZoneTable.h
+    SOURCE/SHARED/ZONE/PolygonKernel.cpp
+    SOURCE/SHARED/ZONE/PolygonKernel.h
     SOURCE/SHARED/FILE_OPERATOR/FileOperator.h
     SOURCE/SHARED/GRAPHICS_RENDERER/GraphicsRenderer.h
+    SOURCE/SHARED/GRAPHICS_RENDERER/FramebufferGraphicsRenderer.cpp
+    SOURCE/SHARED/GRAPHICS_RENDERER/FramebufferGraphicsRenderer.h
+    SOURCE/SHARED/GRAPHICS_RENDERER/PngImage.cpp
+    SOURCE/SHARED/GRAPHICS_RENDERER/PngImage.h
+    SOURCE/SHARED/GRAPHICS_RENDERER/ImageResampler.cpp
+    SOURCE/SHARED/GRAPHICS_RENDERER/ImageResampler.h
+    SOURCE/SHARED/GRAPHICS_RENDERER/TextureCache.h
+    SOURCE/SHARED/GRAPHICS_RENDERER/ImageDecodeQueue.h
     SOURCE/SHARED/SCENE_VIEW/SceneView.h
     SOURCE/SHARED/SCENE_VIEW/SceneView.cpp
     SOURCE/SHARED/BAR/ControlBarSection.h
@@ -15,6 +38,23 @@ set(KSC_SOURCES
     SOURCE/SHARED/GAME_RUNNER/GameRunner.h
     SOURCE/SHARED/GAME_RUNNER/GameStartManager.cpp
     SOURCE/SHARED/GAME_RUNNER/GameStartManager.h
+    SOURCE/SHARED/GAME_STATE/DiscoveryBits.cpp
+    SOURCE/SHARED/GAME_STATE/DiscoveryBits.h
+    SOURCE/SHARED/GAME_STATE/SceneIDTable.cpp
+    SOURCE/SHARED/GAME_STATE/SceneIDTable.h
+    SOURCE/SHARED/GAME_STATE/SlotContainer.cpp
+    SOURCE/SHARED/GAME_STATE/SlotContainer.h
+    SOURCE/SHARED/GAME_STATE/GameState.cpp
+    SOURCE/SHARED/GAME_STATE/GameState.h
     SOURCE/SHARED/GAME_STATE/GameStateComparison.cpp
     SOURCE/SHARED/GAME_STATE/GameStateComparison.h
+    SOURCE/SHARED/GAME_STATE/GameStateMerge.cpp
+    SOURCE/SHARED/GAME_STATE/GameStateMerge.h
+    SOURCE/SHARED/NOTES/NoteBuilder.cpp
+    SOURCE/SHARED/NOTES/NoteBuilder.h
+    SOURCE/SHARED/NOTES/Notes.cpp
+    SOURCE/SHARED/NOTES/Notes.h
+    SOURCE/SHARED/UTIL/ByteIO.h
+    SOURCE/SHARED/UTIL/Fnv1a.h
+    SOURCE/SHARED/UTIL/KSC_Threads.h
 )
@@ -1,8 +1,27 @@
 set(TEST_SOURCES
     TESTS/test_Zone.cpp
+    TESTS/test_ZoneTable.cpp
+    TESTS/test_PolygonKernel.cpp
     TESTS/test_Scene.cpp
+    TESTS/test_SceneHitIndex.cpp
+    TESTS/test_SceneArena.cpp
+    TESTS/test_SceneFactory.cpp
+    TESTS/test_SceneView.cpp
+    TESTS/test_FramebufferGraphicsRenderer.cpp
+    TESTS/test_TextureCache.cpp
+    TESTS/test_ImageDecodeQueue.cpp
+    TESTS/test_ImageResampler.cpp
+    TESTS/test_SceneCompiler.cpp
+    TESTS/test_SceneCache.cpp
+    TESTS/test_ScenePrefetcher.cpp
     TESTS/test_GameStartManager.cpp
+    TESTS/test_DiscoveryBits.cpp
+    TESTS/test_GameState.cpp
     TESTS/test_GameStateComparison.cpp
+    TESTS/test_GameStateMerge.cpp
+    TESTS/test_SlotContainer.cpp
+    TESTS/test_NoteBuilder.cpp
     TESTS/test_GameRunner.cpp
     TESTS/test_AveryRootNavigation.cpp
+    TESTS/UTIL/AllocationCounter.cpp
 )
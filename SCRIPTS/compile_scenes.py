@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+"""
+Build KSC_SceneCompiler and compile every scene JSON under KSC_DATA into a
+binary .kscb record next to it. Run before sync_to_sd.py after editing scenes.
+"""
+
+from pathlib import Path
+import subprocess
+import sys
+
+ROOT = Path(__file__).parent.parent
+BUILD = ROOT / "BUILD"
+
+
+def run(cmd, cwd):
+    print("+", " ".join(str(c) for c in cmd))
+    subprocess.run(cmd, cwd=str(cwd), check=True)
+
+
+def main():
+    BUILD.mkdir(exist_ok=True)
+
+    exe = BUILD / ("KSC_SceneCompiler.exe" if sys.platform == "win32" else "KSC_SceneCompiler")
+    try:
+        run(["cmake", "-DCMAKE_BUILD_TYPE=Release", str(ROOT)], BUILD)
+        run(["cmake", "--build", ".", "--target", "KSC_SceneCompiler"], BUILD)
+        if not exe.exists():
+            exe = next(BUILD.rglob(exe.name))
+        run([str(exe), str(ROOT / "KSC_DATA")], ROOT)
+    except (subprocess.CalledProcessError, StopIteration):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -6,34 +6,42 @@
 #include "../SHARED/FILE_OPERATOR/FileOperator.h"
 #include <SD.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
  * ESP32 implementation of FileOperator.
  * Reads files from the SD card using the Arduino SD library.
+ * Writes are length-based (not NUL-terminated) so binary records survive.
  */
 class ESP32FileOperator : public FileOperator
 {
 public:
-    static std::string sdPath(const std::string& path)
+    static std::string sdPath(std::string_view path)
     {
         if (!path.empty() && path[0] == '/')
-            return std::string("/KSC_DATA") + path;
-        return path;
+            return std::string("/KSC_DATA").append(path);
+        return std::string(path);
     }
 
     std::string load(const std::string& path) override
     {
+        std::string content;
+        loadInto(path, content);
+        return content;
+    }
+
+    void loadInto(const std::string& path, std::string& out) override
+    {
+        out.clear();
         File file = SD.open(sdPath(path).c_str());
         if (!file)
-            return "";
-
-        std::string content;
-        while (file.available())
-            content += static_cast<char>(file.read());
+            return;
 
+        // One bulk read instead of a byte-at-a-time loop over the SD bus.
+        out.resize(file.size());
+        out.resize(file.read(reinterpret_cast<uint8_t*>(&out[0]), out.size()));
         file.close();
-        return content;
     }
 
     void writeToFile(const std::string& path, const std::string& content) override
@@ -41,7 +49,7 @@ public:
         File file = SD.open(sdPath(path).c_str(), FILE_WRITE);
         if (file)
         {
-            file.print(content.c_str());
+            file.write(reinterpret_cast<const uint8_t*>(content.data()), content.size());
             file.close();
         }
     }
@@ -51,7 +59,7 @@ public:
         File file = SD.open(sdPath(path).c_str(), FILE_APPEND);
         if (file)
         {
-            file.print(content.c_str());
+            file.write(reinterpret_cast<const uint8_t*>(content.data()), content.size());
             file.close();
         }
     }
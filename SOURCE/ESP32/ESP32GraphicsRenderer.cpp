@@ -2,6 +2,8 @@
 #include "ESP32FileOperator.h"
 #include <PNGdec.h>
 #include <SD.h>
+#include <cstdio>
+#include <cstring>
 
 // ---------------------------------------------------------------------------
 // PNG decode state — persistent allocations, not stack variables
@@ -54,7 +56,7 @@ ESP32GraphicsRenderer::ESP32GraphicsRenderer(TFT_eSPI& tft)
     sDrawTft = &tft;
 }
 
-void ESP32GraphicsRenderer::drawImage(const std::string& path)
+void ESP32GraphicsRenderer::drawImage(std::string_view path)
 {
     std::string full = ESP32FileOperator::sdPath(path);
     Serial.printf("[IMG] drawImage: %s\n", full.c_str());
@@ -74,7 +76,7 @@ void ESP32GraphicsRenderer::drawImage(const std::string& path)
     }
 }
 
-void ESP32GraphicsRenderer::drawText(const std::string& path, int x, int y)
+void ESP32GraphicsRenderer::drawText(std::string_view path, int x, int y)
 {
     File file = SD.open(ESP32FileOperator::sdPath(path).c_str(), FILE_READ);
     if (!file) return;
@@ -103,17 +105,21 @@ void ESP32GraphicsRenderer::drawText(const std::string& path, int x, int y)
     file.close();
 }
 
-void ESP32GraphicsRenderer::drawSVG(const std::string& /*path*/,
+void ESP32GraphicsRenderer::drawSVG(std::string_view /*path*/,
                                     int /*x*/, int /*y*/,
                                     int /*w*/, int /*h*/) {}
 
-void ESP32GraphicsRenderer::drawButton(const std::string& label, int x, int y, int w, int h)
+void ESP32GraphicsRenderer::drawButton(std::string_view label, int x, int y, int w, int h)
 {
+    // TFT_eSPI wants a C string; labels are short, so copy onto the stack.
+    char text[64];
+    snprintf(text, sizeof(text), "%.*s", (int)label.size(), label.data());
+
     mTft.fillRect(x, y, w, h, TFT_BLACK);
     mTft.drawRect(x, y, w, h, TFT_WHITE);
     mTft.setTextSize(1);
     mTft.setTextColor(TFT_WHITE, TFT_BLACK);
-    int textX = x + (w - (int)label.size() * 6) / 2;
+    int textX = x + (w - (int)strlen(text) * 6) / 2;
     int textY = y + (h - 8) / 2;
-    mTft.drawString(label.c_str(), textX, textY);
+    mTft.drawString(text, textX, textY);
 }
@@ -18,10 +18,10 @@ class ESP32GraphicsRenderer : public GraphicsRenderer
 public:
     explicit ESP32GraphicsRenderer(TFT_eSPI& tft);
 
-    void drawImage(const std::string& path) override;
-    void drawText(const std::string& path, int x, int y) override;
-    void drawSVG(const std::string& path, int x, int y, int w = 0, int h = 0) override;
-    void drawButton(const std::string& label, int x, int y, int w, int h) override;
+    void drawImage(std::string_view path) override;
+    void drawText(std::string_view path, int x, int y) override;
+    void drawSVG(std::string_view path, int x, int y, int w = 0, int h = 0) override;
+    void drawButton(std::string_view label, int x, int y, int w, int h) override;
 
 private:
     TFT_eSPI& mTft;
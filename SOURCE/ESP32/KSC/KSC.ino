@@ -133,6 +133,8 @@ void setup()
     gRenderer     = new ESP32GraphicsRenderer(gTft);
     gGame         = new GameRunner(*gFileOperator, *gRenderer, "locations", "", "", "/KSC_GAME/SAVED_GAMES");
 
+    gGame->enablePrefetch(2, false); // single-threaded: built from loop() while idle
+    gGame->enableSceneArena(8 * 1024); // one reusable buffer for scenes too large to cache
     gGame->loadScene("/BANNERS/START_SCREEN/Start_Screen.json");
 
     touchInit();
@@ -159,6 +161,10 @@ void loop()
     }
     gPrevTouched = touched;
 
+    // --- Idle work (prefetch the scenes reachable from this one) ---
+    if (!touched && !gNeedsRedraw)
+        gGame->idle();
+
     // --- Draw (only when scene has changed) ---
     if (gNeedsRedraw)
     {
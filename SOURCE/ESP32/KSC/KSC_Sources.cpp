@@ -8,10 +8,24 @@
 
 // Shared game logic
 #include "../../SHARED/ZONE/Zone.cpp"
+#include "../../SHARED/ZONE/ZoneTable.cpp"
+#include "../../SHARED/ZONE/PolygonKernel.cpp"
+#include "../../SHARED/SCENE/SceneArena.cpp"
 #include "../../SHARED/SCENE/Scene.cpp"
+#include "../../SHARED/SCENE/SceneHitIndex.cpp"
 #include "../../SHARED/SCENE/SceneFactory.cpp"
+#include "../../SHARED/SCENE/SceneCompiler.cpp"
+#include "../../SHARED/SCENE_CACHE/SceneCache.cpp"
+#include "../../SHARED/SCENE_CACHE/ScenePrefetcher.cpp"
 #include "../../SHARED/SCENE_VIEW/SceneView.cpp"
 #include "../../SHARED/CONTROLS_VIEW/ControlsView.cpp"
+#include "../../SHARED/NOTES/Notes.cpp"
+#include "../../SHARED/NOTES/NoteBuilder.cpp"
+#include "../../SHARED/GAME_STATE/DiscoveryBits.cpp"
+#include "../../SHARED/GAME_STATE/SceneIDTable.cpp"
+#include "../../SHARED/GAME_STATE/SlotContainer.cpp"
+#include "../../SHARED/GAME_STATE/GameState.cpp"
 #include "../../SHARED/GAME_STATE/GameStateComparison.cpp"
+#include "../../SHARED/GAME_STATE/GameStateMerge.cpp"
 #include "../../SHARED/GAME_RUNNER/GameStartManager.cpp"
 #include "../../SHARED/GAME_RUNNER/GameRunner.cpp"
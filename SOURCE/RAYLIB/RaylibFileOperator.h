@@ -6,7 +6,6 @@
 #include "../SHARED/FILE_OPERATOR/FileOperator.h"
 #include <filesystem>
 #include <fstream>
-#include <sstream>
 #include <vector>
 
 /**
@@ -16,20 +15,31 @@
  * Paths are data-root-relative (e.g. "/LOCATIONS/DESK/MAIN/Desk_Full.json").
  * The "KSC_DATA" directory in the working directory is treated as the data root,
  * so a leading '/' is replaced with "KSC_DATA/".
+ *
+ * Files are opened in binary mode so compiled scene records round-trip intact.
  */
 class RaylibFileOperator : public FileOperator
 {
 public:
     std::string load(const std::string& path) override
     {
-        std::string fullPath = sdPath(path);
-        std::ifstream file(fullPath);
-        if (!file.is_open())
-            return "";
+        std::string content;
+        loadInto(path, content);
+        return content;
+    }
+
+    void loadInto(const std::string& path, std::string& out) override
+    {
+        out.clear();
+        std::ifstream file(sdPath(path), std::ios::binary | std::ios::ate);
+        std::streamoff size = file.is_open() ? static_cast<std::streamoff>(file.tellg()) : -1;
+        if (size < 0)
+            return;
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
+        out.resize(static_cast<size_t>(size));
+        file.seekg(0);
+        file.read(&out[0], static_cast<std::streamsize>(out.size()));
+        out.resize(static_cast<size_t>(file.gcount()));
     }
 
     void writeToFile(const std::string& path, const std::string& content) override
@@ -37,14 +47,14 @@ public:
         namespace fs = std::filesystem;
         fs::path full = sdPath(path);
         fs::create_directories(full.parent_path());
-        std::ofstream file(full);
+        std::ofstream file(full, std::ios::binary);
         if (file.is_open())
             file << content;
     }
 
     void appendToFile(const std::string& path, const std::string& content) override
     {
-        std::ofstream file(sdPath(path), std::ios::app);
+        std::ofstream file(sdPath(path), std::ios::app | std::ios::binary);
         if (file.is_open())
             file << content;
     }
@@ -1,10 +1,13 @@
 #include "RaylibGraphicsRenderer.h"
+#include "../SHARED/GRAPHICS_RENDERER/ImageResampler.h"
 #include "../../THIRD_PARTY/nanosvg/nanosvg.h"
 #include "../../THIRD_PARTY/nanosvg/nanosvgrast.h"
+#include <cstdio>
 #include <fstream>
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cmath>
 
 // ---------------------------------------------------------------------------
 // Helpers — all rendering uses 320x240 virtual coordinates.
@@ -36,10 +39,69 @@ static float gp(float v)  { return v * gameScale(); }
 
 // ---------------------------------------------------------------------------
 
+// GPU bytes of a texture, as uploaded: RGBA8, plus a third for any mip chain.
+static size_t textureBytes(const Texture2D& tex)
+{
+    size_t bytes = (size_t)tex.width * tex.height * 4;
+    return tex.mipmaps > 1 ? bytes + bytes / 3 : bytes;
+}
+
+// The game area in window pixels, packed w << 16 | h.
+static uint32_t gameAreaSize()
+{
+    int w = (int)std::ceil(gp(320)), h = (int)std::ceil(gp(240));
+    return (uint32_t)std::clamp(w, 0, 0xFFFF) << 16 | (uint32_t)std::clamp(h, 0, 0xFFFF);
+}
+
+// Runs on a decode worker: load path and, if it is larger than the game area
+// (targetSize, 0 for unknown), box-filter it down to that. Each axis shrinks
+// on its own, since blitFullScreen() stretches each axis on its own.
+static bool decodeForSize(const std::string& path, RaylibGraphicsRenderer::DecodedImage& decoded,
+                          uint32_t targetSize)
+{
+    Image& image = decoded.image;
+    image = LoadImage(path.c_str());
+    if (image.data == nullptr) return false;
+
+    decoded.targetW = (int)(targetSize >> 16);
+    decoded.targetH = (int)(targetSize & 0xFFFF);
+    if (decoded.targetW == 0 || decoded.targetH == 0) return true;
+
+    const int k = ImageResampler::k_MaxFactor;
+    int w = std::max(std::min(image.width,  decoded.targetW), (image.width  + k - 1) / k);
+    int h = std::max(std::min(image.height, decoded.targetH), (image.height + k - 1) / k);
+    if (w == image.width && h == image.height) return true;
+
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    void* pixels = MemAlloc((unsigned int)(w * h * 4));
+    if (!ImageResampler::downsample(static_cast<const uint8_t*>(image.data), image.width, image.height,
+                                    static_cast<uint8_t*>(pixels), w, h))
+    {
+        MemFree(pixels);
+        return true; // full size still draws correctly
+    }
+    UnloadImage(image);
+    image          = { pixels, w, h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    decoded.shrunk = true;
+    return true;
+}
+
+RaylibGraphicsRenderer::RaylibGraphicsRenderer(size_t textureBudgetBytes, unsigned decodeThreads)
+: mTextures(textureBudgetBytes, [](Texture2D& tex) { UnloadTexture(tex); })
+, mTargetSize(gameAreaSize())
+, mDecoder([this](const std::string& path, DecodedImage& decoded)
+           {
+               // CPU-only (file read, PNG decode, resample), so safe off the render thread.
+               return decodeForSize(path, decoded, mTargetSize.load());
+           },
+           [](DecodedImage& decoded) { UnloadImage(decoded.image); },
+           decodeThreads)
+{
+}
+
 RaylibGraphicsRenderer::~RaylibGraphicsRenderer()
 {
-    if (mCachedTexture.id > 0)
-        UnloadTexture(mCachedTexture);
+    mTextures.clear();
     for (auto& [path, tex] : mSvgCache)
         if (tex.id > 0)
             UnloadTexture(tex);
@@ -47,11 +109,11 @@ RaylibGraphicsRenderer::~RaylibGraphicsRenderer()
         UnloadFont(mFont);
 }
 
-std::string RaylibGraphicsRenderer::sdPath(const std::string& path)
+std::string RaylibGraphicsRenderer::sdPath(std::string_view path)
 {
     if (!path.empty() && path[0] == '/')
-        return "KSC_DATA" + path;
-    return path;
+        return std::string("KSC_DATA").append(path);
+    return std::string(path);
 }
 
 void RaylibGraphicsRenderer::toGameCoords(int screenX, int screenY,
@@ -64,12 +126,17 @@ void RaylibGraphicsRenderer::toGameCoords(int screenX, int screenY,
 }
 
 // -----------------------------------------------------------------
-void RaylibGraphicsRenderer::drawImage(const std::string& path)
+void RaylibGraphicsRenderer::drawImage(std::string_view path)
 {
-    drawPng(sdPath(path));
+    drawPng(sdPath(path), "");
 }
 
-void RaylibGraphicsRenderer::drawText(const std::string& path, int /*x*/, int y)
+void RaylibGraphicsRenderer::drawProgressiveImage(std::string_view path, std::string_view loresPath)
+{
+    drawPng(sdPath(path), loresPath.empty() ? "" : sdPath(loresPath));
+}
+
+void RaylibGraphicsRenderer::drawText(std::string_view path, int /*x*/, int y)
 {
     std::string full = sdPath(path);
     if (y > 0)
@@ -84,7 +151,7 @@ void RaylibGraphicsRenderer::drawText(const std::string& path, int /*x*/, int y)
     }
 }
 
-void RaylibGraphicsRenderer::drawSVG(const std::string& path, int x, int y, int w, int h)
+void RaylibGraphicsRenderer::drawSVG(std::string_view path, int x, int y, int w, int h)
 {
     drawSvgAt(sdPath(path), x, y, w, h);
 }
@@ -94,19 +161,47 @@ void RaylibGraphicsRenderer::drawRect(int x, int y, int w, int h)
     DrawRectangleLinesEx({ gx(x), gy(y), gp(w), gp(h) }, 1.0f, { 255, 255, 0, 200 });
 }
 
-void RaylibGraphicsRenderer::drawPolygon(const std::vector<std::pair<int, int>>& points)
+void RaylibGraphicsRenderer::drawPolygon(const int16_t* xs, const int16_t* ys, int count)
 {
-    if (points.size() < 2) return;
-    int n = (int)points.size();
-    for (int i = 0; i < n; i++)
+    if (count < 2) return;
+    for (int i = 0; i < count; i++)
     {
-        int j = (i + 1) % n;
-        DrawLine((int)gx(points[i].first), (int)gy(points[i].second),
-                 (int)gx(points[j].first), (int)gy(points[j].second),
+        int j = (i + 1) % count;
+        DrawLine((int)gx(xs[i]), (int)gy(ys[i]),
+                 (int)gx(xs[j]), (int)gy(ys[j]),
                  { 255, 255, 0, 200 });
     }
 }
 
+void RaylibGraphicsRenderer::pinImages(const std::vector<std::string>& paths)
+{
+    mPinned.clear();
+    for (const auto& path : paths)
+        mPinned.push_back(sdPath(path));
+    applyPins();
+
+    // Decode the neighbours ahead of need; scenes left behind are not worth finishing.
+    mDecoder.retainOnly(mPinned);
+    for (const auto& path : mPinned)
+        if ((!mTextures.contains(path) || isStale(path)) && !mMissing.count(path))
+            mDecoder.request(path, false);
+}
+
+void RaylibGraphicsRenderer::setTextureBudget(size_t budgetBytes)
+{
+    mTextures.setBudget(budgetBytes);
+}
+
+TextureCache<Texture2D>::Stats RaylibGraphicsRenderer::getTextureCacheStats() const
+{
+    return mTextures.getStats();
+}
+
+ImageDecodeQueue<RaylibGraphicsRenderer::DecodedImage>::Stats RaylibGraphicsRenderer::getDecodeStats() const
+{
+    return mDecoder.getStats();
+}
+
 void RaylibGraphicsRenderer::beginContentArea(int x, int y, int w, int h)
 {
     BeginScissorMode((int)gx(x), (int)gy(y), (int)gp(w), (int)gp(h));
@@ -117,8 +212,12 @@ void RaylibGraphicsRenderer::endContentArea()
     EndScissorMode();
 }
 
-void RaylibGraphicsRenderer::drawButton(const std::string& label, int x, int y, int w, int h)
+void RaylibGraphicsRenderer::drawButton(std::string_view label, int x, int y, int w, int h)
 {
+    // Raylib wants a C string; labels are short, so copy onto the stack.
+    char text[64];
+    snprintf(text, sizeof(text), "%.*s", (int)label.size(), label.data());
+
     if (mFont.texture.id == 0)
         mFont = LoadFontEx("KSC_DATA/GUI/ASSETS/OcrB2.ttf", 32, nullptr, 0);
 
@@ -127,33 +226,124 @@ void RaylibGraphicsRenderer::drawButton(const std::string& label, int x, int y,
     DrawRectangleLines((int)bx, (int)by, (int)bw, (int)bh, WHITE);
 
     float    fontSize = gp(9);
-    Vector2  textSize = MeasureTextEx(mFont, label.c_str(), fontSize, 1.0f);
-    DrawTextEx(mFont, label.c_str(),
+    Vector2  textSize = MeasureTextEx(mFont, text, fontSize, 1.0f);
+    DrawTextEx(mFont, text,
                { bx + (bw - textSize.x) / 2.0f,
                  by + (bh - textSize.y) / 2.0f },
                fontSize, 1.0f, WHITE);
 }
 
 // -----------------------------------------------------------------
-void RaylibGraphicsRenderer::drawPng(const std::string& fullPath)
+void RaylibGraphicsRenderer::drawPng(const std::string& fullPath, const std::string& loresPath)
+{
+    updateTargetSize();
+    uploadDecoded();
+
+    // Frames spent waiting on a decode already in flight are not misses.
+    bool pending = mDecoder.isRequested(fullPath) && !mTextures.contains(fullPath);
+    if (const Texture2D* tex = pending ? nullptr : mTextures.find(fullPath))
+    {
+        // A texture sized for the old window stays up until its redo is uploaded.
+        if (isStale(fullPath))
+            mDecoder.request(fullPath, true);
+        blitFullScreen(*tex);
+        if (mShownPath != fullPath)
+        {
+            mShownPath = fullPath;
+            applyPins();
+        }
+        return;
+    }
+    if (mMissing.count(fullPath)) return;
+    mDecoder.request(fullPath, true);
+
+    // Until it is uploaded: the lores image (requested last, so decoded
+    // first), else whatever was on screen before.
+    if (!loresPath.empty() && !mMissing.count(loresPath))
+    {
+        if (mTextures.contains(loresPath))
+        {
+            blitFullScreen(*mTextures.find(loresPath));
+            return;
+        }
+        mDecoder.request(loresPath, true);
+    }
+    if (mTextures.contains(mShownPath))
+        blitFullScreen(*mTextures.find(mShownPath));
+}
+
+void RaylibGraphicsRenderer::applyPins()
+{
+    // The shown texture is the placeholder while the next scene decodes.
+    std::vector<std::string> pinned = mPinned;
+    if (!mShownPath.empty()) pinned.push_back(mShownPath);
+    mTextures.setPinned(pinned);
+}
+
+void RaylibGraphicsRenderer::blitFullScreen(const Texture2D& tex)
 {
-    if (fullPath != mCachedPath)
+    Rectangle src = { 0, 0, (float)tex.width, (float)tex.height };
+    Vector2 off = gameOffset();
+    float   s   = gameScale();
+    Rectangle dst = { off.x, off.y, 320.0f * s, 240.0f * s };
+    DrawTexturePro(tex, src, dst, {0, 0}, 0.0f, WHITE);
+}
+
+void RaylibGraphicsRenderer::uploadDecoded()
+{
+    // One upload per frame: a hi-res texture is tens of megabytes of bus traffic.
+    mDecoder.drain(1, [this](const std::string& path, DecodedImage& decoded, bool ok)
     {
-        if (mCachedTexture.id > 0)
-            UnloadTexture(mCachedTexture);
-        mCachedTexture = LoadTexture(fullPath.c_str());
-        mCachedPath    = fullPath;
+        Texture2D tex = {};
+        if (ok)
+        {
+            tex = LoadTextureFromImage(decoded.image);
+            UnloadImage(decoded.image);
+        }
+        if (tex.id == 0)
+        {
+            mMissing.insert(path);
+            return;
+        }
+        mTextures.insert(path, tex, textureBytes(tex));
+        mVariants[path] = { decoded.targetW, decoded.targetH, tex.width, tex.height, decoded.shrunk };
+    });
+}
+
+void RaylibGraphicsRenderer::updateTargetSize()
+{
+    uint32_t size = gameAreaSize();
+    if ((size >> 16) == 0 || (size & 0xFFFF) == 0) return; // minimized
+    if (size == mTargetSize.load())
+    {
+        mSettledFrames = 0;
+        return;
     }
-    if (mCachedTexture.id > 0)
+    if (size != mSettlingSize)
     {
-        Rectangle src = { 0, 0,
-                          (float)mCachedTexture.width,
-                          (float)mCachedTexture.height };
-        Vector2 off = gameOffset();
-        float   s   = gameScale();
-        Rectangle dst = { off.x, off.y, 320.0f * s, 240.0f * s };
-        DrawTexturePro(mCachedTexture, src, dst, {0, 0}, 0.0f, WHITE);
+        mSettlingSize  = size;
+        mSettledFrames = 0;
     }
+    if (++mSettledFrames < k_ResizeSettleFrames) return;
+
+    mTargetSize    = size;
+    mSettledFrames = 0;
+    // The on-screen image is redone by drawPng(); redo the neighbours too.
+    for (const auto& path : mPinned)
+        if (mTextures.contains(path) && isStale(path))
+            mDecoder.request(path, false);
+}
+
+bool RaylibGraphicsRenderer::isStale(const std::string& fullPath) const
+{
+    auto it = mVariants.find(fullPath);
+    if (it == mVariants.end()) return false;
+    const Variant& v = it->second;
+    uint32_t size    = mTargetSize.load();
+    int      targetW = (int)(size >> 16), targetH = (int)(size & 0xFFFF);
+    if (v.targetW == targetW && v.targetH == targetH) return false;
+    // A full-size image stays sharp in a bigger window; only shrinking redoes it.
+    return v.shrunk || v.width > targetW || v.height > targetH;
 }
 
 void RaylibGraphicsRenderer::drawSvgAt(const std::string& fullPath,
@@ -4,15 +4,30 @@
 
 #pragma once
 #include "../SHARED/GRAPHICS_RENDERER/GraphicsRenderer.h"
+#include "../SHARED/GRAPHICS_RENDERER/ImageDecodeQueue.h"
+#include "../SHARED/GRAPHICS_RENDERER/TextureCache.h"
 #include "raylib.h"
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 /**
  * Raylib (desktop) implementation of GraphicsRenderer.
  *
  * drawImage  — loads a PNG as a Raylib texture and blits it at the origin.
- *              The most recently loaded texture is cached.
+ *              Textures stay in an LRU cache under a VRAM byte budget, and
+ *              pinImages() keeps the scene's parent and children resident,
+ *              so navigating back and forth never reloads them.
+ *              PNGs are decoded on worker threads (ImageDecodeQueue), pinned
+ *              ones ahead of need; the render thread only uploads, one
+ *              texture per frame. Until a PNG is uploaded the previous image
+ *              stays on screen. Images larger than the window's game area
+ *              are box-filtered down to it on the worker (ImageResampler),
+ *              and redone once a resize settles.
+ * drawProgressiveImage — as drawImage, but shows the scene's lores image
+ *              while the hi-res one decodes and swaps it in when uploaded.
  * drawText   — reads a markdown file line by line and renders it as plain text.
  *              When y > 0 (overlay mode) a semi-transparent backdrop is drawn
  *              before the text and the text is rendered at reduced scale.
@@ -22,28 +37,73 @@
 class RaylibGraphicsRenderer : public GraphicsRenderer
 {
 public:
+    static constexpr size_t   k_DefaultTextureBudget = 512u * 1024 * 1024;
+    static constexpr unsigned k_DefaultDecodeThreads = 2;
+
+    explicit RaylibGraphicsRenderer(size_t   textureBudgetBytes = k_DefaultTextureBudget,
+                                    unsigned decodeThreads      = k_DefaultDecodeThreads);
     ~RaylibGraphicsRenderer();
 
-    void drawImage(const std::string& path) override;
-    void drawText(const std::string& path, int x, int y) override;
-    void drawSVG(const std::string& path, int x, int y, int w = 0, int h = 0) override;
-    void drawButton(const std::string& label, int x, int y, int w, int h) override;
+    void drawImage(std::string_view path) override;
+    void drawProgressiveImage(std::string_view path, std::string_view loresPath) override;
+    void drawText(std::string_view path, int x, int y) override;
+    void drawSVG(std::string_view path, int x, int y, int w = 0, int h = 0) override;
+    void drawButton(std::string_view label, int x, int y, int w, int h) override;
     void drawRect(int x, int y, int w, int h) override;
-    void drawPolygon(const std::vector<std::pair<int, int>>& points) override;
+    void drawPolygon(const int16_t* xs, const int16_t* ys, int count) override;
     void beginContentArea(int x, int y, int w, int h) override;
     void endContentArea() override;
+    void pinImages(const std::vector<std::string>& paths) override;
+
+    /** Change the texture cache's VRAM byte budget, evicting if it shrank. */
+    void                           setTextureBudget(size_t budgetBytes);
+    TextureCache<Texture2D>::Stats getTextureCacheStats() const;
+
+    /** A decoded PNG, as sized on the decode worker for the window at the time. */
+    struct DecodedImage
+    {
+        Image image   = {};
+        int   targetW = 0;     // game area size in pixels it was decoded for
+        int   targetH = 0;
+        bool  shrunk  = false; // downsampled from the source
+    };
+    ImageDecodeQueue<DecodedImage>::Stats getDecodeStats() const;
 
     /** Convert a screen-space pixel position to 320x240 game coordinates. */
     void toGameCoords(int screenX, int screenY, int& gameX, int& gameY) const;
 
 private:
-    std::string mCachedPath;
-    Texture2D   mCachedTexture = {};
+    // Frames a new window size must hold before images are resized for it,
+    // so dragging the window edge does not re-decode every frame.
+    static constexpr int k_ResizeSettleFrames = 15;
+
+    // What an uploaded texture was made for; see isStale().
+    struct Variant
+    {
+        int  targetW = 0, targetH = 0; // game area size when decoded
+        int  width   = 0, height  = 0; // texture size
+        bool shrunk  = false;
+    };
+
+    TextureCache<Texture2D>         mTextures;
+    std::atomic<uint32_t>           mTargetSize{ 0 };  // game area, w << 16 | h; read by the decode workers
+    uint32_t                        mSettlingSize  = 0;
+    int                             mSettledFrames = 0;
+    ImageDecodeQueue<DecodedImage>  mDecoder;
+    std::unordered_set<std::string> mMissing;   // PNGs that failed to load, never retried
+    std::string                     mShownPath; // last PNG drawn in full, the fallback placeholder; pinned
+    std::unordered_map<std::string, Variant> mVariants; // by path, for uploaded PNGs
+    std::vector<std::string>        mPinned;    // full paths from the last pinImages()
     std::unordered_map<std::string, Texture2D> mSvgCache;
     Font        mFont          = {};
 
-    static std::string sdPath(const std::string& path);
-    void drawPng(const std::string& fullPath);
+    static std::string sdPath(std::string_view path);
+    void drawPng(const std::string& fullPath, const std::string& loresPath);
+    void blitFullScreen(const Texture2D& tex);
+    void applyPins();
+    void uploadDecoded();
+    void updateTargetSize();
+    bool isStale(const std::string& fullPath) const;
     void drawMarkdown(const std::string& fullPath, int startY = 10, float textScale = 1.0f, bool applyScroll = false);
     void drawSvgAt(const std::string& fullPath, int x, int y, int targetW = 0, int targetH = 0);
 };
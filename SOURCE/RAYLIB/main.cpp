@@ -37,6 +37,7 @@ int main()
     RaylibGraphicsRenderer renderer;
     GameRunner             game(fileParser, renderer, "locations", "", "C:/KSC_GAME/SAVED_GAMES", true);
 
+    game.enablePrefetch(4, true);
     game.loadScene("/BANNERS/START_SCREEN/Start_Screen.json");
 
     while (!WindowShouldClose())
@@ -54,6 +55,8 @@ int main()
         if (wheel != 0)
             game.scroll((int)(-wheel * 30));
 
+        game.idle();
+
         // Enforce 4:3 aspect ratio on resize — snap height to match width.
         if (IsWindowResized())
             SetWindowSize(GetScreenWidth(), GetScreenWidth() * 3 / 4);
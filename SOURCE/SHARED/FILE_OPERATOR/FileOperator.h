@@ -21,6 +21,14 @@ public:
      */
     virtual std::string load(const std::string& path) = 0;
 
+    /**
+     * load() into out, replacing its contents; out is left empty if the file
+     * cannot be opened. Platforms override this to read into out's existing
+     * capacity, so a caller that keeps out across reads stops allocating for
+     * the contents. The default copies the result of load().
+     */
+    virtual void loadInto(const std::string& path, std::string& out) { out = load(path); }
+
     /**
      * Write content to the file at the given path, overwriting any existing data.
      */
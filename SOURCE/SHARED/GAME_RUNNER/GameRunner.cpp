@@ -2,9 +2,36 @@
 #include "../FILE_OPERATOR/FileOperator.h"
 #include "../GRAPHICS_RENDERER/GraphicsRenderer.h"
 #include "../SCENE/Scene.h"
+#include "../SCENE/SceneCompiler.h"
 #include <algorithm>
+#include <chrono>
 #include <nlohmann/json.hpp>
 
+#ifdef ARDUINO
+static const size_t k_DefaultSceneCacheBudget = 16 * 1024;        // a handful of small scenes
+#else
+static const size_t k_DefaultSceneCacheBudget = 8 * 1024 * 1024;
+#endif
+
+// How long game-state changes may wait in memory before idle() writes them.
+static const auto k_GameStateFlushDelay = std::chrono::seconds(2);
+
+// Journal size at which idle() folds it back into Game_State.json.
+static const size_t k_JournalCompactBytes = 1024;
+
+static const std::string k_AveryRootPath = "/LOCATIONS/AVERY/ROOT/Avery_Full.json";
+static const std::string k_NotesStateDir = "/GAME_STATE/NOTES_STATE/";
+static const std::string k_LocationsDir  = "/LOCATIONS/";
+
+// Sets list[count] to value and advances count, reusing the string already in
+// that slot so a list rebuilt the same size stops allocating.
+static void assignAt(std::vector<std::string>& list, size_t& count, std::string_view value)
+{
+    if (count < list.size()) list[count].assign(value);
+    else                     list.emplace_back(value);
+    count++;
+}
+
 GameRunner::GameRunner(FileOperator& fileParser, GraphicsRenderer& renderer,
                        std::string mode, std::string locationID,
                        std::string saveDir, bool useHires)
@@ -15,15 +42,29 @@ GameRunner::GameRunner(FileOperator& fileParser, GraphicsRenderer& renderer,
 , mBottomBar(renderer)
 , mSceneFactory(useHires)
 , mGameStartManager(fileParser, std::move(saveDir))
+, mSceneCache(k_DefaultSceneCacheBudget)
 , mCurrentMode(mode)
 , mCurrentLocationID(locationID)
 {
     mTopBar.load(mFileOperator.load("/GUI/Top_Bar.json"));
     mBottomBar.load(mFileOperator.load("/GUI/Bottom_Bar.json"));
+    SceneIDTable sceneIDs;
+    sceneIDs.load(mFileOperator.load(SceneIDTable::k_Path));
+    mGameState.setSceneIDs(std::move(sceneIDs));
+    mGameState.load(mFileOperator.load(GameState::k_Path));
+    mGameState.replayJournal(mFileOperator.load(GameState::k_JournalPath));
+}
+
+GameRunner::~GameRunner()
+{
+    // Stop background loads before writing through the same FileOperator.
+    mPrefetcher.reset();
+    flushGameState();
 }
 
 void GameRunner::draw()
 {
+    if (!mResumeScenePath.empty()) resumeScene();
     if (!mActiveScene) return;
     mRenderer.setScrollOffset(mScrollOffset);
     mSceneView.draw(*mActiveScene, mOverlayVisible, mZoneDisplayVisible);
@@ -36,6 +77,7 @@ void GameRunner::draw()
 
 void GameRunner::registerHit(int x, int y)
 {
+    if (!mResumeScenePath.empty()) resumeScene();
     if (!mActiveScene) return;
 
     std::string cb = mTopBar.handleHit(x, y);
@@ -48,34 +90,25 @@ void GameRunner::registerHit(int x, int y)
 
     if (mFileMenuVisible && mFileMenuScene)
     {
-        std::string target = mFileMenuScene->getInterceptingZoneTarget(x, y);
-        if (!target.empty())
-        {
-            mFileMenuVisible = false;
-            loadScene(target);
-            return;
-        }
         mFileMenuVisible = false;
+        Scene::HitResult hit = mFileMenuScene->hitTest(x, y);
+        if (!hit.target.empty())
+            loadScene(std::string(hit.target));
         return;
     }
 
-    std::string noteTarget = mActiveScene->getInterceptingZoneNoteTarget(x, y);
-    if (!noteTarget.empty())
-    {
-        discoverNote(noteTarget);
-        return;
-    }
-
-    std::string target = mActiveScene->getInterceptingZoneTarget(x, y);
-    if (!target.empty())
-    {
-        loadScene(target);
-        return;
-    }
-
-    std::string zoneId = mActiveScene->getInterceptingZoneID(x, y);
-    if (!zoneId.empty())
-        dispatchCallback(zoneId);
+    // One lookup resolves the zone; a note target takes priority over
+    // navigation, which takes priority over a zone callback. The views are
+    // copied because each handler may replace the active scene.
+    Scene::HitResult hit = mActiveScene->hitTest(x, y);
+    if (!hit) return;
+
+    if (!hit.noteTarget.empty())
+        discoverNote(std::string(hit.noteTarget));
+    else if (!hit.target.empty())
+        loadScene(std::string(hit.target));
+    else if (!hit.zoneID.empty())
+        dispatchCallback(std::string(hit.zoneID));
 }
 
 void GameRunner::dispatchCallback(const std::string& callbackId)
@@ -91,28 +124,31 @@ void GameRunner::dispatchCallback(const std::string& callbackId)
     }
     else if (callbackId == "navigateUp")
     {
-        std::string parent = mActiveScene->getParentPath();
+        std::string parent(mActiveScene->getParentPath());
         if (!parent.empty()) loadScene(parent);
     }
     else if (callbackId == "navigatePrev")
     {
-        if (mCurrentMode == "notes" && !mNoteList.empty())
+        const Notes& notes = mGameState.getNotes();
+        if (mCurrentMode == "notes" && !notes.empty())
         {
-            mNoteIndex = (mNoteIndex - 1 + (int)mNoteList.size()) % (int)mNoteList.size();
-            loadNote(mNoteList[mNoteIndex]);
+            mNoteIndex = (mNoteIndex - 1 + (int)notes.size()) % (int)notes.size();
+            loadNote(notes[mNoteIndex]);
         }
     }
     else if (callbackId == "navigateNext")
     {
-        if (mCurrentMode == "notes" && !mNoteList.empty())
+        const Notes& notes = mGameState.getNotes();
+        if (mCurrentMode == "notes" && !notes.empty())
         {
-            mNoteIndex = (mNoteIndex + 1) % (int)mNoteList.size();
-            loadNote(mNoteList[mNoteIndex]);
+            mNoteIndex = (mNoteIndex + 1) % (int)notes.size();
+            loadNote(notes[mNoteIndex]);
         }
     }
     else if (callbackId == "switchToLocations")
     {
         mCurrentMode = "locations";
+        mGameState.setCurrentMode(mCurrentMode);
         if (!mLastLocationPath.empty())
             loadScene(mLastLocationPath);
         else
@@ -121,16 +157,10 @@ void GameRunner::dispatchCallback(const std::string& callbackId)
     else if (callbackId == "switchToNotes")
     {
         mCurrentMode = "notes";
-        if (mNoteList.empty())
-        {
-            std::string stateJson = mFileOperator.load("/GAME_STATE/Game_State.json");
-            nlohmann::json j = nlohmann::json::parse(stateJson, nullptr, false);
-            if (!j.is_discarded() && j.contains("notes"))
-                for (auto& n : j["notes"])
-                    mNoteList.push_back(n.get<std::string>());
-        }
-        if (!mNoteList.empty())
-            loadNote(mNoteList[mNoteIndex]);
+        mGameState.setCurrentMode(mCurrentMode);
+        const Notes& notes = mGameState.getNotes();
+        if (!notes.empty())
+            loadNote(notes[mNoteIndex]);
         else
             syncControlsState();
     }
@@ -145,8 +175,13 @@ void GameRunner::dispatchCallback(const std::string& callbackId)
     }
     else if (callbackId == "start_button")
     {
-        mGameStartManager.save();
-        loadScene("/LOCATIONS/AVERY/ROOT/Avery_Full.json");
+        // The slot reads the notes from storage, so pending clue text goes
+        // first, once any earlier save has finished with storage;
+        // Game_State.json is snapshotted from memory. The rest of the save
+        // runs behind the first scene.
+        flushGameState();
+        mGameStartManager.beginSave(mGameState.toJson());
+        loadScene(k_AveryRootPath);
     }
 }
 
@@ -161,18 +196,19 @@ void GameRunner::syncControlsState()
     mBottomBar.setState(state);
 }
 
-void GameRunner::discoverSceneNote(const std::string& scenePath, const std::string& sceneJson)
+void GameRunner::discoverSceneNote(const std::string& scenePath)
 {
-    std::string clueText = mFileOperator.load(mActiveScene->getSecondaryPath());
-    if (!clueText.empty())
-        mFileOperator.appendToFile(mActiveScene->getNoteTarget(), clueText);
-
-    nlohmann::json j = nlohmann::json::parse(sceneJson, nullptr, false);
-    if (!j.is_discarded())
+    // Recorded in memory only; the journal record and clue text are written
+    // when the game state is next flushed. Scene files keep the flag they
+    // shipped with, so the active (possibly cached) scene is updated in
+    // place and loadScene() applies the same flag to every rebuild.
+    if (!mActiveScene->getSecondaryPath().empty())
     {
-        j["isDiscovered"] = true;
-        mFileOperator.writeToFile(scenePath, j.dump(2));
+        restoreLoadedNote(std::string(mActiveScene->getNoteTarget()));
+        mGameState.queueNoteAppend(std::string(mActiveScene->getNoteTarget()),
+                                   std::string(mActiveScene->getSecondaryPath()));
     }
+    mGameState.setDiscovered(scenePath);
     mActiveScene->setIsDiscovered(true);
 }
 
@@ -181,75 +217,368 @@ void GameRunner::loadScene(const std::string& path)
     mOverlayVisible  = false;
     mFileMenuVisible = false;
     mScrollOffset    = 0;
-    std::string json = mFileOperator.load(path);
 
-#ifdef ARDUINO
-    Serial.printf("[GR] loadScene: %s  json=%d bytes\n",
-        path.c_str(), (int)json.size());
-#endif
+    if (mPrefetcher)
+        mPrefetcher->drainInto(mSceneCache);
 
-    mActiveScene = mSceneFactory.build(json);
+    // Replacing the active scene first releases an arena-built one, so the
+    // arena can be rewound for the next build.
+    mActiveScene = mSceneCache.find(path);
+    if (mPrefetcher)
+    {
+        if (mActiveScene) mPrefetcher->noteLoaded(path);
+        else              mPrefetcher->noteBuilt(path);
+    }
 
+    if (!mActiveScene && mArenaScenes.count(path) && mSceneArena->reset())
+    {
+        mActiveScene = buildScene(path, mLoadBuffers, mSceneArena.get());
+    }
+    else if (!mActiveScene)
+    {
+        mActiveScene = buildScene(path, mLoadBuffers);
+        mSceneCache.insert(path, mActiveScene);
+        // Too large for the cache: later visits reuse the arena instead.
+        if (mSceneArena && !mSceneCache.contains(path))
+            mArenaScenes.insert(path);
+    }
+
+    // Remembered in the game state so a save slot resumes here; banners
+    // such as the start screen are not places to resume at.
     if (mCurrentMode == "locations")
+    {
         mLastLocationPath = path;
+        if (path.rfind(k_LocationsDir, 0) == 0)
+            mGameState.setCurrentLocation(path);
+    }
+
+    // Discoveries live in the game state, not in the scene files.
+    if (!mActiveScene->isDiscovered() && mGameState.isDiscovered(path))
+        mActiveScene->setIsDiscovered(true);
 
     if (!mActiveScene->isDiscovered() && !mActiveScene->getNoteTarget().empty())
-        discoverSceneNote(path, json);
+        discoverSceneNote(path);
 
+    schedulePrefetch();
+    pinNeighbourImages();
     syncControlsState();
 }
 
+std::shared_ptr<Scene> GameRunner::buildScene(const std::string& path, LoadBuffers& buffers,
+                                              SceneArena* arena)
+{
+    // Prefer the compiled record and read the JSON only when there is no
+    // usable one. A record that is present is trusted: the scene compiler
+    // regenerates records whenever scene data changes. Both are read into
+    // the caller's buffers, which keep their capacity across builds.
+    std::string& contents = buffers.contents;
+    SceneCompiler::recordPath(path, buffers.recordPath);
+    contents.clear();
+    if (!buffers.recordPath.empty())
+        mFileOperator.loadInto(buffers.recordPath, contents);
+    std::shared_ptr<Scene> scene;
+    if (!contents.empty())
+        scene = arena ? mSceneFactory.buildFromRecord(contents, *arena)
+                      : mSceneFactory.buildFromRecord(contents);
+    bool fromRecord = scene != nullptr;
+    if (!fromRecord)
+    {
+        mFileOperator.loadInto(path, contents);
+        scene = arena ? mSceneFactory.build(contents, *arena)
+                      : mSceneFactory.build(contents);
+    }
+
+#ifdef ARDUINO
+    Serial.printf("[GR] buildScene: %s  %s=%d bytes\n",
+        path.c_str(), fromRecord ? "record" : "json", (int)contents.size());
+#endif
+
+    return scene;
+}
+
+void GameRunner::enablePrefetch(int budgetPerScene, bool background)
+{
+    mPrefetcher.reset();
+    mPrefetchBudget = budgetPerScene;
+    if (budgetPerScene <= 0) return;
+
+    mPrefetcher = std::make_unique<ScenePrefetcher>(
+        [this](const std::string& path) -> std::shared_ptr<Scene>
+        {
+            LoadBuffers buffers; // the worker's own; mLoadBuffers belongs to loadScene
+            auto scene = buildScene(path, buffers);
+            // Unreadable targets build an empty scene; leave those to loadScene.
+            return scene->getSceneID().empty() ? nullptr : scene;
+        },
+        background);
+    schedulePrefetch();
+}
+
+ScenePrefetcher::Stats GameRunner::getPrefetchStats() const
+{
+    return mPrefetcher ? mPrefetcher->getStats() : ScenePrefetcher::Stats();
+}
+
+void GameRunner::enableSceneArena(size_t initialBytes)
+{
+    // The arena may hold the active scene, so an existing one is never replaced.
+    if (!mSceneArena)
+        mSceneArena = std::make_unique<SceneArena>(initialBytes);
+}
+
+SceneArena::Stats GameRunner::getSceneArenaStats() const
+{
+    return mSceneArena ? mSceneArena->getStats() : SceneArena::Stats();
+}
+
+void GameRunner::idle()
+{
+    if (mPrefetcher)
+    {
+        mPrefetcher->runIdleSlice();
+        mPrefetcher->drainInto(mSceneCache);
+
+        // Children that just reached the cache have images worth pinning.
+        size_t completed = mPrefetcher->getStats().completed;
+        if (completed != mPinnedPrefetches)
+        {
+            mPinnedPrefetches = completed;
+            pinNeighbourImages();
+        }
+    }
+
+    if (restoreNextLoadedNote())
+        return;
+
+    mGameStartManager.runIdleSlice();
+    int slot;
+    while (mGameStartManager.pollCompleted(slot))
+        if (mSaveListener) mSaveListener(slot);
+
+    // Storage belongs to the save until it commits; changes stay in memory.
+    if (mGameStartManager.isSaving())
+        return;
+
+    if (mGameState.isDirty() &&
+        GameState::Clock::now() - mGameState.dirtySince() >= k_GameStateFlushDelay)
+        flushGameState();
+    else if (mGameState.getJournalBytes() >= k_JournalCompactBytes)
+        mGameState.compact(mFileOperator);
+}
+
+void GameRunner::flushGameState()
+{
+    mGameStartManager.waitForSave();
+    while (restoreNextLoadedNote()) {}
+    mGameState.flush(mFileOperator);
+}
+
+const GameState& GameRunner::getGameState() const
+{
+    return mGameState;
+}
+
+void GameRunner::schedulePrefetch()
+{
+    if (!mPrefetcher || !mActiveScene) return;
+
+    size_t count = 0;
+    for (const auto& zone : mActiveScene->getZones())
+        assignAt(mPrefetchTargets, count, zone.getTarget());
+    mPrefetchTargets.resize(count);
+
+    mPrefetcher->schedule(mPrefetchTargets, mPrefetchBudget,
+                          [this](const std::string& path)
+                          { return mSceneCache.contains(path) || mArenaScenes.count(path) > 0; });
+}
+
+void GameRunner::pinNeighbourImages()
+{
+    if (!mActiveScene) return;
+
+    // Only cached scenes are consulted: pinning never costs a build. The
+    // set is gathered into scratch strings kept from earlier calls.
+    size_t count = 0;
+    auto addImage = [&](const std::shared_ptr<Scene>& scene)
+    {
+        if (!scene) return;
+        std::string_view image = scene->getPrimaryPath();
+        if (image.size() > 4 && image.substr(image.size() - 4) == ".png")
+            assignAt(mPinScratch, count, image);
+        // The lores image is what navigation shows first; it is small, so keep it too.
+        if (!scene->getLoresPath().empty())
+            assignAt(mPinScratch, count, scene->getLoresPath());
+    };
+    auto peek = [&](std::string_view path)
+    {
+        mPeekPath.assign(path);
+        return mSceneCache.peek(mPeekPath);
+    };
+    addImage(mActiveScene);
+    addImage(peek(mActiveScene->getParentPath()));
+    for (const auto& zone : mActiveScene->getZones())
+        addImage(peek(zone.getTarget()));
+
+    if (count == mPinnedImages.size()
+        && std::equal(mPinnedImages.begin(), mPinnedImages.end(), mPinScratch.begin()))
+        return;
+    mPinScratch.resize(count);
+    mPinScratch.swap(mPinnedImages);
+    mRenderer.pinImages(mPinnedImages);
+}
+
 void GameRunner::loadNote(const std::string& mdPath)
 {
     mOverlayVisible  = false;
     mFileMenuVisible = false;
     mScrollOffset    = 0;
-    mActiveScene     = std::make_unique<Scene>("NOTE", "", "", mdPath, "");
+
+    // The note is drawn straight from storage, so queued clue text must land first.
+    restoreLoadedNote(mdPath);
+    if (mGameState.getNotes().hasPendingAppends())
+        flushGameState();
+
+    mActiveScene = std::make_shared<Scene>("NOTE", "", "", mdPath, "");
+    mGameState.setCurrentNote(mdPath);
     syncControlsState();
 }
 
 void GameRunner::discoverNote(const std::string& notePath)
 {
-    std::string json = mFileOperator.load(notePath);
-    nlohmann::json j = nlohmann::json::parse(json, nullptr, false);
-    if (j.is_discarded()) return;
-    j["isDiscovered"] = true;
-    mFileOperator.writeToFile(notePath, j.dump(2));
+    // Written behind, like discoverSceneNote().
+    mGameState.setDiscovered(notePath);
 }
 
 void GameRunner::refreshNote(const std::string& clueArrayKey)
 {
-    std::string stateJson = mFileOperator.load("/GAME_STATE/Game_State.json");
-    nlohmann::json state = nlohmann::json::parse(stateJson, nullptr, false);
-    if (state.is_discarded()) return;
+    const GameState::NoteConfig* config = mGameState.getNoteConfig(clueArrayKey);
+    if (!config || config->notePath.empty()) return;
+    restoreLoadedNote(config->notePath);
+
+    // The builder writes this note's clue text itself; letting the flush
+    // append it too would read as an external edit and force a rewrite.
+    // Appends flushed outside a refresh still do, from memory.
+    mGameState.dropNoteAppends(config->notePath);
+    flushGameState();
+
+    static const GameState::DiscoveryGroup k_NoClues;
+    const GameState::DiscoveryGroup* clues = mGameState.getDiscoveryGroup(clueArrayKey);
+
+    auto builder = mNoteBuilders.find(clueArrayKey);
+    if (builder == mNoteBuilders.end())
+        builder = mNoteBuilders.emplace(clueArrayKey, NoteBuilder(config->notePath, config->basePath)).first;
+
+    builder->second.refresh(clues ? clues->ids : k_NoClues.ids, mGameState.getDiscovered(),
+                            [this](uint32_t clueID)
+                            {
+                                const std::string& path = clueSecondaryPath(clueID);
+                                return path.empty() ? std::string() : mFileOperator.load(path);
+                            },
+                            mFileOperator, mGameState.getNotes().getAppendCount(config->notePath));
+}
+
+const std::string& GameRunner::clueSecondaryPath(uint32_t clueID)
+{
+    auto it = mClueSecondaryPaths.find(clueID);
+    if (it != mClueSecondaryPaths.end()) return it->second;
 
-    auto& configs = state["note_configs"];
-    if (!configs.contains(clueArrayKey)) return;
+    std::string clueJson = mFileOperator.load(mGameState.getSceneIDs().path(clueID));
+    nlohmann::json clue  = nlohmann::json::parse(clueJson, nullptr, false);
+    std::string    path  = clue.is_object() ? clue.value("secondary_path", "") : "";
+    return mClueSecondaryPaths.emplace(clueID, std::move(path)).first->second;
+}
 
-    std::string notePath = configs[clueArrayKey].value("note_path", "");
-    std::string basePath = configs[clueArrayKey].value("base_path", "");
-    if (notePath.empty()) return;
+void GameRunner::setSaveDir(const std::string& dir)
+{
+    mGameStartManager.setSaveDir(dir);
+}
 
-    mFileOperator.writeToFile(notePath, mFileOperator.load(basePath));
+void GameRunner::setBackgroundSave(bool background)
+{
+    mGameStartManager.setBackground(background);
+}
 
-    auto& clues = state[clueArrayKey];
-    for (auto it = clues.begin(); it != clues.end(); ++it)
-    {
-        if (!it.value().get<bool>()) continue;
+void GameRunner::setSaveListener(std::function<void(int slot)> listener)
+{
+    mSaveListener = std::move(listener);
+}
 
-        std::string clueJson = mFileOperator.load(it.key());
-        nlohmann::json clue = nlohmann::json::parse(clueJson, nullptr, false);
-        if (clue.is_discarded()) continue;
+bool GameRunner::isSaving() const
+{
+    return mGameStartManager.isSaving();
+}
 
-        std::string secondaryPath = clue.value("secondary_path", "");
-        if (!secondaryPath.empty())
-            mFileOperator.appendToFile(notePath, mFileOperator.load(secondaryPath));
-    }
+bool GameRunner::restoreSlot(int slot)
+{
+    // Pending changes belong to the session being replaced.
+    if (!mGameStartManager.restore(slot)) return false;
+    mGameState.load(mFileOperator.load(GameState::k_Path));
+    mNoteBuilders.clear();
+    mSceneCache.clear(); // cached scenes carry the old session's discovery flags
+    if (mPrefetcher) mPrefetcher->invalidate();
+    return true;
 }
 
-void GameRunner::setSaveDir(const std::string& dir)
+bool GameRunner::loadSlot(int slot)
 {
-    mGameStartManager.setSaveDir(dir);
+    std::string state;
+    if (!mGameStartManager.load(slot, state)) return false;
+
+    // Storage keeps the replaced session until the next flush rewrites it.
+    if (!mGameState.adopt(state)) return false;
+    mNoteBuilders.clear();
+    mSceneCache.clear();
+    if (mPrefetcher) mPrefetcher->invalidate();
+    mActiveScene.reset();
+
+    // The slot's mode, location and note say where its session left off.
+    const Notes& notes = mGameState.getNotes();
+    mCurrentMode       = mGameState.getCurrentMode() == "notes" ? "notes" : "locations";
+    mNoteIndex         = 0;
+    for (size_t i = 0; i < notes.size(); ++i)
+        if (notes[i] == mGameState.getCurrentNote()) mNoteIndex = (int)i;
+    mLastLocationPath  = mGameState.getCurrentLocation();
+    mResumeScenePath   = mLastLocationPath.empty() ? k_AveryRootPath : mLastLocationPath;
+    return true;
+}
+
+void GameRunner::resumeScene()
+{
+    std::string path = std::move(mResumeScenePath);
+    mResumeScenePath.clear();
+    const Notes& notes = mGameState.getNotes();
+    if (mCurrentMode == "notes" && !notes.empty())
+        loadNote(notes[mNoteIndex]);
+    else
+        loadScene(path);
+}
+
+void GameRunner::restoreLoadedNote(const std::string& notePath)
+{
+    std::string text;
+    if (notePath.rfind(k_NotesStateDir, 0) == 0
+        && mGameStartManager.takeLoadedNote(notePath.substr(k_NotesStateDir.size()), text))
+        mFileOperator.writeToFile(notePath, text);
+}
+
+bool GameRunner::restoreNextLoadedNote()
+{
+    std::vector<std::string> pending = mGameStartManager.getLoadedNotes();
+    if (pending.empty()) return false;
+    restoreLoadedNote(k_NotesStateDir + pending.front());
+    return true;
+}
+
+void GameRunner::setSceneCacheBudget(size_t budgetBytes)
+{
+    mSceneCache.setBudget(budgetBytes);
+    mArenaScenes.clear(); // what the cache declines has changed
+    if (mPrefetcher) mPrefetcher->forgetDeclined();
+}
+
+SceneCache::Stats GameRunner::getSceneCacheStats() const
+{
+    return mSceneCache.getStats();
 }
 
 void GameRunner::scroll(int delta)
@@ -269,7 +598,8 @@ std::string GameRunner::getCurrentLocationID() const
 
 std::string GameRunner::getCurrentNoteID() const
 {
-    return mNoteIndex < (int)mNoteList.size() ? mNoteList[mNoteIndex] : "";
+    // The note last opened, which a save slot resumes at.
+    return mGameState.getCurrentNote();
 }
 
 bool GameRunner::isFileMenuVisible() const
@@ -3,12 +3,20 @@
  */
 
 #pragma once
-#include <string>
+#include <functional>
+#include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include "../SCENE/SceneFactory.h"
+#include "../SCENE_CACHE/SceneCache.h"
+#include "../SCENE_CACHE/ScenePrefetcher.h"
 #include "../SCENE_VIEW/SceneView.h"
 #include "../BAR/ControlBarSection.h"
+#include "../GAME_STATE/GameState.h"
+#include "../NOTES/NoteBuilder.h"
 #include "GameStartManager.h"
 
 class FileOperator;
@@ -20,6 +28,29 @@ class Scene;
  * to load scene JSON from storage and a SceneFactory to build the Scene.
  * Delegates scene rendering to SceneView and controls rendering to ControlsView,
  * both of which use an injected GraphicsRenderer.
+ *
+ * Built scenes are kept in an LRU SceneCache so revisiting a scene skips the
+ * load and parse. The default byte budget is small on ESP32 and large on
+ * desktop; see setSceneCacheBudget(). With prefetch enabled, the active
+ * scene's zone targets are built ahead of time into the same cache.
+ *
+ * With the scene arena enabled, scenes the cache declines (larger than its
+ * whole budget) are built into one reusable SceneArena that is rewound on
+ * the next load, so revisiting them stops allocating scene memory once the
+ * arena has grown to fit the largest. A scene's first visit builds it on the
+ * heap to learn whether the cache takes it; the arena holds one scene at a
+ * time, so arena scenes are never cached. Scene files are read into buffers
+ * GameRunner keeps, so a warm arena revisit makes no heap calls of its own;
+ * what the platform's file API allocates to open and read a file is outside
+ * its reach, as are the prefetch jobs scheduled when prefetch is enabled.
+ *
+ * Game_State.json is loaded once into a GameState, with the discovery
+ * journal replayed on top. Discoveries and note appends change that model
+ * and are written behind: idle() flushes them in one batch once the oldest
+ * change is a couple of seconds old, so a tap that discovers something never
+ * waits on storage and a discovery costs a few journal bytes. idle() also
+ * compacts the journal into Game_State.json once it grows past a kilobyte.
+ * A save takes Game_State.json from this model, so it need not compact first.
  */
 class GameRunner
 {
@@ -30,6 +61,7 @@ public:
                std::string       locationID = "",
                std::string       saveDir    = "",
                bool              useHires   = false);
+    ~GameRunner();
 
     /**
      * Render the active scene and controls via their respective views.
@@ -44,13 +76,82 @@ public:
 
     /**
      * Load a scene from the given data-root-relative JSON path, build it via
-     * SceneFactory, and take ownership as the new active scene.
+     * SceneFactory, and take ownership as the new active scene. A compiled
+     * record next to the JSON (see SceneCompiler) is used when present; the
+     * JSON is read only without a usable record.
      */
     void loadScene(const std::string& path);
 
     void setSaveDir(const std::string& dir);
+
+    /**
+     * Saving from the start screen runs behind the first scene: on a worker
+     * thread when background (the default where threads exist), otherwise a
+     * step per idle() call. The listener is called from idle() with the slot
+     * written (-1 if the save failed) once the save has committed. Game-state
+     * writes wait in memory while a save is in flight.
+     */
+    void setBackgroundSave(bool background);
+    void setSaveListener(std::function<void(int slot)> listener);
+    bool isSaving() const;
+
+    /**
+     * Replace GAME_STATE with a save slot (see GameStartManager::restore) and
+     * reload the game state from it, dropping changes not yet flushed.
+     * Returns false, changing nothing, if the slot cannot be read.
+     */
+    bool restoreSlot(int slot);
+
+    /**
+     * Resume from a save slot (see GameStartManager::load): its discoveries
+     * apply at once, its mode is restored, the note it last showed (in notes
+     * mode) or the scene at its last location (or Avery's root) is loaded by
+     * the next draw() or registerHit(), and each note is written
+     * back to GAME_STATE when first opened, refreshed or appended to, or a
+     * note per idle() call. Changes not yet flushed are dropped. Returns
+     * false, changing nothing, if the slot cannot be read.
+     */
+    bool loadSlot(int slot);
     void scroll(int delta);
 
+    /**
+     * Override the scene cache byte budget. Pass 0 to disable caching.
+     */
+    void              setSceneCacheBudget(size_t budgetBytes);
+    SceneCache::Stats getSceneCacheStats() const;
+
+    /**
+     * Prefetch up to budgetPerScene zone targets of each loaded scene into the
+     * scene cache. background = true builds them on a worker thread (desktop;
+     * the FileOperator must then tolerate concurrent loads); otherwise, or on
+     * single-threaded builds, idle() builds one per call. Pass 0 to disable.
+     */
+    void                   enablePrefetch(int budgetPerScene, bool background);
+    ScenePrefetcher::Stats getPrefetchStats() const;
+
+    /**
+     * Build scenes the cache declines into a SceneArena that starts with
+     * initialBytes reserved; it grows to fit the largest scene seen. Has no
+     * effect if the arena is already enabled.
+     */
+    void              enableSceneArena(size_t initialBytes);
+    SceneArena::Stats getSceneArenaStats() const;
+
+    /**
+     * Call from the platform main loop when there is no input to handle.
+     * Runs pending prefetch work and hands finished scenes to the cache,
+     * then writes or compacts the game state when it is due.
+     */
+    void idle();
+
+    /**
+     * Write pending game-state changes now instead of waiting for idle(),
+     * finishing any save in flight first. Call before power-off; also done
+     * on save and on destruction.
+     */
+    void             flushGameState();
+    const GameState& getGameState() const;
+
     std::string getCurrentMode()       const;
     std::string getCurrentLocationID() const;
     std::string getCurrentNoteID()     const;
@@ -64,7 +165,12 @@ private:
     ControlBarSection      mBottomBar;
     SceneFactory           mSceneFactory;
     GameStartManager       mGameStartManager;
-    std::unique_ptr<Scene> mActiveScene;
+    std::function<void(int)> mSaveListener;
+    GameState              mGameState;
+    SceneCache             mSceneCache;
+    std::unique_ptr<SceneArena> mSceneArena;     // declared before mActiveScene, which may live in it
+    std::unordered_set<std::string> mArenaScenes; // paths the cache declined, built in the arena
+    std::shared_ptr<Scene> mActiveScene;
     std::unique_ptr<Scene> mFileMenuScene;
     bool                   mOverlayVisible      = false;
     bool                   mFileMenuVisible     = false;
@@ -74,13 +180,45 @@ private:
     std::string              mCurrentMode;
     std::string              mCurrentLocationID;
     std::string              mLastLocationPath;
-    std::vector<std::string> mNoteList;
+    std::string              mResumeScenePath; // built on first use after loadSlot()
     int                      mNoteIndex = 0;
 
+    std::map<std::string, NoteBuilder>        mNoteBuilders;        // by note_configs key
+    std::unordered_map<uint32_t, std::string> mClueSecondaryPaths;  // by scene ID, parsed once
+
+    std::vector<std::string> mPinnedImages;         // last set passed to GraphicsRenderer::pinImages
+    size_t                   mPinnedPrefetches = 0; // prefetches completed when it was chosen
+    std::vector<std::string> mPinScratch;           // the next set, gathered in reused strings
+    std::string              mPeekPath;             // cache key scratch for pinNeighbourImages
+    std::vector<std::string> mPrefetchTargets;      // schedulePrefetch scratch
+
+    // Storage a scene build reads into; kept so its capacity is reused.
+    struct LoadBuffers
+    {
+        std::string recordPath;
+        std::string contents;
+    };
+    LoadBuffers mLoadBuffers; // loadScene's; prefetch builds bring their own
+
+    // Declared last so the worker stops before anything its loader uses.
+    int                              mPrefetchBudget = 0;
+    std::unique_ptr<ScenePrefetcher> mPrefetcher;
+
+    // arena == nullptr builds on the heap.
+    std::shared_ptr<Scene> buildScene(const std::string& path, LoadBuffers& buffers,
+                                      SceneArena* arena = nullptr);
+    void                   schedulePrefetch();
+    void                   pinNeighbourImages();
+
+    void resumeScene();
+    void restoreLoadedNote(const std::string& notePath);
+    bool restoreNextLoadedNote();
+
     void loadNote(const std::string& mdPath);
     void discoverNote(const std::string& notePath);
-    void discoverSceneNote(const std::string& scenePath, const std::string& sceneJson);
+    void discoverSceneNote(const std::string& scenePath);
     void refreshNote(const std::string& clueArrayKey);
+    const std::string& clueSecondaryPath(uint32_t clueID);
     void dispatchCallback(const std::string& callbackId);
     void syncControlsState();
 };
@@ -1,5 +1,48 @@
 #include "GameStartManager.h"
 #include "../FILE_OPERATOR/FileOperator.h"
+#include "../GAME_STATE/GameState.h"
+#include "../GAME_STATE/GameStateComparison.h"
+#include "../GAME_STATE/SlotContainer.h"
+#include "../UTIL/Fnv1a.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+const char* const GameStartManager::k_IndexFiles[2] = { "KSC_Slots_A.json", "KSC_Slots_B.json" };
+const char* const GameStartManager::k_DeltaFile = "Delta.json";
+const char* const GameStartManager::k_NoteManifest = "Notes.json";
+const char* const GameStartManager::k_NoteStoreDir = "NOTE_STORE";
+
+static const std::string k_SlotStatePath  = "/GAME_STATE/Game_State.json";
+static const std::string k_SlotNotesDir   = "/GAME_STATE/NOTES_STATE";
+static const std::string k_SlotStateEntry = "Game_State.json";
+static const std::string k_SlotNotePrefix = "NOTES_STATE/";
+
+// NOTE_STORE file name for a note's text: its hash and length.
+static std::string noteBlobName(uint32_t hash, size_t length)
+{
+    static const char k_Hex[] = "0123456789abcdef";
+    std::string name(8, '0');
+    for (int i = 7; i >= 0; --i, hash >>= 4)
+        name[i] = k_Hex[hash & 0xF];
+    return name + "_" + std::to_string(length) + ".md";
+}
+
+// Applies the Game_State part of a delta to its base document.
+static json applyStateDelta(json state, const json& delta)
+{
+    if (delta.contains("state"))
+        return json::parse(delta["state"].get<std::string>(), nullptr, false);
+
+    const json scalars     = delta.value("scalars", json::object());
+    const json discoveries = delta.value("discoveries", json::object());
+    for (const auto& [field, value] : scalars.items())
+        state[field] = value;
+    for (const auto& [mapKey, changes] : discoveries.items())
+        for (const auto& [path, value] : changes.items())
+            state[mapKey][path] = value;
+    return state;
+}
 
 GameStartManager::GameStartManager(FileOperator& fileOperator, std::string saveDir)
 : mFileOperator(fileOperator)
@@ -7,9 +50,19 @@ GameStartManager::GameStartManager(FileOperator& fileOperator, std::string saveD
 {
 }
 
+GameStartManager::~GameStartManager()
+{
+    waitForSave();
+    collectSave();
+}
+
 void GameStartManager::setSaveDir(const std::string& dir)
 {
-    mSaveDir = dir;
+    waitForSave();
+    mSaveDir  = dir;
+    mBaseSlot = -1;
+    mBaseState.clear();
+    mLoadedNotes.clear();
 }
 
 std::string GameStartManager::getSaveDir() const
@@ -17,6 +70,16 @@ std::string GameStartManager::getSaveDir() const
     return mSaveDir;
 }
 
+std::string GameStartManager::slotPath(int slot) const
+{
+    return mSaveDir + "/KSC_SLOT_" + std::to_string(slot) + ".ksc";
+}
+
+std::string GameStartManager::blobPath(const std::string& blob) const
+{
+    return mSaveDir + "/" + k_NoteStoreDir + "/" + blob;
+}
+
 int GameStartManager::findNextSlotIndex()
 {
     int highest = -1;
@@ -35,25 +98,456 @@ int GameStartManager::findNextSlotIndex()
     return highest + 1;
 }
 
-void GameStartManager::save()
+bool GameStartManager::loadIndex(Index& index)
 {
-    if (mSaveDir.empty()) return;
+    // The newer of the two copies that parse; a torn one never does.
+    bool found = false;
+    for (const char* file : k_IndexFiles)
+    {
+        json j = json::parse(mFileOperator.load(mSaveDir + "/" + file), nullptr, false);
+        if (!j.is_object() || !j.contains("next_slot") || !j["next_slot"].is_number_integer()
+            || !j.contains("sequence") || !j["sequence"].is_number_unsigned())
+            continue;
 
-    int         slot    = findNextSlotIndex();
-    std::string slotDir = mSaveDir + "/KSC_SLOT_" + std::to_string(slot);
+        uint32_t sequence = j["sequence"].get<uint32_t>();
+        if (found && sequence <= index.sequence) continue;
 
-    // Copy Game_State.json.
-    mFileOperator.writeToFile(slotDir + "/Game_State.json",
-                              mFileOperator.load("/GAME_STATE/Game_State.json"));
+        found          = true;
+        index.sequence = sequence;
+        index.nextSlot = j["next_slot"].get<int>();
+        index.baseSlot = j.value("base_slot", -1);
+        index.baseNotes.clear();
+        const json baseNotes = j.value("base_notes", json::object());
+        for (const auto& [path, stamp] : baseNotes.items())
+            index.baseNotes[path] = { stamp.value("length", size_t(0)), stamp.value("hash", 0u) };
+    }
+    return found;
+}
+
+void GameStartManager::writeIndex(const Index& index)
+{
+    json notes = json::object();
+    for (const auto& [path, stamp] : index.baseNotes)
+        notes[path] = { { "length", stamp.length }, { "hash", stamp.hash } };
+
+    json j = { { "sequence", index.sequence }, { "next_slot", index.nextSlot },
+               { "base_slot", index.baseSlot }, { "base_notes", notes } };
+    mFileOperator.writeToFile(mSaveDir + "/" + k_IndexFiles[index.sequence % 2], j.dump(2));
+}
 
-    // Always copy NOTES_STATE: one subdirectory per note (e.g. AVERY, LIBRARY).
-    for (const std::string& noteDir : mFileOperator.listDirectory("/GAME_STATE/NOTES_STATE"))
+void GameStartManager::setBackground(bool background)
+{
+    waitForSave();
+    mBackground = background && KSC_HAS_THREADS;
+}
+
+bool GameStartManager::beginSave(std::string gameState)
+{
+    if (mSaveDir.empty()) return false;
+
+    waitForSave();
+    collectSave();
+
+    mJob            = std::make_unique<SaveJob>();
+    mJob->gameState = std::move(gameState);
+    mJobDone        = false;
+
+#if KSC_HAS_THREADS
+    if (mBackground)
     {
-        const std::string noteBase = "/GAME_STATE/NOTES_STATE/" + noteDir;
-        for (const std::string& file : mFileOperator.listDirectory(noteBase))
+        mWorker = std::thread([this]
+        {
+            while (!stepSave(*mJob)) {}
+            mJobDone = true;
+        });
+    }
+#endif
+    return true;
+}
+
+bool GameStartManager::isSaving() const
+{
+    return mJob && !mJobDone;
+}
+
+bool GameStartManager::runIdleSlice()
+{
+    if (mBackground || !isSaving()) return false;
+    if (stepSave(*mJob)) mJobDone = true;
+    return true;
+}
+
+void GameStartManager::waitForSave()
+{
+#if KSC_HAS_THREADS
+    if (mWorker.joinable())
+    {
+        mWorker.join();
+        return;
+    }
+#endif
+    while (runIdleSlice()) {}
+}
+
+void GameStartManager::collectSave()
+{
+    if (!mJob || !mJobDone) return;
+#if KSC_HAS_THREADS
+    if (mWorker.joinable()) mWorker.join();
+#endif
+    mCompleted.push_back(mJob->step == SaveJob::Step::Done ? mJob->slot : -1);
+    mJob.reset();
+}
+
+bool GameStartManager::pollCompleted(int& slot)
+{
+    collectSave();
+    if (mCompleted.empty()) return false;
+    slot = mCompleted.front();
+    mCompleted.pop_front();
+    return true;
+}
+
+int GameStartManager::save()
+{
+    if (!beginSave(mFileOperator.load(k_SlotStatePath))) return -1;
+    waitForSave();
+    collectSave();
+    int slot = mCompleted.back();
+    mCompleted.pop_back();
+    return slot;
+}
+
+bool GameStartManager::stepSave(SaveJob& job)
+{
+    switch (job.step)
+    {
+        case SaveJob::Step::Prepare:
+        {
+            if (job.gameState.empty()) return true; // nothing to save: fails
+
+            job.indexed = loadIndex(job.index);
+            if (!job.indexed)
+                job.index.nextSlot = findNextSlotIndex();
+            job.slot = job.index.nextSlot;
+
+            // One subdirectory per note (e.g. AVERY, LIBRARY).
+            for (const std::string& noteDir : mFileOperator.listDirectory(k_SlotNotesDir))
+                for (const std::string& file : mFileOperator.listDirectory(k_SlotNotesDir + "/" + noteDir))
+                    job.notePaths.push_back(noteDir + "/" + file);
+            job.step = SaveJob::Step::ReadNotes;
+            return false;
+        }
+
+        case SaveJob::Step::ReadNotes:
+            if (job.nextNote < job.notePaths.size())
+            {
+                const std::string& path = job.notePaths[job.nextNote++];
+                job.notes[path] = mFileOperator.load(k_SlotNotesDir + "/" + path);
+                return false;
+            }
+            job.step = SaveJob::Step::PackSlot;
+            return false;
+
+        case SaveJob::Step::PackSlot:
+            if (job.indexed && job.index.baseSlot >= 0)
+                job.slotBytes = packDelta(job.gameState, job.notes, job.index);
+            if (job.slotBytes.empty())
+                job.slotBytes = packBase(job.slot, job.gameState, job.notes, job.index, job.newBlobs);
+            job.step = SaveJob::Step::WriteNotes;
+            return false;
+
+        case SaveJob::Step::WriteNotes:
+            // Blobs before the slot that names them.
+            if (job.nextBlob < job.newBlobs.size())
+            {
+                const auto& [blob, path] = job.newBlobs[job.nextBlob++];
+                mFileOperator.writeToFile(blobPath(blob), job.notes[path]);
+                return false;
+            }
+            job.step = SaveJob::Step::WriteSlot;
+            return false;
+
+        case SaveJob::Step::WriteSlot:
+            mFileOperator.writeToFile(slotPath(job.slot), job.slotBytes);
+            job.step = SaveJob::Step::Commit;
+            return false;
+
+        case SaveJob::Step::Commit:
+            // The slot is complete before the index points past it.
+            job.index.sequence++;
+            job.index.nextSlot = job.slot + 1;
+            writeIndex(job.index);
+            job.step = SaveJob::Step::Done;
+            return true;
+
+        case SaveJob::Step::Done:
+            return true;
+    }
+    return true;
+}
+
+std::string GameStartManager::packBase(int slot, const std::string& gameState,
+                                       const std::map<std::string, std::string>& notes, Index& index,
+                                       std::vector<std::pair<std::string, std::string>>& newBlobs)
+{
+    std::map<std::string, std::string> entries = { { k_SlotStateEntry, gameState } };
+    json manifest = json::object();
+
+    std::map<std::string, NoteStamp> stamps;
+    for (const auto& [path, text] : notes)
+    {
+        NoteStamp   stamp = { text.size(), fnv1a32(text.data(), text.size()) };
+        std::string blob  = noteBlobName(stamp.hash, stamp.length);
+        stamps[path]      = stamp;
+
+        // Bases are rare (see k_RebaseBytes), so the store is simply asked
+        // whether an earlier save wrote the blob. A different text under the
+        // same name (a hash collision) is kept in the slot instead.
+        bool stored = false;
+        for (const auto& [pending, pendingPath] : newBlobs)
+            stored = stored || pending == blob;
+        if (!stored)
+        {
+            std::string existing = mFileOperator.load(blobPath(blob));
+            if (existing.empty())
+                newBlobs.emplace_back(blob, path);
+            else if (existing != text)
+                blob.clear();
+        }
+
+        if (blob.empty()) entries[k_SlotNotePrefix + path] = text;
+        else              manifest[path]                   = blob;
+    }
+    entries[k_NoteManifest] = manifest.dump();
+
+    index.baseSlot  = slot;
+    index.baseNotes = std::move(stamps);
+    mBaseSlot       = slot;
+    mBaseState      = gameState;
+    return SlotContainer::pack(entries);
+}
+
+const std::string& GameStartManager::baseState(int baseSlot)
+{
+    // Read once per base, so later saves do not read the base notes back.
+    if (mBaseSlot != baseSlot)
+    {
+        SlotContainer base;
+        mBaseSlot  = baseSlot;
+        mBaseState = base.open(mFileOperator.load(slotPath(baseSlot))) && !base.contains(k_DeltaFile)
+                   ? std::string(base.get(k_SlotStateEntry))
+                   : std::string();
+    }
+    return mBaseState;
+}
+
+std::string GameStartManager::packDelta(const std::string& gameState,
+                                        const std::map<std::string, std::string>& notes, const Index& index)
+{
+    const std::string& base = baseState(index.baseSlot);
+    if (base.empty()) return "";
+
+    json delta = { { "base_slot", index.baseSlot } };
+
+    // Game_State.json: the comparison diff, unless it misses something (keys
+    // the diff does not cover), in which case the document is stored whole.
+    if (base != gameState)
+    {
+        GameStateComparison::Diff diff = GameStateComparison(base, gameState).getDiff();
+        json scalars     = json::object();
+        json discoveries = json::object();
+        for (const auto& change : diff.scalars)
+            scalars[change.field] = change.after;
+        for (const auto& change : diff.discoveries)
+            discoveries[change.mapKey][change.path] = change.after;
+
+        json stateDelta = { { "scalars", scalars }, { "discoveries", discoveries } };
+        json current    = json::parse(gameState, nullptr, false);
+        if (applyStateDelta(json::parse(base, nullptr, false), stateDelta) == current)
         {
-            std::string content = mFileOperator.load(noteBase + "/" + file);
-            mFileOperator.writeToFile(slotDir + "/NOTES_STATE/" + noteDir + "/" + file, content);
+            if (!scalars.empty())     delta["scalars"]     = scalars;
+            if (!discoveries.empty()) delta["discoveries"] = discoveries;
         }
+        else
+        {
+            delta["state"] = gameState;
+        }
+    }
+
+    // Notes only grow during play, so most need just the text past the base.
+    // The text goes in its own entry; Delta.json says how to apply it.
+    std::map<std::string, std::string> entries;
+    json changedNotes = json::object();
+    for (const auto& [path, text] : notes)
+    {
+        auto stamp = index.baseNotes.find(path);
+        if (stamp != index.baseNotes.end() && text.size() >= stamp->second.length
+            && fnv1a32(text.data(), stamp->second.length) == stamp->second.hash)
+        {
+            if (text.size() == stamp->second.length) continue;
+            changedNotes[path]                 = "append";
+            entries[k_SlotNotePrefix + path] = text.substr(stamp->second.length);
+        }
+        else
+        {
+            changedNotes[path]                 = "text";
+            entries[k_SlotNotePrefix + path] = text;
+        }
+    }
+    if (!changedNotes.empty()) delta["notes"] = changedNotes;
+
+    json removedNotes = json::array();
+    for (const auto& [path, stamp] : index.baseNotes)
+        if (notes.find(path) == notes.end())
+            removedNotes.push_back(path);
+    if (!removedNotes.empty()) delta["removed_notes"] = removedNotes;
+
+    entries[k_DeltaFile] = delta.dump();
+    std::string bytes = SlotContainer::pack(entries);
+    return bytes.size() > k_RebaseBytes ? "" : bytes;
+}
+
+bool GameStartManager::readSlot(int slot, SlotContents& out)
+{
+    waitForSave();
+    OpenedSlot opened;
+    if (!openSlot(slot, opened, true)) return false;
+
+    out.gameState = std::move(opened.gameState);
+    out.notes.clear();
+    for (const auto& [path, source] : opened.notes)
+        out.notes[path] = readNote(source);
+    return true;
+}
+
+bool GameStartManager::load(int slot, std::string& gameState)
+{
+    waitForSave();
+    OpenedSlot opened;
+    if (!openSlot(slot, opened, true)) return false;
+    // A slot whose state does not parse cannot be resumed from.
+    if (!json::parse(opened.gameState, nullptr, false).is_object()) return false;
+
+    gameState    = std::move(opened.gameState);
+    mLoadedNotes = std::move(opened.notes);
+    return true;
+}
+
+std::vector<std::string> GameStartManager::getLoadedNotes() const
+{
+    std::vector<std::string> paths;
+    for (const auto& [path, source] : mLoadedNotes)
+        paths.push_back(path);
+    return paths;
+}
+
+bool GameStartManager::takeLoadedNote(const std::string& path, std::string& text)
+{
+    auto it = mLoadedNotes.find(path);
+    if (it == mLoadedNotes.end()) return false;
+    text = readNote(it->second);
+    mLoadedNotes.erase(it);
+    return true;
+}
+
+std::string GameStartManager::readNote(const NoteSource& source)
+{
+    return (source.blob.empty() ? source.text : mFileOperator.load(blobPath(source.blob))) + source.append;
+}
+
+bool GameStartManager::openSlot(int slot, OpenedSlot& out, bool allowDelta)
+{
+    if (mSaveDir.empty() || slot < 0) return false;
+
+    SlotContainer container;
+    if (!container.open(mFileOperator.load(slotPath(slot))))
+        return openSlotDirectory(slot, out);
+
+    bool isDelta = container.contains(k_DeltaFile);
+    if (isDelta && !allowDelta) return false;
+    if (!isDelta)
+    {
+        out.gameState = std::string(container.get(k_SlotStateEntry));
+        out.notes.clear();
+        const json manifest = json::parse(container.get(k_NoteManifest), nullptr, false);
+        if (manifest.is_object())
+            for (const auto& [path, blob] : manifest.items())
+                if (blob.is_string()) out.notes[path].blob = blob.get<std::string>();
+        for (const std::string& name : container.names())
+            if (name.rfind(k_SlotNotePrefix, 0) == 0)
+                out.notes[name.substr(k_SlotNotePrefix.size())] = { "", std::string(container.get(name)), "" };
+        return !out.gameState.empty();
     }
+
+    json delta = json::parse(container.get(k_DeltaFile), nullptr, false);
+    if (!delta.is_object()) return false;
+
+    // A delta always refers to a base, never to another delta.
+    if (!openSlot(delta.value("base_slot", -1), out, false)) return false;
+
+    if (delta.contains("state") || delta.contains("scalars") || delta.contains("discoveries"))
+    {
+        json state = applyStateDelta(json::parse(out.gameState, nullptr, false), delta);
+        if (state.is_discarded()) return false;
+        out.gameState = state.dump(2);
+    }
+
+    const json notes   = delta.value("notes", json::object());
+    const json removed = delta.value("removed_notes", json::array());
+    for (const auto& [path, how] : notes.items())
+    {
+        std::string_view text = container.get(k_SlotNotePrefix + path);
+        if (how == "text") out.notes[path]         = { "", std::string(text), "" };
+        else               out.notes[path].append += text;
+    }
+    for (const auto& path : removed)
+        out.notes.erase(path.get<std::string>());
+    return true;
+}
+
+bool GameStartManager::openSlotDirectory(int slot, OpenedSlot& out)
+{
+    // Slots saved before the packed container: a full copy of GAME_STATE.
+    const std::string dir = mSaveDir + "/KSC_SLOT_" + std::to_string(slot);
+    out.gameState = mFileOperator.load(dir + "/Game_State.json");
+    if (out.gameState.empty()) return false;
+
+    out.notes.clear();
+    for (const std::string& noteDir : mFileOperator.listDirectory(dir + "/NOTES_STATE"))
+    {
+        const std::string noteBase = dir + "/NOTES_STATE/" + noteDir;
+        for (const std::string& file : mFileOperator.listDirectory(noteBase))
+            out.notes[noteDir + "/" + file].text = mFileOperator.load(noteBase + "/" + file);
+    }
+    return true;
+}
+
+std::string GameStartManager::exportSlot(int slot)
+{
+    waitForSave();
+    SlotContents contents;
+    if (!readSlot(slot, contents)) return "";
+
+    std::map<std::string, std::string> entries = { { k_SlotStateEntry, std::move(contents.gameState) } };
+    for (auto& [path, text] : contents.notes)
+        entries[k_SlotNotePrefix + path] = std::move(text);
+    return SlotContainer::pack(entries);
+}
+
+bool GameStartManager::restore(int slot)
+{
+    waitForSave();
+    SlotContents contents;
+    if (!readSlot(slot, contents)) return false;
+
+    // Notes the slot does not have are left alone; GameState only lists its own.
+    // The journal belongs to the replaced session, so it goes before the state:
+    // losing power in between must not replay it over the slot.
+    mLoadedNotes.clear();
+    mFileOperator.writeToFile(GameState::k_JournalPath, "");
+    mFileOperator.writeToFile(k_SlotStatePath, contents.gameState);
+    for (const auto& [path, text] : contents.notes)
+        mFileOperator.writeToFile(k_SlotNotesDir + "/" + path, text);
+    return true;
 }
@@ -3,15 +3,62 @@
  */
 
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
+#include "../UTIL/KSC_Threads.h"
 
 class FileOperator;
 
 /**
  * Handles save-slot creation when the player chooses to save from the start screen.
- * Copies the entire GAME_STATE directory into SAVE_DIR/KSC_SLOT_N/, where N is the
- * next available slot index (determined by scanning SAVE_DIR for existing KSC_SLOT_*
- * subdirectories).
+ * Each save writes one SlotContainer file, SAVE_DIR/KSC_SLOT_N.ksc, where N
+ * comes from the slot index, and then commits it through the index.
+ *
+ * Slots are either a base or a delta:
+ *  - A base holds Game_State.json and Notes.json, naming the blob in
+ *    SAVE_DIR/NOTE_STORE that holds each NOTES_STATE/<dir>/<file>. Blobs are
+ *    named by the length and hash of their text and written once, before the
+ *    slot, so a base save writes one file per note the store does not have
+ *    yet plus the slot, and bases share every note that has not changed
+ *    between them.
+ *  - A delta is self-contained: Delta.json, recording what changed since the
+ *    current base (the GameStateComparison::Diff of Game_State.json and how
+ *    each note changed), plus a NOTES_STATE entry per changed note with only
+ *    the text appended since the base, or the whole note if it was
+ *    rewritten. It is the only file a delta save writes besides the index,
+ *    and its cost follows the progress made since the base, not the size of
+ *    the notes.
+ * Once a delta would exceed k_RebaseBytes the save is written as a new base.
+ *
+ * The index records the next slot number, the current base and the length
+ * and hash of each base note, so a save neither scans SAVE_DIR nor reads the
+ * base notes back. Without a readable index the next slot is found by
+ * scanning SAVE_DIR and the save is written as a base.
+ *
+ * Saving is asynchronous. beginSave() takes the Game_State.json text as a
+ * snapshot and returns; the notes are read and the slot written later, by a
+ * worker thread in background mode (desktop builds) or one step per
+ * runIdleSlice() call otherwise (ESP32). Each finished save is reported once
+ * by pollCompleted(). Until then the caller must not write GAME_STATE.
+ *
+ * A save commits by writing the index after the slot. The index alternates
+ * between two copies (KSC_Slots_A.json, KSC_Slots_B.json) with a sequence
+ * number, so power lost mid-commit leaves the previous copy intact: the save
+ * is simply not committed and its slot number is reused by the next save.
+ * Slot directories left by earlier versions (KSC_SLOT_N/ holding a full copy
+ * of GAME_STATE) and bases holding their notes inline still read back.
+ *
+ * load() opens a slot for resuming: the slot (and, for a delta, its base) is
+ * read and Game_State.json comes back at once. Each note is only read when
+ * takeLoadedNote() asks for it: from the delta if it holds the whole note,
+ * otherwise from the base's NOTE_STORE blob (or inline entry), with any
+ * delta append added. Resuming therefore reads the slot files up front and
+ * one blob per note actually restored.
  *
  * Constructed with a FileOperator reference and the platform-specific save directory
  * path. When saveDir is empty, save() is a no-op.
@@ -19,7 +66,24 @@ class FileOperator;
 class GameStartManager
 {
 public:
+    static const char* const k_IndexFiles[2]; // "KSC_Slots_A.json", "KSC_Slots_B.json"
+    static const char* const k_DeltaFile;     // "Delta.json", the entry marking a delta slot
+    static const char* const k_NoteManifest;  // "Notes.json", a base's note -> blob map
+    static const char* const k_NoteStoreDir;  // "NOTE_STORE", under SAVE_DIR
+    static constexpr size_t  k_RebaseBytes = 8 * 1024;
+
+    /** A slot as it was saved, with any delta already applied to its base. */
+    struct SlotContents
+    {
+        std::string                        gameState; // Game_State.json text
+        std::map<std::string, std::string> notes;     // "AVERY/Avery_Note.md" -> text
+    };
+
     GameStartManager(FileOperator& fileOperator, std::string saveDir);
+    ~GameStartManager();
+
+    GameStartManager(const GameStartManager&)            = delete;
+    GameStartManager& operator=(const GameStartManager&) = delete;
 
     /**
      * Override the save directory at runtime. Replaces the directory set at
@@ -29,14 +93,155 @@ public:
     std::string getSaveDir() const;
 
     /**
-     * Copy KSC_DATA/GAME_STATE/ into saveDir/KSC_SLOT_N/ where N is the next
-     * available slot index. No-op if saveDir is empty.
+     * Background mode saves on a worker thread; otherwise the caller drives the
+     * save with runIdleSlice(). Defaults to background where threads exist.
+     * Finishes any save in flight before switching.
+     */
+    void setBackground(bool background);
+    bool isBackground() const { return mBackground; }
+
+    /**
+     * Start saving gameState (Game_State.json text) and the notes under
+     * GAME_STATE as the next slot. Returns immediately; a save already in
+     * flight is finished first. Returns false if saveDir is empty.
+     */
+    bool beginSave(std::string gameState);
+
+    /** True from beginSave() until the save has committed or failed. */
+    bool isSaving() const;
+
+    /** Run one step of the save in flight (idle mode). Returns false if there was nothing to do. */
+    bool runIdleSlice();
+
+    /** Finish the save in flight on this thread, or wait for the worker. */
+    void waitForSave();
+
+    /**
+     * Report one finished save: slot is the slot written, or -1 if it failed.
+     * Returns false when no finished save is left to report. Main thread only.
+     */
+    bool pollCompleted(int& slot);
+
+    /**
+     * Save Game_State.json and the notes as they are on storage, waiting for
+     * the save to commit. Returns the slot number written, or -1 on failure.
+     */
+    int save();
+
+    /**
+     * Reconstruct a saved slot. Returns false if the slot, or the base a delta
+     * slot refers to, cannot be read.
      */
-    void save();
+    bool readSlot(int slot, SlotContents& out);
+
+    /**
+     * Open a slot to resume from: gameState gets its Game_State.json text,
+     * while the notes are left on storage until takeLoadedNote(). Replaces
+     * the notes of any slot loaded before. Returns false, changing nothing,
+     * if the slot cannot be read.
+     */
+    bool load(int slot, std::string& gameState);
+
+    /** Notes of the loaded slot not taken yet, as "AVERY/Avery_Note.md". */
+    std::vector<std::string> getLoadedNotes() const;
+
+    /**
+     * Read one note of the loaded slot and forget it. Returns false if the
+     * slot has no such note or it was already taken.
+     */
+    bool takeLoadedNote(const std::string& path, std::string& text);
+
+    /**
+     * A slot packed as a base container, whatever form it was saved in, for
+     * comparing slots with GameStateComparison. Empty if the slot cannot be read.
+     */
+    std::string exportSlot(int slot);
+
+    /**
+     * Write a slot back over GAME_STATE (Game_State.json and its notes) and
+     * clear the discovery journal. Returns false, touching nothing, if the
+     * slot cannot be read. See GameRunner::restoreSlot to resume from it.
+     */
+    bool restore(int slot);
 
 private:
+    struct NoteStamp
+    {
+        size_t   length = 0;
+        uint32_t hash   = 0;
+    };
+
+    struct Index
+    {
+        uint32_t                         sequence = 0; // commits so far; picks the newer copy
+        int                              nextSlot = 0;
+        int                              baseSlot = -1;
+        std::map<std::string, NoteStamp> baseNotes;
+    };
+
+    // Where a saved note's text is: a NOTE_STORE blob or text in the slot
+    // itself, followed by anything a delta appended.
+    struct NoteSource
+    {
+        std::string blob;
+        std::string text;
+        std::string append;
+    };
+
+    struct OpenedSlot
+    {
+        std::string                       gameState;
+        std::map<std::string, NoteSource> notes;
+    };
+
+    // One save, advanced a step at a time: prepare, read each note, pack the
+    // slot, write each new note blob, write the slot, commit.
+    struct SaveJob
+    {
+        enum class Step { Prepare, ReadNotes, PackSlot, WriteNotes, WriteSlot, Commit, Done };
+
+        Step                               step = Step::Prepare;
+        std::string                        gameState;
+        Index                              index;
+        bool                               indexed = false;
+        int                                slot    = -1;
+        std::vector<std::string>           notePaths;
+        size_t                             nextNote = 0;
+        std::map<std::string, std::string> notes;
+        std::string                        slotBytes;
+        std::vector<std::pair<std::string, std::string>> newBlobs; // blob -> note path
+        size_t                             nextBlob = 0;
+    };
+
     FileOperator& mFileOperator;
     std::string   mSaveDir;
+    int           mBaseSlot = -1; // slot mBaseState was read from
+    std::string   mBaseState;
+    std::map<std::string, NoteSource> mLoadedNotes; // by load(), until taken
+
+    bool                     mBackground = KSC_HAS_THREADS;
+    std::unique_ptr<SaveJob> mJob;     // owned by the worker while it runs
+    std::atomic<bool>        mJobDone{ false };
+    std::deque<int>          mCompleted;
+#if KSC_HAS_THREADS
+    std::thread              mWorker;
+#endif
+
+    bool stepSave(SaveJob& job);
+    void collectSave();
+
+    int                findNextSlotIndex();
+    bool               loadIndex(Index& index);
+    void               writeIndex(const Index& index);
+    std::string        slotPath(int slot) const;
+    std::string        blobPath(const std::string& blob) const;
+    const std::string& baseState(int baseSlot);
+    bool               openSlot(int slot, OpenedSlot& out, bool allowDelta);
+    bool               openSlotDirectory(int slot, OpenedSlot& out);
+    std::string        readNote(const NoteSource& source);
 
-    int findNextSlotIndex();
+    std::string packBase(int slot, const std::string& gameState, const std::map<std::string, std::string>& notes,
+                         Index& index, std::vector<std::pair<std::string, std::string>>& newBlobs);
+    std::string packDelta(const std::string& gameState, const std::map<std::string, std::string>& notes,
+                          const Index& index);
 };
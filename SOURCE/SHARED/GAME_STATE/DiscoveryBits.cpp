@@ -0,0 +1,83 @@
+#include "DiscoveryBits.h"
+#include <algorithm>
+
+void DiscoveryBits::set(uint32_t id, bool value)
+{
+    uint32_t w = id / k_WordBits;
+    if (w >= mWords.size())
+    {
+        if (!value) return;
+        mWords.resize(w + 1, 0);
+    }
+    Word mask = Word(1) << (id % k_WordBits);
+    if (value) mWords[w] |= mask;
+    else       mWords[w] &= ~mask;
+}
+
+size_t DiscoveryBits::count() const
+{
+    size_t n = 0;
+    forEach([&n](uint32_t) { n++; });
+    return n;
+}
+
+bool DiscoveryBits::none() const
+{
+    return std::all_of(mWords.begin(), mWords.end(), [](Word w) { return w == 0; });
+}
+
+DiscoveryBits& DiscoveryBits::operator^=(const DiscoveryBits& other)
+{
+    if (mWords.size() < other.mWords.size())
+        mWords.resize(other.mWords.size(), 0);
+    for (size_t w = 0; w < other.mWords.size(); ++w)
+        mWords[w] ^= other.mWords[w];
+    return *this;
+}
+
+DiscoveryBits& DiscoveryBits::operator&=(const DiscoveryBits& other)
+{
+    if (mWords.size() > other.mWords.size())
+        mWords.resize(other.mWords.size());
+    for (size_t w = 0; w < mWords.size(); ++w)
+        mWords[w] &= other.mWords[w];
+    return *this;
+}
+
+DiscoveryBits& DiscoveryBits::operator|=(const DiscoveryBits& other)
+{
+    if (mWords.size() < other.mWords.size())
+        mWords.resize(other.mWords.size(), 0);
+    for (size_t w = 0; w < other.mWords.size(); ++w)
+        mWords[w] |= other.mWords[w];
+    return *this;
+}
+
+DiscoveryBits& DiscoveryBits::subtract(const DiscoveryBits& other)
+{
+    size_t n = std::min(mWords.size(), other.mWords.size());
+    for (size_t w = 0; w < n; ++w)
+        mWords[w] &= ~other.mWords[w];
+    return *this;
+}
+
+std::string DiscoveryBits::toBytes() const
+{
+    std::string bytes;
+    bytes.reserve(mWords.size() * sizeof(Word));
+    for (Word w : mWords)
+        for (uint32_t b = 0; b < sizeof(Word); ++b)
+            bytes.push_back(static_cast<char>((w >> (b * 8)) & 0xFF));
+    while (!bytes.empty() && bytes.back() == '\0')
+        bytes.pop_back();
+    return bytes;
+}
+
+DiscoveryBits DiscoveryBits::fromBytes(const std::string& bytes)
+{
+    DiscoveryBits bits;
+    bits.mWords.resize((bytes.size() + sizeof(Word) - 1) / sizeof(Word), 0);
+    for (size_t i = 0; i < bytes.size(); ++i)
+        bits.mWords[i / sizeof(Word)] |= Word(static_cast<uint8_t>(bytes[i])) << ((i % sizeof(Word)) * 8);
+    return bits;
+}
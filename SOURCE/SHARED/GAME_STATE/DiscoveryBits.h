@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * Dense set of scene IDs (see SceneIDTable), one bit per ID in 64-bit
+ * words. test() and set() are O(1); the set operations work a word at a
+ * time, so diffing two states is an XOR over a handful of words.
+ *
+ * Bits past the last word read as clear, so sets of different lengths
+ * compare and combine as if padded with zeros.
+ */
+class DiscoveryBits
+{
+public:
+    using Word = uint64_t;
+    static constexpr uint32_t k_WordBits = 64;
+
+    bool test(uint32_t id) const
+    {
+        uint32_t w = id / k_WordBits;
+        return w < mWords.size() && ((mWords[w] >> (id % k_WordBits)) & 1);
+    }
+
+    void set(uint32_t id, bool value = true);
+
+    size_t count() const;
+    bool   none()  const;
+
+    DiscoveryBits& operator^=(const DiscoveryBits& other);
+    DiscoveryBits& operator&=(const DiscoveryBits& other);
+    DiscoveryBits& operator|=(const DiscoveryBits& other);
+    /** Clear every bit that is set in other. */
+    DiscoveryBits& subtract(const DiscoveryBits& other);
+
+    friend DiscoveryBits operator^(DiscoveryBits a, const DiscoveryBits& b) { return a ^= b; }
+    friend DiscoveryBits operator&(DiscoveryBits a, const DiscoveryBits& b) { return a &= b; }
+    friend DiscoveryBits operator|(DiscoveryBits a, const DiscoveryBits& b) { return a |= b; }
+
+    bool operator==(const DiscoveryBits& other) const { return (*this ^ other).none(); }
+    bool operator!=(const DiscoveryBits& other) const { return !(*this == other); }
+
+    /** Call fn(id) for every set bit, in ascending order. */
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (uint32_t w = 0; w < mWords.size(); ++w)
+        {
+            for (Word bits = mWords[w]; bits; bits &= bits - 1)
+                fn(w * k_WordBits + lowestBit(bits));
+        }
+    }
+
+    /**
+     * Little-endian bytes, bit i of the set at bit i % 8 of byte i / 8,
+     * with trailing zero bytes dropped. fromBytes() reads the same layout.
+     */
+    std::string          toBytes() const;
+    static DiscoveryBits fromBytes(const std::string& bytes);
+
+private:
+    std::vector<Word> mWords;
+
+    static uint32_t lowestBit(Word bits)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return index;
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+    }
+};
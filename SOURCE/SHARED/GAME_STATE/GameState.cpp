@@ -0,0 +1,444 @@
+#include "GameState.h"
+#include "../FILE_OPERATOR/FileOperator.h"
+#include "../UTIL/ByteIO.h"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+const char* const GameState::k_Path        = "/GAME_STATE/Game_State.json";
+const char* const GameState::k_JournalPath = "/GAME_STATE/Discovery.journal";
+
+static const char     k_JournalMagic[4]  = { 'K', 'S', 'C', 'J' };
+static const uint16_t k_JournalVersion   = 2;
+static const uint8_t  k_JournalSceneID   = 1; // u16 stable scene ID
+static const uint8_t  k_JournalInline    = 2; // u16 length, path bytes
+static const uint8_t  k_JournalPosition  = 3; // u8 field, u16 length, value bytes
+
+// Position fields, as journalled and as bits of mPositionDirty.
+static const uint8_t  k_PositionMode     = 0;
+static const uint8_t  k_PositionLocation = 1;
+static const uint8_t  k_PositionNote     = 2;
+
+// Seconds since the epoch, as journal records carry it.
+static uint32_t journalTimestamp()
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// Objects whose values are all booleans are discovery maps.
+static bool isDiscoveryMap(const json& value)
+{
+    if (!value.is_object()) return false;
+    for (const auto& entry : value)
+        if (!entry.is_boolean()) return false;
+    return true;
+}
+
+bool GameState::load(const std::string& jsonString)
+{
+    SceneIDTable sceneIDs = std::move(mSceneIDs);
+    *this     = GameState();
+    mSceneIDs = std::move(sceneIDs);
+
+    json j = json::parse(jsonString, nullptr, false);
+    if (j.is_discarded() || !j.is_object())
+        return false;
+
+    std::vector<std::string> notes;
+    for (auto it = j.begin(); it != j.end(); ++it)
+    {
+        const std::string& key   = it.key();
+        const json&        value = it.value();
+
+        if      (key == "currentMode"     && value.is_string()) mCurrentMode     = value.get<std::string>();
+        else if (key == "currentLocation" && value.is_string()) mCurrentLocation = value.get<std::string>();
+        else if (key == "currentNote"     && value.is_string()) mCurrentNote     = value.get<std::string>();
+        else if (key == "notes" && value.is_array())
+        {
+            for (const auto& n : value)
+                if (n.is_string()) notes.push_back(n.get<std::string>());
+        }
+        else if (key == "discovered" && value.is_array())
+        {
+            for (const auto& p : value)
+                if (p.is_string()) mDiscovered.set(mSceneIDs.intern(p.get<std::string>()));
+        }
+        else if (key == "note_configs" && value.is_object())
+        {
+            for (auto c = value.begin(); c != value.end(); ++c)
+                if (c.value().is_object())
+                    mNoteConfigs[c.key()] = { c.value().value("note_path", ""),
+                                              c.value().value("base_path", "") };
+        }
+        else if (isDiscoveryMap(value))
+        {
+            DiscoveryGroup& group = mDiscovery[key];
+            for (auto e = value.begin(); e != value.end(); ++e)
+            {
+                uint32_t id = mSceneIDs.intern(e.key());
+                group.ids.push_back(id);
+                group.members.set(id);
+                if (e.value().get<bool>()) mDiscovered.set(id);
+            }
+            mListed |= group.members;
+        }
+        else
+        {
+            mOtherKeys[key] = value.dump();
+        }
+    }
+    mNotes.setPaths(std::move(notes));
+    return true;
+}
+
+size_t GameState::replayJournal(const std::string& journal)
+{
+    mJournalBytes = 0;
+
+    ByteReader in{ journal };
+    std::string   magic     = in.bytes(sizeof(k_JournalMagic));
+    uint16_t      version   = in.u16();
+    uint16_t      tableSize = in.u16();
+    uint32_t      tableHash = in.u32();
+    if (!in.ok || magic.compare(0, 4, k_JournalMagic, 4) != 0 || version != k_JournalVersion
+        || tableSize > mSceneIDs.stableSize() || tableHash != mSceneIDs.hash(tableSize))
+        return 0; // the next flush starts a fresh journal
+
+    size_t applied = 0;
+    size_t end     = in.pos;
+    while (in.pos < journal.size())
+    {
+        uint8_t     kind  = in.u8();
+        uint8_t     field = 0;
+        std::string path;
+        if (kind == k_JournalSceneID)
+        {
+            uint16_t id = in.u16();
+            if (mSceneIDs.isStable(id)) path = mSceneIDs.path(id);
+            else                        in.ok = false;
+        }
+        else if (kind == k_JournalInline)
+        {
+            path = in.bytes(in.u16());
+        }
+        else if (kind == k_JournalPosition)
+        {
+            field = in.u8();
+            path  = in.bytes(in.u16());
+            if (field > k_PositionNote) in.ok = false;
+        }
+        else
+        {
+            in.ok = false;
+        }
+        bool discovered = in.u8() != 0;
+        in.u32(); // timestamp
+        if (!in.ok) break;
+
+        if      (kind != k_JournalPosition)     applyDiscovery(path, discovered);
+        else if (field == k_PositionMode)       mCurrentMode     = path;
+        else if (field == k_PositionLocation)   mCurrentLocation = path;
+        else                                    mCurrentNote     = path;
+        applied++;
+        end = in.pos;
+    }
+
+    mJournalBytes = journal.size();
+    if (end < journal.size())
+    {
+        // A torn or unreadable tail: appending after it would bury every
+        // later record, so fold what was read into Game_State.json instead.
+        mStateDirty = true;
+        markDirty();
+    }
+    return applied;
+}
+
+bool GameState::adopt(const std::string& jsonString)
+{
+    // Parsed aside, so a malformed document leaves the current state alone.
+    GameState adopted;
+    adopted.mSceneIDs = mSceneIDs;
+    if (!adopted.load(jsonString)) return false;
+
+    // The journal on storage belongs to the replaced state; compact() clears it.
+    adopted.mJournalBytes = mJournalBytes;
+    adopted.mJournalStale = true;
+    adopted.mStateDirty   = true;
+    *this = std::move(adopted);
+    markDirty();
+    return true;
+}
+
+std::string GameState::toJson() const
+{
+    json j = json::object();
+    for (const auto& [key, text] : mOtherKeys)
+        j[key] = json::parse(text, nullptr, false);
+
+    j["currentMode"]     = mCurrentMode;
+    j["currentLocation"] = mCurrentLocation;
+    j["currentNote"]     = mCurrentNote;
+    j["notes"]           = mNotes.getPaths();
+    for (const auto& [key, group] : mDiscovery)
+    {
+        json& map = j[key] = json::object();
+        for (uint32_t id : group.ids)
+            map[mSceneIDs.path(id)] = mDiscovered.test(id);
+    }
+
+    DiscoveryBits unlisted = mDiscovered;
+    unlisted.subtract(mListed);
+    if (!unlisted.none())
+    {
+        json& paths = j["discovered"] = json::array();
+        unlisted.forEach([&](uint32_t id) { paths.push_back(mSceneIDs.path(id)); });
+    }
+    if (!mNoteConfigs.empty())
+    {
+        json& configs = j["note_configs"];
+        for (const auto& [key, config] : mNoteConfigs)
+            configs[key] = { { "note_path", config.notePath }, { "base_path", config.basePath } };
+    }
+    return j.dump(2);
+}
+
+void GameState::setCurrentMode(const std::string& mode)
+{
+    if (mode == mCurrentMode) return;
+    mCurrentMode = mode;
+    mPositionDirty |= 1u << k_PositionMode;
+    markDirty();
+}
+
+void GameState::setCurrentLocation(const std::string& location)
+{
+    if (location == mCurrentLocation) return;
+    mCurrentLocation = location;
+    mPositionDirty |= 1u << k_PositionLocation;
+    markDirty();
+}
+
+void GameState::setCurrentNote(const std::string& note)
+{
+    if (note == mCurrentNote) return;
+    mCurrentNote = note;
+    mPositionDirty |= 1u << k_PositionNote;
+    markDirty();
+}
+
+bool GameState::isDiscovered(const std::string& scenePath) const
+{
+    uint32_t id = mSceneIDs.find(scenePath);
+    return id != SceneIDTable::k_None && mDiscovered.test(id);
+}
+
+bool GameState::applyDiscovery(const std::string& path, bool discovered)
+{
+    uint32_t id = mSceneIDs.intern(path);
+    if (mDiscovered.test(id) == discovered) return false;
+    mDiscovered.set(id, discovered);
+    return true;
+}
+
+void GameState::setDiscovered(const std::string& scenePath)
+{
+    if (!applyDiscovery(scenePath, true)) return;
+
+    ByteWriter out{ mJournalQueue };
+    uint32_t      id = mSceneIDs.find(scenePath);
+    if (mSceneIDs.isStable(id) && id <= UINT16_MAX)
+    {
+        out.u8(k_JournalSceneID);
+        out.u16(static_cast<uint16_t>(id));
+    }
+    else
+    {
+        out.u8(k_JournalInline);
+        out.u16(static_cast<uint16_t>(scenePath.size()));
+        mJournalQueue += scenePath;
+    }
+    out.u8(1);
+    out.u32(journalTimestamp());
+    markDirty();
+}
+
+const GameState::DiscoveryGroup* GameState::getDiscoveryGroup(const std::string& key) const
+{
+    auto it = mDiscovery.find(key);
+    return it != mDiscovery.end() ? &it->second : nullptr;
+}
+
+const GameState::NoteConfig* GameState::getNoteConfig(const std::string& key) const
+{
+    auto it = mNoteConfigs.find(key);
+    return it != mNoteConfigs.end() ? &it->second : nullptr;
+}
+
+void GameState::setNoteConfig(const std::string& key, const NoteConfig& config)
+{
+    NoteConfig& current = mNoteConfigs[key];
+    if (current.notePath == config.notePath && current.basePath == config.basePath) return;
+    current     = config;
+    mStateDirty = true;
+    markDirty();
+}
+
+void GameState::mergeProgress(const GameState& other)
+{
+    bool changed = false;
+    for (const auto& [key, theirs] : other.mDiscovery)
+    {
+        DiscoveryGroup& ours  = mDiscovery[key];
+        DiscoveryBits   added = theirs.members;
+        added.subtract(ours.members);
+        if (added.none()) continue;
+
+        for (uint32_t id : theirs.ids)
+            if (added.test(id)) ours.ids.push_back(id);
+        ours.members |= added;
+        mListed      |= added;
+        changed = true;
+    }
+
+    DiscoveryBits gained = other.mDiscovered;
+    gained.subtract(mDiscovered);
+    if (!gained.none())
+    {
+        mDiscovered |= gained;
+        changed = true;
+    }
+
+    std::vector<std::string> notes = mNotes.getPaths();
+    for (const std::string& path : other.mNotes.getPaths())
+    {
+        if (std::find(notes.begin(), notes.end(), path) != notes.end()) continue;
+        notes.push_back(path);
+        changed = true;
+    }
+    mNotes.setPaths(std::move(notes));
+
+    for (const auto& [key, config] : other.mNoteConfigs)
+        changed = mNoteConfigs.emplace(key, config).second || changed;
+
+    if (changed)
+    {
+        mStateDirty = true;
+        markDirty();
+    }
+}
+
+void GameState::setOtherKey(const std::string& key, const std::string& jsonText)
+{
+    auto it = mOtherKeys.find(key);
+    if (jsonText.empty() ? it == mOtherKeys.end() : it != mOtherKeys.end() && it->second == jsonText)
+        return;
+    if (jsonText.empty()) mOtherKeys.erase(it);
+    else                  mOtherKeys[key] = jsonText;
+    mStateDirty = true;
+    markDirty();
+}
+
+bool GameState::isDirty() const
+{
+    return mStateDirty || mPositionDirty != 0 || !mJournalQueue.empty() || mNotes.hasPendingAppends();
+}
+
+void GameState::queueNoteAppend(const std::string& notePath, const std::string& sourcePath)
+{
+    mNotes.queueAppend(notePath, sourcePath);
+    markDirty();
+}
+
+void GameState::dropNoteAppends(const std::string& notePath)
+{
+    mNotes.dropAppends(notePath);
+}
+
+void GameState::markDirty()
+{
+    // Only the first change of a batch starts the write-behind clock.
+    if (mDirtySince == Clock::time_point())
+        mDirtySince = Clock::now();
+}
+
+void GameState::flush(FileOperator& files)
+{
+    if (!isDirty()) return;
+
+    if (mStateDirty)
+    {
+        compact(files);
+        return;
+    }
+
+    // Only the latest position is journalled, a record per changed field.
+    for (uint8_t field : { k_PositionMode, k_PositionLocation, k_PositionNote })
+    {
+        if (!(mPositionDirty & (1u << field))) continue;
+        const std::string& value = field == k_PositionMode     ? mCurrentMode
+                                 : field == k_PositionLocation ? mCurrentLocation
+                                                               : mCurrentNote;
+        ByteWriter out{ mJournalQueue };
+        out.u8(k_JournalPosition);
+        out.u8(field);
+        out.u16(static_cast<uint16_t>(value.size()));
+        mJournalQueue += value;
+        out.u8(1);
+        out.u32(journalTimestamp());
+    }
+    mPositionDirty = 0;
+
+    // The journal goes first: it is the record of what was discovered, and
+    // refreshNote() can rebuild a note that missed its clue text.
+    if (!mJournalQueue.empty())
+    {
+        if (mJournalBytes == 0)
+        {
+            std::string journal;
+            ByteWriter  out{ journal };
+            journal.append(k_JournalMagic, sizeof(k_JournalMagic));
+            out.u16(k_JournalVersion);
+            out.u16(static_cast<uint16_t>(mSceneIDs.stableSize()));
+            out.u32(mSceneIDs.hash());
+            journal += mJournalQueue;
+            files.writeToFile(k_JournalPath, journal);
+            mJournalBytes = journal.size();
+        }
+        else
+        {
+            files.appendToFile(k_JournalPath, mJournalQueue);
+            mJournalBytes += mJournalQueue.size();
+        }
+        mJournalQueue.clear();
+    }
+
+    mNotes.flush(files);
+    mDirtySince = Clock::time_point();
+}
+
+void GameState::compact(FileOperator& files)
+{
+    if (mJournalBytes == 0 && !isDirty()) return; // storage is already current
+
+    mNotes.flush(files);
+
+    // State first: if power is lost before the journal is emptied, replaying
+    // it over the compacted state is a no-op. A journal left by an adopted
+    // state's predecessor would not be, so that one goes first.
+    bool journalFirst = mJournalStale && mJournalBytes > 0;
+    if (journalFirst)
+        files.writeToFile(k_JournalPath, "");
+    files.writeToFile(k_Path, toJson());
+    if (mJournalBytes > 0 && !journalFirst)
+        files.writeToFile(k_JournalPath, "");
+
+    mJournalQueue.clear();
+    mJournalBytes = 0;
+    mJournalStale = false;
+    mStateDirty   = false;
+    mDirtySince   = Clock::time_point();
+    mPositionDirty = 0;
+}
@@ -3,18 +3,193 @@
  */
 
 #pragma once
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "DiscoveryBits.h"
+#include "SceneIDTable.h"
 #include "../NOTES/Notes.h"
-#include "../SCENE/Scene.h"
+
+class FileOperator;
+
 /**
+ * In-memory model of Game_State.json: the current mode, location and note,
+ * the player's notes, and the discovery maps (e.g. "avery_locations", a map
+ * of scene path to discovered flag).
+ *
+ * Discovery is held as one DiscoveryBits set indexed by SceneIDTable IDs,
+ * so isDiscovered() is a hash lookup and a bit test and two states diff
+ * with a word-wide XOR. Each discovery map becomes a DiscoveryGroup: the
+ * IDs it lists, in path order, plus the same IDs as a bit mask.
+ * setSceneIDs() installs the generated table; paths it lacks are interned
+ * as they are seen.
+ *
+ * GameRunner reads and changes this model instead of the files. Changes are
+ * written behind: they mark the state dirty and flush() persists them in
+ * one batch. Discoveries go to an append-only journal next to the state
+ * (k_JournalPath), a few bytes each, as do the current mode, location and
+ * note (their latest values, once per flush). Queued clue text is appended
+ * to its note. Scene files are never rewritten.
+ *
+ * Journal layout (all integers little-endian):
+ *
+ *   header      "KSCJ"  u16 version  u16 table size  u32 table hash
+ *   records     u8 kind, then
+ *                 kind 1: u16 scene ID         - a stable SceneIDTable ID
+ *                 kind 2: u16 length, bytes    - any other path
+ *                 kind 3: u8 field, u16 length, bytes
+ *                                              - the current mode (field 0),
+ *                                                location (1) or note (2)
+ *               u8 flag (1 discovered; 1 for kind 3)
+ *               u32 timestamp (seconds since the epoch)
+ *
+ * The header names the scene-ID table the journal was written against. A
+ * journal whose table is not a prefix of the current one is ignored rather
+ * than misread. A torn record at the end (power lost mid-append) is ignored
+ * as well.
+ *
+ * compact() folds the journal into Game_State.json and empties it; paths
+ * no discovery map lists are kept in its "discovered" array. Replaying a
+ * journal over the state it was compacted into changes nothing, so losing
+ * power between the two writes is harmless. After adopt() the journal
+ * belongs to the replaced state, so it is emptied before the state is
+ * written instead.
  *
+ * Keys the model does not interpret are kept and written back unchanged.
  */
 class GameState
 {
 public:
+    using Clock = std::chrono::steady_clock;
+
+    struct DiscoveryGroup
+    {
+        std::vector<uint32_t> ids;     // scene IDs, in path order
+        DiscoveryBits         members; // the same IDs as a mask
+    };
+
+    struct NoteConfig
+    {
+        std::string notePath; // note file rebuilt by refreshNote
+        std::string basePath; // clue-free starting text
+    };
+
+    static const char* const k_Path;        // "/GAME_STATE/Game_State.json"
+    static const char* const k_JournalPath; // "/GAME_STATE/Discovery.journal"
+
+    /**
+     * Use table for scene IDs. Call before load(); the table is kept across
+     * loads and grows as unknown paths are interned.
+     */
+    void                setSceneIDs(SceneIDTable table) { mSceneIDs = std::move(table); }
+    const SceneIDTable& getSceneIDs() const             { return mSceneIDs; }
+
+    /** Replace the model with the given document. Returns false, leaving it empty, if malformed. */
+    bool        load(const std::string& json);
+    std::string toJson() const;
+
+    /**
+     * load() a document storage does not hold, such as a save slot: the
+     * next flush writes it over Game_State.json and empties the journal.
+     * Returns false, leaving the current state untouched, if malformed.
+     */
+    bool adopt(const std::string& json);
+
+    /**
+     * Apply a discovery journal read from k_JournalPath on top of the loaded
+     * state. Returns the number of records applied: 0 for an empty journal
+     * or one written against a different scene-ID table.
+     */
+    size_t replayJournal(const std::string& journal);
+
+    /** Bytes the journal holds on storage, header included. */
+    size_t getJournalBytes() const { return mJournalBytes; }
+
+    const std::string& getCurrentMode()     const { return mCurrentMode; }
+    const std::string& getCurrentLocation() const { return mCurrentLocation; }
+    const std::string& getCurrentNote()     const { return mCurrentNote; }
+    void setCurrentMode(const std::string& mode);
+    void setCurrentLocation(const std::string& location);
+    void setCurrentNote(const std::string& note);
+
+    const Notes& getNotes() const { return mNotes; }
+
+    /** Queue the contents of sourcePath to be appended to notePath on flush. */
+    void queueNoteAppend(const std::string& notePath, const std::string& sourcePath);
+
+    /** Drop the appends queued for notePath; refreshNote() writes those clues itself. */
+    void dropNoteAppends(const std::string& notePath);
+
+    bool isDiscovered(const std::string& scenePath) const;
+    bool isDiscovered(uint32_t sceneID) const { return mDiscovered.test(sceneID); }
+
+    /** Every discovered scene ID, whichever map (if any) lists it. */
+    const DiscoveryBits& getDiscovered() const { return mDiscovered; }
+
+    /** Mark scenePath discovered and queue a journal record. No-op if it already is. */
+    void setDiscovered(const std::string& scenePath);
+
+    /** The named discovery map, or nullptr. */
+    const DiscoveryGroup*                        getDiscoveryGroup(const std::string& key) const;
+    const std::map<std::string, DiscoveryGroup>& getDiscoveryGroups() const { return mDiscovery; }
+    const NoteConfig*                            getNoteConfig(const std::string& key) const;
+    const std::map<std::string, NoteConfig>&     getNoteConfigs() const { return mNoteConfigs; }
+    void setNoteConfig(const std::string& key, const NoteConfig& config);
+
+    /**
+     * Add other's progress to this state: every scene it has discovered, the
+     * discovery maps and map entries only it has, the notes only it lists
+     * (after this state's own) and its note configs. Nothing is ever
+     * undiscovered. Both states must number scenes from one table (other's
+     * table a copy of this one's, or the reverse). Linear in the number of
+     * scene IDs; Game_State.json is rewritten on the next flush.
+     */
+    void mergeProgress(const GameState& other);
+
+    /** Top-level keys the model does not interpret, each value as JSON text. */
+    const std::map<std::string, std::string>& getOtherKeys() const { return mOtherKeys; }
+    /** Set (or, given empty text, remove) one of those keys. */
+    void setOtherKey(const std::string& key, const std::string& jsonText);
+
+    /** True while there are changes flush() has not written yet. */
+    bool              isDirty()    const;
+    /** When the oldest unflushed change was made. */
+    Clock::time_point dirtySince() const { return mDirtySince; }
+
+    /**
+     * Write every pending change: journal records and note appends, or a
+     * full compact() when a field other than discovery or position changed.
+     * No-op when clean.
+     */
+    void flush(FileOperator& files);
+
+    /**
+     * Write pending note appends and the whole of Game_State.json, then
+     * empty the journal. No-op when the journal is empty and nothing is pending.
+     */
+    void compact(FileOperator& files);
 
-    const Notes& getNotes() { return mNotes; }
-    const Scene& getScene() { return mCurrentScene; }
 private:
-    Notes mNotes;
-    Scene mCurrentScene;
+    std::string                           mCurrentMode;
+    std::string                           mCurrentLocation;
+    std::string                           mCurrentNote;
+    Notes                                 mNotes;
+    SceneIDTable                          mSceneIDs;
+    DiscoveryBits                         mDiscovered;
+    DiscoveryBits                         mListed; // union of every group's members
+    std::map<std::string, DiscoveryGroup> mDiscovery;
+    std::map<std::string, NoteConfig>     mNoteConfigs;
+    std::map<std::string, std::string>    mOtherKeys; // key -> value as JSON text
+
+    std::string       mJournalQueue;          // records not written yet
+    size_t            mJournalBytes = 0;
+    bool              mStateDirty   = false;  // Game_State.json needs rewriting
+    bool              mJournalStale = false;  // the journal on storage predates adopt()
+    uint8_t           mPositionDirty = 0;     // mode, location or note changed since the last flush
+    Clock::time_point mDirtySince;
+
+    bool applyDiscovery(const std::string& path, bool discovered);
+    void markDirty();
 };
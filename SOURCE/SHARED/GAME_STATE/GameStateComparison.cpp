@@ -1,61 +1,385 @@
 #include "GameStateComparison.h"
+#include "GameState.h"
+#include "SlotContainer.h"
+#include "../FILE_OPERATOR/FileOperator.h"
+#include "../UTIL/KSC_Threads.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string_view>
 
-static const std::vector<std::string> k_ScalarFields = {
-    "currentMode", "currentLocation", "currentNote"
-};
+using json = nlohmann::json;
+
+static const char* const k_ComparedStateEntry = "Game_State.json";
 
-GameStateComparison::GameStateComparison(const std::string& jsonA, const std::string& jsonB)
-: mJsonA(jsonA)
-, mJsonB(jsonB)
+namespace
 {
+// splitmix64's finalizer: spreads every input bit over the whole word.
+uint64_t mixDigest(uint64_t x)
+{
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27; x *= 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
 }
 
-bool GameStateComparison::isEqual() const
+uint64_t digestBytes(const char* data, size_t length, uint64_t seed)
 {
-    return mJsonA == mJsonB;
+    uint64_t hash = 14695981039346656037ull ^ seed;
+    for (size_t i = 0; i < length; ++i)
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ull;
+    return mixDigest(hash);
 }
 
-GameStateComparison::Diff GameStateComparison::getDiff() const
+// Mixed into each value's hash so a string never hashes like a number.
+enum DigestTag : uint64_t { k_TagNull = 1, k_TagFalse, k_TagTrue, k_TagInteger, k_TagFloat, k_TagString, k_TagObject, k_TagArray, k_TagUnsigned };
+
+// What one pass over a Game_State document keeps.
+struct StateSummary
 {
-    Diff diff;
+    bool                                            ok     = false;
+    uint64_t                                        digest = 0;
+    std::string                                     mode, location, note;
+    std::map<std::string, GameState::DiscoveryGroup> groups;
+    DiscoveryBits                                   discovered;
+};
 
-    nlohmann::json a = nlohmann::json::parse(mJsonA, nullptr, false);
-    nlohmann::json b = nlohmann::json::parse(mJsonB, nullptr, false);
+// Streams a Game_State document into a StateSummary, reading discovery the
+// way GameState::load does: "discovered" lists paths, and any other
+// top-level object whose values are all booleans is a discovery map. As in
+// load, a reserved key only claims a value of its own type, so e.g. a
+// "currentMode" object of booleans is a discovery map too. Paths are
+// interned into the table shared by both sides of a comparison.
+//
+// The digest is built bottom-up: an object sums its members' key and value
+// hashes, so key order does not matter; an array folds its elements in order.
+class StateScanner : public nlohmann::json_sax<json>
+{
+public:
+    StateScanner(StateSummary& out, SceneIDTable& ids) : mOut(out), mIDs(ids) {}
 
-    if (a.is_discarded() || b.is_discarded())
-        return diff;
+    /** True once the document has turned out to be an object, as GameState requires. */
+    bool isObject() const { return mRootObject; }
 
-    for (const std::string& field : k_ScalarFields)
+    bool null() override                                 { return leaf(mixDigest(k_TagNull)); }
+    bool boolean(bool val) override
     {
-        std::string va = a.value(field, "");
-        std::string vb = b.value(field, "");
-        if (va != vb)
-            diff.scalars.push_back({ field, va, vb });
+        if (mDepth == 2 && mTop == Top::Map && mMapOk)
+            mMapEntries.emplace_back(mEntryKey, val);
+        else
+            notMapEntry();
+        return leaf(mixDigest(val ? k_TagTrue : k_TagFalse));
+    }
+    bool number_integer(number_integer_t val) override   { notMapEntry(); return integer((uint64_t)val); }
+    bool number_unsigned(number_unsigned_t val) override
+    {
+        notMapEntry();
+        // Above INT64_MAX the bits would match a negative integer's.
+        if (val > (number_unsigned_t)INT64_MAX) return leaf(mixDigest(val ^ (k_TagUnsigned << 56)));
+        return integer(val);
+    }
+    bool number_float(number_float_t val, const string_t&) override
+    {
+        notMapEntry();
+        // Integral values hash as integers, so 1.0 equals 1.
+        if (std::isfinite(val) && val == std::floor(val) && std::fabs(val) < 9.2e18)
+            return integer((uint64_t)(int64_t)val);
+        if (val == 0.0) val = 0.0; // -0.0
+        uint64_t bits;
+        static_assert(sizeof bits == sizeof val, "double is not 64 bits");
+        std::memcpy(&bits, &val, sizeof bits);
+        return leaf(mixDigest(bits ^ k_TagFloat));
+    }
+    bool string(string_t& val) override
+    {
+        notMapEntry();
+        if (mDepth == 1)
+        {
+            if      (mTop == Top::Mode)     mOut.mode     = val;
+            else if (mTop == Top::Location) mOut.location = val;
+            else if (mTop == Top::Note)     mOut.note     = val;
+        }
+        else if (mDepth == 2 && mTop == Top::Discovered)
+        {
+            mOut.discovered.set(mIDs.intern(val));
+        }
+        return leaf(digestBytes(val.data(), val.size(), k_TagString));
     }
+    bool binary(binary_t&) override                      { return false; }
 
-    for (auto it = a.begin(); it != a.end(); ++it)
+    bool start_object(std::size_t) override
+    {
+        notMapEntry();
+        if (mDepth == 0) mRootObject = true;
+        // Only note_configs claims an object; under any other key it may be a map.
+        if (mDepth == 1 && mTop != Top::NoteConfigs)
+        {
+            mTop   = Top::Map;
+            mMapOk = true;
+            mMapEntries.clear();
+        }
+        return open(true);
+    }
+    bool start_array(std::size_t) override
+    {
+        notMapEntry();
+        return open(false);
+    }
+    bool end_object() override
     {
-        if (!it.value().is_object()) continue;
+        if (mDepth == 2 && mTop == Top::Map && mMapOk)
+        {
+            GameState::DiscoveryGroup& group = mOut.groups[mMapKey];
+            group = GameState::DiscoveryGroup();
+            // Interned only now: paths of a map that turned out mixed get no ID.
+            for (const auto& [path, discovered] : mMapEntries)
+            {
+                uint32_t id = mIDs.intern(path);
+                group.ids.push_back(id);
+                group.members.set(id);
+                if (discovered) mOut.discovered.set(id);
+            }
+        }
+        return close(k_TagObject);
+    }
+    bool end_array() override
+    {
+        return close(k_TagArray);
+    }
 
-        const std::string& mapKey = it.key();
-        if (!b.contains(mapKey) || !b[mapKey].is_object()) continue;
+    bool key(string_t& val) override
+    {
+        if (mDepth == 1)
+        {
+            mTop = Top::Other;
+            if      (val == "currentMode")     mTop = Top::Mode;
+            else if (val == "currentLocation") mTop = Top::Location;
+            else if (val == "currentNote")     mTop = Top::Note;
+            else if (val == "discovered")      mTop = Top::Discovered;
+            else if (val == "notes")           mTop = Top::Notes;
+            else if (val == "note_configs")    mTop = Top::NoteConfigs;
+            mMapKey = val;
+        }
+        else if (mDepth == 2 && mTop == Top::Map)
+        {
+            mEntryKey = val;
+        }
+        mFrames.back().key = digestBytes(val.data(), val.size(), k_TagString);
+        return true;
+    }
 
-        const auto& mapA = it.value();
-        const auto& mapB = b[mapKey];
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override
+    {
+        return false;
+    }
 
-        for (auto entry = mapA.begin(); entry != mapA.end(); ++entry)
+private:
+    // Which top-level key the parser is inside.
+    enum class Top : uint8_t { Other, Mode, Location, Note, Discovered, Notes, NoteConfigs, Map };
+
+    struct Frame
+    {
+        bool     object;
+        uint64_t acc   = 0;
+        uint64_t key   = 0; // hash of the member being read
+        uint64_t count = 0;
+    };
+
+    StateSummary&      mOut;
+    SceneIDTable&      mIDs;
+    std::vector<Frame> mFrames;
+    int                mDepth = 0; // mFrames.size()
+    Top                mTop   = Top::Other;
+    std::string        mMapKey, mEntryKey;
+    bool               mMapOk = false;
+    bool               mRootObject = false;
+    std::vector<std::pair<std::string, bool>> mMapEntries;
+
+    // A value inside a candidate map that is not a boolean rules it out.
+    void notMapEntry()
+    {
+        if (mDepth == 2 && mTop == Top::Map) mMapOk = false;
+    }
+
+    bool integer(uint64_t val)
+    {
+        return leaf(mixDigest(val ^ (k_TagInteger << 56)));
+    }
+
+    bool leaf(uint64_t hash)
+    {
+        if (mFrames.empty())
         {
-            if (!entry.value().is_boolean()) continue;
-            if (!mapB.contains(entry.key())) continue;
+            mOut.digest = hash;
+            return true;
+        }
+        Frame& frame = mFrames.back();
+        if (frame.object) frame.acc += mixDigest(frame.key ^ mixDigest(hash));
+        else              frame.acc  = mixDigest(frame.acc * 0x100000001B3ull + hash);
+        frame.count++;
+        return true;
+    }
+
+    bool open(bool object)
+    {
+        mFrames.push_back({ object });
+        mDepth++;
+        return true;
+    }
+
+    bool close(DigestTag tag)
+    {
+        Frame frame = mFrames.back();
+        mFrames.pop_back();
+        mDepth--;
+        return leaf(mixDigest(frame.acc ^ mixDigest(frame.count + (uint64_t(tag) << 56))));
+    }
+};
+
+StateSummary summarizeState(std::string_view text, SceneIDTable& ids)
+{
+    StateSummary summary;
+    StateScanner scanner(summary, ids);
+    summary.ok = json::sax_parse(text.begin(), text.end(), &scanner) && scanner.isObject();
+    return summary;
+}
+
+// One side of a comparison: a document, or a container and its state
+// entry. A document compares like a container holding only that entry.
+struct ComparedSide
+{
+    SlotContainer    slot;
+    std::string_view state;
+    StateSummary     summary;
+
+    ComparedSide(const std::string& bytes, SceneIDTable& ids)
+    {
+        if (!SlotContainer::isContainer(bytes)) state = bytes;
+        else if (slot.open(bytes))              state = slot.get(k_ComparedStateEntry);
+        summary = summarizeState(state, ids);
+    }
+};
+
+// Fills diff with every difference from a to b, and returns whether the two
+// hold the same values.
+bool compareSides(const ComparedSide& a, const ComparedSide& b, const SceneIDTable& ids,
+                  GameStateComparison::Diff& diff)
+{
+    std::set<std::string> names;
+    for (const std::string& name : a.slot.names()) names.insert(name);
+    for (const std::string& name : b.slot.names()) names.insert(name);
+    for (const std::string& name : names)
+    {
+        if (name == k_ComparedStateEntry) continue;
+        if (a.slot.contains(name) != b.slot.contains(name) || a.slot.get(name) != b.slot.get(name))
+            diff.entries.push_back(name);
+    }
+
+    if (!a.summary.ok || !b.summary.ok)
+        return diff.entries.empty() && a.state == b.state;
+
+    auto scalar = [&](const char* field, const std::string& va, const std::string& vb)
+    {
+        if (va != vb)
+            diff.scalars.push_back({ field, va, vb });
+    };
+    scalar("currentMode",     a.summary.mode,     b.summary.mode);
+    scalar("currentLocation", a.summary.location, b.summary.location);
+    scalar("currentNote",     a.summary.note,     b.summary.note);
 
-            bool before = entry.value().get<bool>();
-            bool after  = mapB[entry.key()].get<bool>();
+    // Report a change under every map that lists the scene in both states.
+    DiscoveryBits changed = a.summary.discovered ^ b.summary.discovered;
+    if (!changed.none())
+    {
+        for (const auto& [mapKey, groupA] : a.summary.groups)
+        {
+            auto groupB = b.summary.groups.find(mapKey);
+            if (groupB == b.summary.groups.end()) continue;
 
-            if (before != after)
-                diff.discoveries.push_back({ mapKey, entry.key(), before, after });
+            DiscoveryBits inMap = changed & groupA.members & groupB->second.members;
+            inMap.forEach([&](uint32_t id)
+            {
+                diff.discoveries.push_back({ mapKey, ids.path(id), a.summary.discovered.test(id),
+                                             b.summary.discovered.test(id) });
+            });
         }
     }
 
+    // The digest alone could collide; the fields diffed above are exact.
+    return diff.isEmpty() && a.summary.digest == b.summary.digest;
+}
+} // namespace
+
+GameStateComparison::GameStateComparison(std::string jsonA, std::string jsonB)
+: mJsonA(std::move(jsonA))
+, mJsonB(std::move(jsonB))
+{
+}
+
+bool GameStateComparison::isEqual() const
+{
+    if (mJsonA == mJsonB) return true;
+
+    SceneIDTable ids;
+    ComparedSide a(mJsonA, ids), b(mJsonB, ids);
+    Diff         diff;
+    return compareSides(a, b, ids, diff);
+}
+
+GameStateComparison::Diff GameStateComparison::getDiff() const
+{
+    // Both sides number their paths from one table, so a scene has the same
+    // bit in each.
+    SceneIDTable ids;
+    ComparedSide a(mJsonA, ids), b(mJsonB, ids);
+    Diff         diff;
+    compareSides(a, b, ids, diff);
     return diff;
 }
+
+std::vector<GameStateComparison::FileResult>
+GameStateComparison::compareDirectory(FileOperator& files, const std::string& dir,
+                                      const std::string& golden, unsigned threads)
+{
+    std::vector<std::string> names = files.listDirectory(dir);
+    std::sort(names.begin(), names.end());
+
+    std::vector<FileResult> results(names.size());
+    SceneIDTable goldenIDs;
+    const ComparedSide goldenSide(golden, goldenIDs);
+
+    // Each file interns its new paths into its own copy of golden's table.
+    std::atomic<size_t> next{ 0 };
+    auto work = [&]
+    {
+        for (size_t i = next++; i < names.size(); i = next++)
+        {
+            std::string  bytes = files.load(dir + "/" + names[i]);
+            SceneIDTable ids   = goldenIDs;
+            ComparedSide side(bytes, ids);
+
+            FileResult& result = results[i];
+            result.name  = names[i];
+            result.equal = compareSides(goldenSide, side, ids, result.diff) || bytes == golden;
+        }
+    };
+
+#if KSC_HAS_THREADS
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = (unsigned)std::min<size_t>(threads, names.size());
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t)
+        workers.emplace_back(work);
+    work();
+    for (std::thread& worker : workers)
+        worker.join();
+#else
+    (void)threads;
+    work();
+#endif
+    return results;
+}
@@ -6,8 +6,28 @@
 #include <string>
 #include <vector>
 
+class FileOperator;
+
 /**
- * Compares two Game_State.json documents.
+ * Compares two Game_State.json documents, or two base save slots packed as
+ * SlotContainers (see GameStartManager::exportSlot). For containers the
+ * Game_State.json entries are compared as documents, and every other entry
+ * (the notes) by content. A document compares like a container holding
+ * only its Game_State.json.
+ *
+ * Documents are streamed through a SAX handler, never parsed into a DOM: one
+ * pass over each keeps the scalar fields, the discovery maps as bits over a
+ * SceneIDTable both documents share, and a digest of the whole document.
+ * Discovery is diffed by XORing the two bit sets and turning only the
+ * differing bits back into paths.
+ *
+ * The digest ignores whitespace, key order and number spelling (1, 1.0 and
+ * 1e0 are one value), so isEqual() is a semantic comparison. It is a 64-bit
+ * hash, so equal digests are only believed once the exact comparison behind
+ * getDiff() (the scalar fields, every discovery bit and every container
+ * entry) finds no difference too. A collision can therefore only hide a
+ * change outside those fields: the notes list, the note configs, or a key
+ * GameState does not interpret.
  *
  * Usage:
  *   GameStateComparison cmp(jsonA, jsonB);
@@ -35,18 +55,40 @@ public:
     {
         std::vector<ScalarChange>    scalars;
         std::vector<DiscoveryChange> discoveries;
+        std::vector<std::string>     entries; // container entries added, removed or changed
 
-        bool isEmpty() const { return scalars.empty() && discoveries.empty(); }
+        bool isEmpty() const { return scalars.empty() && discoveries.empty() && entries.empty(); }
     };
 
-    GameStateComparison(const std::string& jsonA, const std::string& jsonB);
+    /** One file of a compareDirectory() run. */
+    struct FileResult
+    {
+        std::string name;          // file name within the directory
+        bool        equal = false; // as isEqual()
+        Diff        diff;          // golden -> file
+    };
+
+    GameStateComparison(std::string jsonA, std::string jsonB);
 
-    /** Returns true if both documents are identical. */
+    /**
+     * Returns true if both documents hold the same values, however they are
+     * formatted. Container entries other than Game_State.json must match byte for byte.
+     */
     bool isEqual() const;
 
     /** Returns a breakdown of every difference between the two documents. */
     Diff getDiff() const;
 
+    /**
+     * Compare every file in dir against golden (a document or a container),
+     * reading each file once through files. Golden is streamed only once for
+     * the whole run. Files are spread over up to threads worker threads (0:
+     * one per core; always 1 on single-threaded builds), so files must
+     * tolerate concurrent loads. Results are in file-name order.
+     */
+    static std::vector<FileResult> compareDirectory(FileOperator& files, const std::string& dir,
+                                                    const std::string& golden, unsigned threads = 0);
+
 private:
     std::string mJsonA;
     std::string mJsonB;
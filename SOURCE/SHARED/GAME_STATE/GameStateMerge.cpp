@@ -0,0 +1,83 @@
+#include "GameStateMerge.h"
+#include "GameState.h"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include <set>
+
+GameStateMerge::Result GameStateMerge::merge(const std::string& base, const std::string& ours,
+                                             const std::string& theirs)
+{
+    Result result;
+
+    // Each state takes over the previous one's table, so every path keeps
+    // its ID and ours, loaded last, can take theirs' bits as they are.
+    GameState baseState, theirState, merged;
+    if (!baseState.load(base)) return result;
+    theirState.setSceneIDs(baseState.getSceneIDs());
+    if (!theirState.load(theirs)) return result;
+    merged.setSceneIDs(theirState.getSceneIDs());
+    if (!merged.load(ours)) return result;
+
+    // Base last: anything it had discovered that both sides lost comes back.
+    merged.mergeProgress(theirState);
+    merged.mergeProgress(baseState);
+
+    // Scalars: whichever side changed the field from base.
+    const auto oursChanged   = GameStateComparison(base, ours).getDiff().scalars;
+    const auto theirsChanged = GameStateComparison(base, theirs).getDiff().scalars;
+    for (const auto& theirChange : theirsChanged)
+    {
+        auto ourChange = std::find_if(oursChanged.begin(), oursChanged.end(),
+                                      [&](const auto& change) { return change.field == theirChange.field; });
+        if (ourChange != oursChanged.end())
+        {
+            if (ourChange->after != theirChange.after)
+                result.conflicts.push_back({ *ourChange, theirChange });
+            continue;
+        }
+
+        if      (theirChange.field == "currentMode")     merged.setCurrentMode(theirChange.after);
+        else if (theirChange.field == "currentLocation") merged.setCurrentLocation(theirChange.after);
+        else if (theirChange.field == "currentNote")     merged.setCurrentNote(theirChange.after);
+    }
+
+    // Keys the model does not interpret, compared as JSON text; a missing
+    // key reads as empty text.
+    auto valueOf = [](const GameState& state, const std::string& key)
+    {
+        auto it = state.getOtherKeys().find(key);
+        return it != state.getOtherKeys().end() ? it->second : std::string();
+    };
+    std::set<std::string> keys;
+    for (const GameState* state : { &baseState, &theirState, &merged })
+        for (const auto& [key, value] : state->getOtherKeys())
+            keys.insert(key);
+    for (const std::string& key : keys)
+    {
+        std::string b = valueOf(baseState, key), o = valueOf(merged, key), t = valueOf(theirState, key);
+        if (o == t || t == b) continue;
+        if (o == b) merged.setOtherKey(key, t);
+        else        result.conflicts.push_back({ { key, b, o }, { key, b, t } });
+    }
+
+    // Note configs only one side has were kept above; one both sides have
+    // takes the side that changed it, as JSON text like the keys above.
+    auto configOf = [](const GameState& state, const std::string& key)
+    {
+        const GameState::NoteConfig* config = state.getNoteConfig(key);
+        return config ? nlohmann::json{ { "note_path", config->notePath },
+                                        { "base_path", config->basePath } }.dump()
+                      : std::string();
+    };
+    for (const auto& [key, theirConfig] : theirState.getNoteConfigs())
+    {
+        std::string b = configOf(baseState, key), o = configOf(merged, key), t = configOf(theirState, key);
+        if (o == t || t == b) continue;
+        if (o == b) merged.setNoteConfig(key, theirConfig);
+        else        result.conflicts.push_back({ { "note_configs." + key, b, o }, { "note_configs." + key, b, t } });
+    }
+
+    result.ok   = true;
+    result.json = merged.toJson();
+    return result;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "GameStateComparison.h"
+
+/**
+ * Three-way merge of Game_State.json documents, for combining the progress
+ * two units made since they last synced: base is the state both started
+ * from, ours and theirs the states each reached.
+ *
+ * - Discovery merges as a monotonic OR: a scene discovered on either side
+ *   or in base is discovered in the result, so it never conflicts. It runs
+ *   as a word-wise OR over DiscoveryBits (see GameState::mergeProgress), so
+ *   the cost is linear in the number of tracked scenes. Maps, entries, notes
+ *   and note configs that only one of the three has are kept.
+ * - The scalar fields (GameStateComparison::Diff::scalars from base to each
+ *   side), note configs both sides have, and every key GameState does not
+ *   interpret take the value of the side that changed them. Where both
+ *   sides changed a value differently, ours is kept and a Conflict reports
+ *   both changes; a note config's field is "note_configs.<key>".
+ *
+ * Usage:
+ *   auto result = GameStateMerge::merge(base, ours, theirs);
+ *   if (result.ok) write(result.json); for (auto& c : result.conflicts) ...
+ */
+class GameStateMerge
+{
+public:
+    /** The same field changed on both sides: before is the base value. */
+    struct Conflict
+    {
+        GameStateComparison::ScalarChange ours;
+        GameStateComparison::ScalarChange theirs;
+    };
+
+    struct Result
+    {
+        bool                  ok = false; // false if any document is malformed
+        std::string           json;       // the merged Game_State.json
+        std::vector<Conflict> conflicts;
+    };
+
+    static Result merge(const std::string& base, const std::string& ours, const std::string& theirs);
+};
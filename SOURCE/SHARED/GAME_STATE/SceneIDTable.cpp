@@ -0,0 +1,50 @@
+#include "SceneIDTable.h"
+
+const char* const SceneIDTable::k_Path = "/LOCATIONS/Scene_IDs.txt";
+
+void SceneIDTable::load(const std::string& text)
+{
+    *this = SceneIDTable();
+
+    size_t start = 0;
+    while (start < text.size())
+    {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(start, end - start);
+        start = end + 1;
+
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t before = mPaths.size();
+        intern(line);
+        if (mPaths.size() == before) continue; // repeated line
+
+        uint32_t hash = fnv1a32(line.data(), line.size(), mHashes.back());
+        mHashes.push_back(fnv1a32("", 1, hash)); // path terminator
+    }
+    mStableCount = mPaths.size();
+}
+
+std::string SceneIDTable::toText() const
+{
+    std::string text = "# Scene IDs: line order is the ID. Generated by KSC_SceneCompiler; append only.\n";
+    for (const std::string& path : mPaths)
+        text.append(path).push_back('\n');
+    return text;
+}
+
+uint32_t SceneIDTable::find(const std::string& path) const
+{
+    auto it = mIDs.find(path);
+    return it != mIDs.end() ? it->second : k_None;
+}
+
+uint32_t SceneIDTable::intern(const std::string& path)
+{
+    auto [it, inserted] = mIDs.emplace(path, static_cast<uint32_t>(mPaths.size()));
+    if (inserted)
+        mPaths.push_back(path);
+    return it->second;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../UTIL/Fnv1a.h"
+
+/**
+ * Numbers scene paths so discovery state can be held as bits (see
+ * DiscoveryBits) instead of path-keyed maps.
+ *
+ * The stable IDs come from Scene_IDs.txt, generated from KSC_DATA by
+ * KSC_SceneCompiler: one data-root-relative path per line, the line order
+ * giving the ID. The generator only ever appends, so an ID keeps its
+ * meaning across data updates and can be stored in journals and saves.
+ *
+ * Paths missing from the file (new data, notes) are interned at runtime
+ * after the stable IDs. Those IDs are only valid for this table instance.
+ */
+class SceneIDTable
+{
+public:
+    static const char* const k_Path; // "/LOCATIONS/Scene_IDs.txt"
+    static constexpr uint32_t k_None = UINT32_MAX;
+
+    /**
+     * Replace the table with the given file contents. Blank lines and lines
+     * starting with '#' are skipped. Every ID loaded is stable.
+     */
+    void        load(const std::string& text);
+    std::string toText() const;
+
+    /** The ID of path, or k_None. */
+    uint32_t find(const std::string& path) const;
+
+    /** The ID of path, adding it after the existing IDs if it has none. */
+    uint32_t intern(const std::string& path);
+
+    const std::string& path(uint32_t id) const { return mPaths[id]; }
+    size_t             size()            const { return mPaths.size(); }
+
+    /** True for IDs read from the file rather than interned at runtime. */
+    bool   isStable(uint32_t id) const { return id < mStableCount; }
+    size_t stableSize()          const { return mStableCount; }
+
+    /**
+     * FNV-1a over the first count stable paths (all of them by default).
+     * Data written against a table of that size is valid for this one iff
+     * the hashes match, since the generator only appends.
+     */
+    uint32_t hash(size_t count) const { return mHashes[count]; }
+    uint32_t hash()             const { return mHashes[mStableCount]; }
+
+private:
+    std::vector<std::string>                  mPaths;
+    std::unordered_map<std::string, uint32_t> mIDs;
+    size_t                                    mStableCount = 0;
+    std::vector<uint32_t>                     mHashes      = { k_Fnv1a32Offset }; // [n]: first n paths
+};
@@ -0,0 +1,116 @@
+#include "SlotContainer.h"
+#include "../UTIL/ByteIO.h"
+#include "../UTIL/Fnv1a.h"
+
+static const size_t k_ContainerHeaderBytes = 12;
+
+namespace
+{
+uint32_t containerChecksum(const std::string& bytes, size_t from)
+{
+    return fnv1a32(bytes.data() + from, bytes.size() - from);
+}
+} // namespace
+
+std::string SlotContainer::pack(const std::map<std::string, std::string>& entries)
+{
+    size_t total = k_ContainerHeaderBytes;
+    for (const auto& [name, content] : entries)
+        total += 10 + name.size() + content.size();
+
+    std::string out;
+    ByteWriter  w{ out };
+    out.reserve(total);
+    out.append(k_Magic, sizeof(k_Magic));
+    w.u16(k_Version);
+    w.u16(static_cast<uint16_t>(entries.size()));
+    w.u32(0); // checksum, filled in below
+
+    uint32_t offset = 0;
+    for (const auto& [name, content] : entries)
+    {
+        w.u16(static_cast<uint16_t>(name.size()));
+        out += name;
+        w.u32(offset);
+        w.u32(static_cast<uint32_t>(content.size()));
+        offset += static_cast<uint32_t>(content.size());
+    }
+    for (const auto& [name, content] : entries)
+        out += content;
+
+    std::string checksum;
+    ByteWriter  c{ checksum };
+    c.u32(containerChecksum(out, k_ContainerHeaderBytes));
+    out.replace(8, 4, checksum);
+    return out;
+}
+
+bool SlotContainer::isContainer(std::string_view bytes)
+{
+    return bytes.size() >= sizeof(k_Magic) && bytes.compare(0, sizeof(k_Magic), k_Magic, sizeof(k_Magic)) == 0;
+}
+
+bool SlotContainer::open(std::string bytes)
+{
+    mBytes = std::move(bytes);
+    mEntries.clear();
+    mPayload = 0;
+
+    ByteReader  in{ mBytes };
+    std::string magic    = in.bytes(sizeof(k_Magic));
+    uint16_t    version  = in.u16();
+    uint16_t    count    = in.u16();
+    uint32_t    checksum = in.u32();
+    bool valid = in.ok && isContainer(magic) && version == k_Version
+              && checksum == containerChecksum(mBytes, k_ContainerHeaderBytes);
+
+    for (uint16_t i = 0; valid && i < count; ++i)
+    {
+        Entry entry;
+        entry.name   = in.bytes(in.u16());
+        entry.offset = in.u32();
+        entry.length = in.u32();
+        valid        = in.ok;
+        mEntries.push_back(std::move(entry));
+    }
+
+    mPayload = in.pos;
+    for (const Entry& entry : mEntries)
+        valid = valid && size_t(entry.offset) + entry.length <= mBytes.size() - mPayload;
+
+    if (!valid)
+    {
+        mBytes.clear();
+        mEntries.clear();
+        mPayload = 0;
+    }
+    return valid;
+}
+
+std::vector<std::string> SlotContainer::names() const
+{
+    std::vector<std::string> names;
+    names.reserve(mEntries.size());
+    for (const Entry& entry : mEntries)
+        names.push_back(entry.name);
+    return names;
+}
+
+const SlotContainer::Entry* SlotContainer::find(std::string_view name) const
+{
+    for (const Entry& entry : mEntries)
+        if (entry.name == name) return &entry;
+    return nullptr;
+}
+
+bool SlotContainer::contains(std::string_view name) const
+{
+    return find(name) != nullptr;
+}
+
+std::string_view SlotContainer::get(std::string_view name) const
+{
+    const Entry* entry = find(name);
+    if (!entry) return {};
+    return std::string_view(mBytes).substr(mPayload + entry->offset, entry->length);
+}
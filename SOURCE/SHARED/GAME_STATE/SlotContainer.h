@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * A save slot packed into one file (KSC_SLOT_N.ksc): Game_State.json, the
+ * notes, or a delta, each stored as a named entry. Saving is one sequential
+ * write and restoring one read, instead of an open/write/close per file on
+ * the SD card.
+ *
+ * Layout (all integers little-endian):
+ *
+ *   header    "KSCS"  u16 version  u16 entryCount  u32 checksum
+ *   toc       entryCount x { u16 nameLength, name bytes, u32 offset, u32 length }
+ *   payloads  entry contents back to back, offsets relative to the first one
+ *
+ * The checksum is FNV-1a over everything after the header, so a torn or
+ * truncated file fails to open instead of restoring half a slot.
+ */
+class SlotContainer
+{
+public:
+    static constexpr char     k_Magic[4] = { 'K', 'S', 'C', 'S' };
+    static constexpr uint16_t k_Version  = 1;
+
+    /** Pack named entries, in name order, into container bytes. */
+    static std::string pack(const std::map<std::string, std::string>& entries);
+
+    /** True if bytes start with the container magic; says nothing about validity. */
+    static bool isContainer(std::string_view bytes);
+
+    /**
+     * Take ownership of container bytes and index their entries. Returns
+     * false, leaving the container empty, if the bytes do not validate.
+     */
+    bool open(std::string bytes);
+
+    /** Entry names, in the order they were packed. */
+    std::vector<std::string> names() const;
+
+    bool             contains(std::string_view name) const;
+    std::string_view get(std::string_view name) const; // empty if absent
+
+private:
+    struct Entry
+    {
+        std::string name;
+        uint32_t    offset;
+        uint32_t    length;
+    };
+
+    std::string        mBytes;
+    std::vector<Entry> mEntries;
+    size_t             mPayload = 0; // offset of the first payload in mBytes
+
+    const Entry* find(std::string_view name) const;
+};
@@ -0,0 +1,281 @@
+#include "FramebufferGraphicsRenderer.h"
+#include "PngImage.h"
+#include "../FILE_OPERATOR/FileOperator.h"
+#include "../../../THIRD_PARTY/nanosvg/nanosvg.h"
+#include "../../../THIRD_PARTY/nanosvg/nanosvgrast.h"
+#include <algorithm>
+#include <cstdlib>
+
+// TFT_eSPI font 1 (the classic 5x7 GLCD font), printable ASCII from ' '.
+// Five columns per glyph, least significant bit at the top; the sixth column
+// of the 6x8 cell is blank.
+static const uint8_t k_GlcdFont[95][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, { 0x00, 0x07, 0x00, 0x07, 0x00 },
+    { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 },
+    { 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x08, 0x07, 0x03, 0x00 }, { 0x00, 0x1C, 0x22, 0x41, 0x00 },
+    { 0x00, 0x41, 0x22, 0x1C, 0x00 }, { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A }, { 0x08, 0x08, 0x3E, 0x08, 0x08 },
+    { 0x00, 0x80, 0x70, 0x30, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, { 0x00, 0x00, 0x60, 0x60, 0x00 },
+    { 0x20, 0x10, 0x08, 0x04, 0x02 }, { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+    { 0x72, 0x49, 0x49, 0x49, 0x46 }, { 0x21, 0x41, 0x49, 0x4D, 0x33 }, { 0x18, 0x14, 0x12, 0x7F, 0x10 },
+    { 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x31 }, { 0x41, 0x21, 0x11, 0x09, 0x07 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x46, 0x49, 0x49, 0x29, 0x1E }, { 0x00, 0x00, 0x14, 0x00, 0x00 },
+    { 0x00, 0x40, 0x34, 0x00, 0x00 }, { 0x00, 0x08, 0x14, 0x22, 0x41 }, { 0x14, 0x14, 0x14, 0x14, 0x14 },
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x59, 0x09, 0x06 }, { 0x3E, 0x41, 0x5D, 0x59, 0x4E },
+    { 0x7C, 0x12, 0x11, 0x12, 0x7C }, { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 },
+    { 0x7F, 0x41, 0x41, 0x41, 0x3E }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, { 0x7F, 0x09, 0x09, 0x09, 0x01 },
+    { 0x3E, 0x41, 0x41, 0x51, 0x73 }, { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 },
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, { 0x7F, 0x40, 0x40, 0x40, 0x40 },
+    { 0x7F, 0x02, 0x1C, 0x02, 0x7F }, { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E },
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, { 0x7F, 0x09, 0x19, 0x29, 0x46 },
+    { 0x26, 0x49, 0x49, 0x49, 0x32 }, { 0x03, 0x01, 0x7F, 0x01, 0x03 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F },
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, { 0x63, 0x14, 0x08, 0x14, 0x63 },
+    { 0x03, 0x04, 0x78, 0x04, 0x03 }, { 0x61, 0x59, 0x49, 0x4D, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x41 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x41, 0x7F }, { 0x04, 0x02, 0x01, 0x02, 0x04 },
+    { 0x40, 0x40, 0x40, 0x40, 0x40 }, { 0x00, 0x03, 0x07, 0x08, 0x00 }, { 0x20, 0x54, 0x54, 0x78, 0x40 },
+    { 0x7F, 0x28, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x28 }, { 0x38, 0x44, 0x44, 0x28, 0x7F },
+    { 0x38, 0x54, 0x54, 0x54, 0x18 }, { 0x00, 0x08, 0x7E, 0x09, 0x02 }, { 0x18, 0xA4, 0xA4, 0x9C, 0x78 },
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, { 0x20, 0x40, 0x40, 0x3D, 0x00 },
+    { 0x7F, 0x10, 0x28, 0x44, 0x00 }, { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x78, 0x04, 0x78 },
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, { 0xFC, 0x18, 0x24, 0x24, 0x18 },
+    { 0x18, 0x24, 0x24, 0x18, 0xFC }, { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x24 },
+    { 0x04, 0x04, 0x3F, 0x44, 0x24 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, { 0x1C, 0x20, 0x40, 0x20, 0x1C },
+    { 0x3C, 0x40, 0x30, 0x40, 0x3C }, { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x4C, 0x90, 0x90, 0x90, 0x7C },
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, { 0x00, 0x00, 0x77, 0x00, 0x00 },
+    { 0x00, 0x41, 0x36, 0x08, 0x00 }, { 0x02, 0x01, 0x02, 0x04, 0x02 },
+};
+
+static const int k_GlyphW = 6;
+static const int k_GlyphH = 8;
+
+FramebufferGraphicsRenderer::FramebufferGraphicsRenderer(FileOperator& files)
+: mFiles(files)
+, mPixels(k_Width * k_Height, k_Black)
+{
+}
+
+void FramebufferGraphicsRenderer::clear(uint16_t color)
+{
+    std::fill(mPixels.begin(), mPixels.end(), color);
+}
+
+std::vector<uint8_t> FramebufferGraphicsRenderer::toRGBA() const
+{
+    std::vector<uint8_t> rgba(mPixels.size() * 4);
+    uint8_t* out = rgba.data();
+    for (uint16_t c : mPixels)
+    {
+        uint8_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+        *out++ = static_cast<uint8_t>((r << 3) | (r >> 2));
+        *out++ = static_cast<uint8_t>((g << 2) | (g >> 4));
+        *out++ = static_cast<uint8_t>((b << 3) | (b >> 2));
+        *out++ = 255;
+    }
+    return rgba;
+}
+
+// -----------------------------------------------------------------
+void FramebufferGraphicsRenderer::beginContentArea(int x, int y, int w, int h)
+{
+    mClipX0 = std::max(x, 0);
+    mClipY0 = std::max(y, 0);
+    mClipX1 = std::min(x + w, k_Width);
+    mClipY1 = std::min(y + h, k_Height);
+}
+
+void FramebufferGraphicsRenderer::endContentArea()
+{
+    mClipX0 = 0;
+    mClipY0 = 0;
+    mClipX1 = k_Width;
+    mClipY1 = k_Height;
+}
+
+void FramebufferGraphicsRenderer::plot(int x, int y, uint16_t color)
+{
+    if (x < mClipX0 || x >= mClipX1 || y < mClipY0 || y >= mClipY1) return;
+    mPixels[y * k_Width + x] = color;
+}
+
+void FramebufferGraphicsRenderer::fillRect(int x, int y, int w, int h, uint16_t color)
+{
+    int x0 = std::max(x, mClipX0), x1 = std::min(x + w, mClipX1);
+    int y0 = std::max(y, mClipY0), y1 = std::min(y + h, mClipY1);
+    if (x0 >= x1) return;
+    for (int row = y0; row < y1; ++row)
+        std::fill(mPixels.data() + row * k_Width + x0, mPixels.data() + row * k_Width + x1, color);
+}
+
+void FramebufferGraphicsRenderer::outlineRect(int x, int y, int w, int h, uint16_t color)
+{
+    if (w <= 0 || h <= 0) return;
+    fillRect(x, y, w, 1, color);
+    fillRect(x, y + h - 1, w, 1, color);
+    fillRect(x, y, 1, h, color);
+    fillRect(x + w - 1, y, 1, h, color);
+}
+
+void FramebufferGraphicsRenderer::drawLine(int x0, int y0, int x1, int y1, uint16_t color)
+{
+    // Bresenham, both end points inclusive.
+    int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    for (;;)
+    {
+        plot(x0, y0, color);
+        if (x0 == x1 && y0 == y1) return;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+void FramebufferGraphicsRenderer::drawString(std::string_view text, int x, int y, int size,
+                                             uint16_t fg, uint16_t bg)
+{
+    for (char ch : text)
+    {
+        if (x >= mClipX1) return;
+        fillRect(x, y, k_GlyphW * size, k_GlyphH * size, bg);
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (c >= 0x20 && c < 0x7F)
+        {
+            const uint8_t* glyph = k_GlcdFont[c - 0x20];
+            for (int col = 0; col < 5; ++col)
+                for (int row = 0; row < k_GlyphH; ++row)
+                    if (glyph[col] & (1 << row))
+                        fillRect(x + col * size, y + row * size, size, size, fg);
+        }
+        x += k_GlyphW * size;
+    }
+}
+
+// -----------------------------------------------------------------
+void FramebufferGraphicsRenderer::drawImage(std::string_view path)
+{
+    fillRect(0, 0, k_Width, k_Height, k_Black);
+
+    PngImage image;
+    if (!image.decode(mFiles.load(std::string(path))) || image.width() > k_Width) return;
+
+    const uint8_t* rgba = image.rgba().data();
+    int x1 = std::min(image.width(), mClipX1);
+    int y1 = std::min(image.height(), mClipY1);
+    for (int y = mClipY0; y < y1; ++y)
+    {
+        const uint8_t* src = rgba + (size_t(y) * image.width() + mClipX0) * 4;
+        uint16_t*      dst = &mPixels[y * k_Width];
+        for (int x = mClipX0; x < x1; ++x, src += 4)
+            dst[x] = rgb565(src[0], src[1], src[2]);
+    }
+}
+
+void FramebufferGraphicsRenderer::drawText(std::string_view path, int x, int y)
+{
+    std::string text = mFiles.load(std::string(path));
+    int         curY = y - mScrollOffset;
+
+    std::string_view rest = text;
+    while (!rest.empty() && curY < mClipY1)
+    {
+        size_t           end  = rest.find('\n');
+        std::string_view line = rest.substr(0, end);
+        rest = end == std::string_view::npos ? std::string_view() : rest.substr(end + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        size_t hashes = 0;
+        while (hashes < line.size() && line[hashes] == '#') hashes++;
+        std::string_view display = hashes > 0 ? line.substr(std::min(hashes + 1, line.size())) : line;
+
+        int size = (hashes == 1) ? 3 : (hashes == 2) ? 2 : 1;
+        drawString(display, x, curY, size, hashes > 0 ? k_White : k_LightGrey, k_Black);
+        curY += size * k_GlyphH + 4;
+    }
+}
+
+void FramebufferGraphicsRenderer::drawSVG(std::string_view path, int x, int y, int w, int h)
+{
+    const SvgRaster* raster = rasterizeSvg(std::string(path), w, h);
+    if (!raster) return;
+
+    for (int row = 0; row < raster->height; ++row)
+    {
+        int py = y + row;
+        if (py < mClipY0 || py >= mClipY1) continue;
+        for (int col = 0; col < raster->width; ++col)
+        {
+            int px = x + col;
+            int a  = raster->alpha[row * raster->width + col];
+            if (a == 0 || px < mClipX0 || px >= mClipX1) continue;
+
+            // Blend white over the pixel in 565 space.
+            uint16_t& dst = mPixels[py * k_Width + px];
+            int r = (dst >> 11) & 0x1F, g = (dst >> 5) & 0x3F, b = dst & 0x1F;
+            r += ((0x1F - r) * a + 127) / 255;
+            g += ((0x3F - g) * a + 127) / 255;
+            b += ((0x1F - b) * a + 127) / 255;
+            dst = static_cast<uint16_t>((r << 11) | (g << 5) | b);
+        }
+    }
+}
+
+void FramebufferGraphicsRenderer::drawButton(std::string_view label, int x, int y, int w, int h)
+{
+    fillRect(x, y, w, h, k_Black);
+    outlineRect(x, y, w, h, k_White);
+    int textX = x + (w - (int)label.size() * k_GlyphW) / 2;
+    int textY = y + (h - k_GlyphH) / 2;
+    drawString(label, textX, textY, 1, k_White, k_Black);
+}
+
+void FramebufferGraphicsRenderer::drawRect(int x, int y, int w, int h)
+{
+    outlineRect(x, y, w, h, k_Yellow);
+}
+
+void FramebufferGraphicsRenderer::drawPolygon(const int16_t* xs, const int16_t* ys, int count)
+{
+    if (count < 2) return;
+    for (int i = 0; i < count; i++)
+    {
+        int j = (i + 1) % count;
+        drawLine(xs[i], ys[i], xs[j], ys[j], k_Yellow);
+    }
+}
+
+// -----------------------------------------------------------------
+const FramebufferGraphicsRenderer::SvgRaster*
+FramebufferGraphicsRenderer::rasterizeSvg(const std::string& path, int targetW, int targetH)
+{
+    std::string cacheKey = path + "@" + std::to_string(targetW) + "x" + std::to_string(targetH);
+    auto it = mSvgCache.find(cacheKey);
+    if (it != mSvgCache.end()) return it->second.alpha.empty() ? nullptr : &it->second;
+
+    // A failed load is cached too, so a missing icon costs one read.
+    SvgRaster& raster = mSvgCache[cacheKey];
+
+    std::string buf = mFiles.load(path);
+    if (buf.empty()) return nullptr;
+    NSVGimage* image = nsvgParse(&buf[0], "px", 96.0f);
+    if (!image) return nullptr;
+
+    float svgW = image->width, svgH = image->height;
+    if (svgW <= 0 || svgH <= 0) { nsvgDelete(image); return nullptr; }
+
+    int   rasterW = (targetW > 0) ? targetW : (int)svgW;
+    int   rasterH = (targetH > 0) ? targetH : (int)svgH;
+    float scale   = (targetW > 0) ? (float)rasterW / svgW : 1.0f;
+
+    std::vector<uint8_t> pixels(size_t(rasterW) * rasterH * 4);
+    NSVGrasterizer* rast = nsvgCreateRasterizer();
+    nsvgRasterize(rast, image, 0, 0, scale, pixels.data(), rasterW, rasterH, rasterW * 4);
+    nsvgDeleteRasterizer(rast);
+    nsvgDelete(image);
+
+    raster.width  = rasterW;
+    raster.height = rasterH;
+    raster.alpha.resize(size_t(rasterW) * rasterH);
+    for (size_t i = 0; i < raster.alpha.size(); ++i)
+        raster.alpha[i] = pixels[i * 4 + 3];
+    return &raster;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "GraphicsRenderer.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class FileOperator;
+
+/**
+ * Headless implementation of GraphicsRenderer. Rasterizes into an in-memory
+ * 320x240 RGB565 framebuffer, the ESP32 panel's size and format, so frames can
+ * be compared pixel for pixel against golden images and timed on build
+ * machines with no display. Assets are read through a FileOperator.
+ *
+ * drawImage   — clears to black and blits a PNG (see PngImage) at the origin,
+ *               ignoring alpha. Images wider than 320 are skipped, as PNGdec
+ *               does on the ESP32.
+ * drawText    — markdown in the TFT_eSPI 6x8 font, as on the ESP32: '#' is
+ *               size 3, '##' size 2, body text size 1; headings white, body
+ *               light grey, each line on a black cell background.
+ * drawSVG     — rasterizes through nanosvg as on Raylib: white, alpha
+ *               blended, scaled to w (and h), cached by path and size.
+ * drawButton  — black fill, white outline, centred size-1 label.
+ * drawRect / drawPolygon — one-pixel yellow outlines.
+ *
+ * beginContentArea() clips every primitive to its rectangle until
+ * endContentArea(); the scroll offset moves text up.
+ */
+class FramebufferGraphicsRenderer : public GraphicsRenderer
+{
+public:
+    static constexpr int k_Width  = 320;
+    static constexpr int k_Height = 240;
+
+    explicit FramebufferGraphicsRenderer(FileOperator& files);
+
+    void drawImage(std::string_view path) override;
+    void drawText(std::string_view path, int x, int y) override;
+    void drawSVG(std::string_view path, int x, int y, int w = 0, int h = 0) override;
+    void drawButton(std::string_view label, int x, int y, int w, int h) override;
+    void drawRect(int x, int y, int w, int h) override;
+    void drawPolygon(const int16_t* xs, const int16_t* ys, int count) override;
+    void beginContentArea(int x, int y, int w, int h) override;
+    void endContentArea() override;
+
+    /** Fill the whole frame, ignoring any content area. */
+    void clear(uint16_t color = 0);
+
+    /** Row-major RGB565 pixels, k_Width x k_Height. */
+    const uint16_t* pixels() const { return mPixels.data(); }
+    uint16_t        pixel(int x, int y) const { return mPixels[y * k_Width + x]; }
+
+    /** The frame expanded to 8-bit RGBA (alpha 255), e.g. for PngImage::encode. */
+    std::vector<uint8_t> toRGBA() const;
+
+    static constexpr uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b)
+    {
+        return static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+    }
+
+    // TFT_eSPI colour constants, so frames match the panel.
+    static constexpr uint16_t k_Black     = 0x0000;
+    static constexpr uint16_t k_White     = 0xFFFF;
+    static constexpr uint16_t k_LightGrey = 0xD69A;
+    static constexpr uint16_t k_Yellow    = 0xFFE0;
+
+private:
+    // Alpha coverage of a rasterized SVG, drawn in white.
+    struct SvgRaster
+    {
+        int                  width  = 0;
+        int                  height = 0;
+        std::vector<uint8_t> alpha;
+    };
+
+    FileOperator&         mFiles;
+    std::vector<uint16_t> mPixels;
+    int                   mClipX0 = 0, mClipY0 = 0, mClipX1 = k_Width, mClipY1 = k_Height; // half-open
+    std::unordered_map<std::string, SvgRaster> mSvgCache;
+
+    void plot(int x, int y, uint16_t color);
+    void fillRect(int x, int y, int w, int h, uint16_t color);
+    void outlineRect(int x, int y, int w, int h, uint16_t color);
+    void drawLine(int x0, int y0, int x1, int y1, uint16_t color);
+    void drawString(std::string_view text, int x, int y, int size, uint16_t fg, uint16_t bg);
+    const SvgRaster* rasterizeSvg(const std::string& path, int w, int h);
+};
@@ -3,8 +3,9 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <string>
-#include <utility>
+#include <string_view>
 #include <vector>
 
 /**
@@ -19,7 +20,7 @@ public:
 
     void setScrollOffset(int offset) { mScrollOffset = offset; }
 
-    virtual void beginContentArea(int x, int y, int w, int h) {}
+    virtual void beginContentArea(int /*x*/, int /*y*/, int /*w*/, int /*h*/) {}
     virtual void endContentArea() {}
 
 protected:
@@ -29,35 +30,56 @@ public:
     /**
      * Load and render an image asset from the given data-root-relative path.
      */
-    virtual void drawImage(const std::string& path) = 0;
+    virtual void drawImage(std::string_view path) = 0;
+
+    /**
+     * Render a hi-res scene image, showing its 320x240 counterpart at
+     * loresPath until the hi-res one is ready, on platforms that load images
+     * asynchronously. Both fill the same 320x240 game space, so zones line up
+     * with either. Default draws path directly.
+     */
+    virtual void drawProgressiveImage(std::string_view path, std::string_view /*loresPath*/)
+    {
+        drawImage(path);
+    }
 
     /**
      * Load and render a text/markdown asset from the given data-root-relative path
      * at the given screen coordinates.
      */
-    virtual void drawText(const std::string& path, int x, int y) = 0;
+    virtual void drawText(std::string_view path, int x, int y) = 0;
 
     /**
      * Load and render an SVG asset from the given path at the given
      * screen coordinates.
      */
-    virtual void drawSVG(const std::string& path, int x, int y, int w = 0, int h = 0) = 0;
+    virtual void drawSVG(std::string_view path, int x, int y, int w = 0, int h = 0) = 0;
 
     /**
      * Draw a labeled button rectangle at the given screen coordinates.
      * Used for programmatically rendered menus (no image assets).
+     * label points into the scene's string table and is not NUL-terminated.
      */
-    virtual void drawButton(const std::string& label, int x, int y, int w, int h) = 0;
+    virtual void drawButton(std::string_view label, int x, int y, int w, int h) = 0;
 
     /**
      * Draw a rectangle outline at the given game-space coordinates.
      * Used by the zone display debug overlay. Default is a no-op.
      */
-    virtual void drawRect(int x, int y, int w, int h) {}
+    virtual void drawRect(int /*x*/, int /*y*/, int /*w*/, int /*h*/) {}
 
     /**
-     * Draw a closed polygon outline through the given game-space points.
+     * Draw a closed polygon outline through the given game-space points,
+     * passed as planar coordinate arrays (xs[i], ys[i]) of length count.
      * Used by the zone display debug overlay. Default is a no-op.
      */
-    virtual void drawPolygon(const std::vector<std::pair<int, int>>& points) {}
+    virtual void drawPolygon(const int16_t* /*xs*/, const int16_t* /*ys*/, int /*count*/) {}
+
+    /**
+     * Keep the images at these data-root-relative paths resident, replacing
+     * the previous set, on platforms that cache them. GameRunner passes the
+     * active scene's image with its parent's and children's, so navigating
+     * between them never reloads. Default is a no-op.
+     */
+    virtual void pinImages(const std::vector<std::string>& /*paths*/) {}
 };
@@ -0,0 +1,210 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "../UTIL/KSC_Threads.h"
+
+/**
+ * Decodes image files into CPU-side images on a pool of worker threads, so
+ * the render thread only does the GPU upload. Image is the platform's
+ * decoded image type (Raylib's Image on desktop).
+ *
+ * request() queues a path; urgent requests (the image the player is waiting
+ * for) jump ahead of speculative ones (neighbouring scenes). A path is
+ * decoded once until its result is taken: repeated requests while it is
+ * queued, decoding or waiting only raise its priority. drain() hands
+ * finished images to the render thread, a few per call so one frame never
+ * uploads a whole backlog.
+ *
+ * The decoder runs on the workers, so it must only read storage. With no
+ * workers (threads == 0, or single-threaded builds) runIdleSlice() decodes
+ * one request on the calling thread instead. Images decoded but never
+ * drained are passed to release() at destruction.
+ */
+template <typename Image>
+class ImageDecodeQueue
+{
+public:
+    using Decoder = std::function<bool(const std::string& path, Image& image)>;
+    using Release = std::function<void(Image&)>;
+
+    struct Stats
+    {
+        size_t requested = 0; // paths queued for decode
+        size_t decoded   = 0; // images handed to drain()
+        size_t failed    = 0; // paths the decoder could not read
+    };
+
+    ImageDecodeQueue(Decoder decode, Release release, unsigned threads)
+    : mDecode(std::move(decode))
+    , mRelease(std::move(release))
+    {
+#if KSC_HAS_THREADS
+        for (unsigned i = 0; i < threads; ++i)
+            mWorkers.emplace_back(&ImageDecodeQueue::workerLoop, this);
+#else
+        (void)threads;
+#endif
+    }
+
+    ~ImageDecodeQueue()
+    {
+#if KSC_HAS_THREADS
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mWake.notify_all();
+        for (auto& worker : mWorkers)
+            worker.join();
+#endif
+        for (Result& result : mDone)
+            if (result.ok && mRelease) mRelease(result.image);
+    }
+
+    ImageDecodeQueue(const ImageDecodeQueue&)            = delete;
+    ImageDecodeQueue& operator=(const ImageDecodeQueue&) = delete;
+
+    /** Queue path for decode, or raise its priority if it is already queued. */
+    void request(const std::string& path, bool urgent)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mInFlight.count(path))
+            {
+                if (!urgent) return;
+                for (auto it = mPending.begin(); it != mPending.end(); ++it)
+                    if (*it == path)
+                    {
+                        mPending.erase(it);
+                        mPending.push_front(path);
+                        break;
+                    }
+                return;
+            }
+            mInFlight.insert(path);
+            if (urgent) mPending.push_front(path);
+            else        mPending.push_back(path);
+            mStats.requested++;
+        }
+        mWake.notify_one();
+    }
+
+    /** Drop speculative work: every queued path not in keep. Decodes already running finish. */
+    void retainOnly(const std::vector<std::string>& keep)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (auto it = mPending.begin(); it != mPending.end();)
+        {
+            if (std::find(keep.begin(), keep.end(), *it) != keep.end()) { ++it; continue; }
+            mInFlight.erase(*it);
+            it = mPending.erase(it);
+        }
+    }
+
+    /** True from request() until the result is drained. */
+    bool isRequested(const std::string& path) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mInFlight.count(path) != 0;
+    }
+
+    /** Decode one queued path on the calling thread. Returns false if none is queued. */
+    bool runIdleSlice()
+    {
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (mPending.empty()) return false;
+            path = std::move(mPending.front());
+            mPending.pop_front();
+        }
+        decodeAndPush(std::move(path));
+        return true;
+    }
+
+    /**
+     * Hand up to max finished results to onResult(path, image, ok), oldest
+     * first, on the calling thread. The callee owns image when ok is true.
+     * Returns how many were handed over.
+     */
+    template <typename Fn>
+    size_t drain(size_t max, Fn&& onResult)
+    {
+        std::deque<Result> done;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            while (!mDone.empty() && done.size() < max)
+            {
+                done.push_back(std::move(mDone.front()));
+                mDone.pop_front();
+                mInFlight.erase(done.back().path);
+                (done.back().ok ? mStats.decoded : mStats.failed)++;
+            }
+        }
+        for (Result& result : done)
+            onResult(result.path, result.image, result.ok);
+        return done.size();
+    }
+
+    Stats getStats() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+private:
+    struct Result
+    {
+        std::string path;
+        Image       image{};
+        bool        ok = false;
+    };
+
+    Decoder mDecode;
+    Release mRelease;
+
+    // Shared with the workers; guarded by mMutex.
+    mutable std::mutex              mMutex;
+    std::condition_variable         mWake;
+    std::deque<std::string>         mPending;
+    std::deque<Result>              mDone;
+    std::unordered_set<std::string> mInFlight; // queued, decoding or undrained
+    Stats                           mStats;
+    bool                            mStopping = false;
+#if KSC_HAS_THREADS
+    std::vector<std::thread>        mWorkers;
+#endif
+
+    void decodeAndPush(std::string path)
+    {
+        Result result;
+        result.path = std::move(path);
+        result.ok   = mDecode(result.path, result.image);
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDone.push_back(std::move(result));
+    }
+
+    void workerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true)
+        {
+            mWake.wait(lock, [this] { return mStopping || !mPending.empty(); });
+            if (mStopping) return;
+
+            std::string path = std::move(mPending.front());
+            mPending.pop_front();
+
+            lock.unlock();
+            decodeAndPush(std::move(path));
+            lock.lock();
+        }
+    }
+};
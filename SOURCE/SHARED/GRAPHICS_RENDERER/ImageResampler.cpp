@@ -0,0 +1,139 @@
+#include "ImageResampler.h"
+#include <algorithm>
+#include <vector>
+
+#if defined(__AVX2__)
+  #define KSC_IMAGE_RESAMPLER_AVX2 1
+  #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+  #define KSC_IMAGE_RESAMPLER_SSE2 1
+  #include <emmintrin.h>
+#endif
+
+namespace
+{
+bool validSizes(int srcW, int srcH, int dstW, int dstH)
+{
+    return srcW > 0 && srcH > 0 && dstW > 0 && dstH > 0 &&
+           dstW <= srcW && dstH <= srcH &&
+           (int64_t)dstW * ImageResampler::k_MaxFactor >= srcW &&
+           (int64_t)dstH * ImageResampler::k_MaxFactor >= srcH;
+}
+
+// acc[i] += row[i] for n channels.
+void accumulateRowScalar(uint32_t* acc, const uint8_t* row, int n)
+{
+    for (int i = 0; i < n; ++i)
+        acc[i] += row[i];
+}
+
+// Per-channel sums of accumulated pixels [x0, x1).
+void sumBlockScalar(const uint32_t* acc, int x0, int x1, uint32_t sum[4])
+{
+    sum[0] = sum[1] = sum[2] = sum[3] = 0;
+    for (int x = x0; x < x1; ++x)
+        for (int c = 0; c < 4; ++c)
+            sum[c] += acc[x * 4 + c];
+}
+
+#if KSC_IMAGE_RESAMPLER_AVX2 || KSC_IMAGE_RESAMPLER_SSE2
+void accumulateRowSimd(uint32_t* acc, const uint8_t* row, int n)
+{
+    int i = 0;
+#if KSC_IMAGE_RESAMPLER_AVX2
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256i lo = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + i)));
+        __m256i hi = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + i + 8)));
+        __m256i* a = reinterpret_cast<__m256i*>(acc + i);
+        _mm256_storeu_si256(a + 0, _mm256_add_epi32(_mm256_loadu_si256(a + 0), lo));
+        _mm256_storeu_si256(a + 1, _mm256_add_epi32(_mm256_loadu_si256(a + 1), hi));
+    }
+#else
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16)
+    {
+        // Widen 16 bytes to four vectors of 32-bit lanes.
+        __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i* a = reinterpret_cast<__m128i*>(acc + i);
+        _mm_storeu_si128(a + 0, _mm_add_epi32(_mm_loadu_si128(a + 0), _mm_unpacklo_epi16(lo, zero)));
+        _mm_storeu_si128(a + 1, _mm_add_epi32(_mm_loadu_si128(a + 1), _mm_unpackhi_epi16(lo, zero)));
+        _mm_storeu_si128(a + 2, _mm_add_epi32(_mm_loadu_si128(a + 2), _mm_unpacklo_epi16(hi, zero)));
+        _mm_storeu_si128(a + 3, _mm_add_epi32(_mm_loadu_si128(a + 3), _mm_unpackhi_epi16(hi, zero)));
+    }
+#endif
+    accumulateRowScalar(acc + i, row + i, n - i);
+}
+
+// One RGBA pixel is one vector of four 32-bit lanes.
+void sumBlockSimd(const uint32_t* acc, int x0, int x1, uint32_t sum[4])
+{
+    __m128i s = _mm_setzero_si128();
+    for (int x = x0; x < x1; ++x)
+        s = _mm_add_epi32(s, _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + x * 4)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(sum), s);
+}
+#endif
+
+// Sum each block's rows into acc, then its columns, then divide once with
+// rounding. With block sides of at most k_MaxFactor the sums fit in 32 bits.
+template <typename Accumulate, typename SumBlock>
+void resample(const uint8_t* src, int srcW, int srcH, uint8_t* dst, int dstW, int dstH,
+              Accumulate accumulate, SumBlock sumBlock)
+{
+    std::vector<uint32_t> acc((size_t)srcW * 4);
+    std::vector<int>      xStart(dstW + 1);
+    for (int x = 0; x <= dstW; ++x)
+        xStart[x] = (int)((int64_t)x * srcW / dstW);
+
+    for (int y = 0; y < dstH; ++y)
+    {
+        int y0 = (int)((int64_t)y * srcH / dstH);
+        int y1 = (int)((int64_t)(y + 1) * srcH / dstH);
+        std::fill(acc.begin(), acc.end(), 0u);
+        for (int sy = y0; sy < y1; ++sy)
+            accumulate(acc.data(), src + (size_t)sy * srcW * 4, srcW * 4);
+
+        uint8_t* out = dst + (size_t)y * dstW * 4;
+        for (int x = 0; x < dstW; ++x)
+        {
+            uint32_t sum[4];
+            sumBlock(acc.data(), xStart[x], xStart[x + 1], sum);
+            uint32_t n = (uint32_t)(xStart[x + 1] - xStart[x]) * (uint32_t)(y1 - y0);
+            for (int c = 0; c < 4; ++c)
+                out[x * 4 + c] = (uint8_t)((sum[c] + n / 2) / n);
+        }
+    }
+}
+} // namespace
+
+const char* ImageResampler::backendName()
+{
+#if KSC_IMAGE_RESAMPLER_AVX2
+    return "AVX2";
+#elif KSC_IMAGE_RESAMPLER_SSE2
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+bool ImageResampler::downsampleScalar(const uint8_t* src, int srcW, int srcH, uint8_t* dst, int dstW, int dstH)
+{
+    if (!validSizes(srcW, srcH, dstW, dstH)) return false;
+    resample(src, srcW, srcH, dst, dstW, dstH, accumulateRowScalar, sumBlockScalar);
+    return true;
+}
+
+bool ImageResampler::downsample(const uint8_t* src, int srcW, int srcH, uint8_t* dst, int dstW, int dstH)
+{
+    if (!validSizes(srcW, srcH, dstW, dstH)) return false;
+#if KSC_IMAGE_RESAMPLER_AVX2 || KSC_IMAGE_RESAMPLER_SSE2
+    resample(src, srcW, srcH, dst, dstW, dstH, accumulateRowSimd, sumBlockSimd);
+#else
+    resample(src, srcW, srcH, dst, dstW, dstH, accumulateRowScalar, sumBlockScalar);
+#endif
+    return true;
+}
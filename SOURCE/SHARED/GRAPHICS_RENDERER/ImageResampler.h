@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Box-filter downsampling of RGBA8 images, for shrinking hi-res scene images
+ * to the size they are drawn at before they are uploaded.
+ *
+ * Output pixel (x, y) is the rounded mean of the source block
+ * [x * srcW / dstW, (x + 1) * srcW / dstW) by the same in y. Blocks are whole
+ * source pixels, so every source pixel lands in exactly one output pixel.
+ * Channels are averaged independently (straight alpha); scene images are
+ * opaque.
+ *
+ * The backend is chosen at compile time, as in PolygonKernel:
+ *   AVX2   - 16 channels per step (desktop builds with KSC_ENABLE_AVX2)
+ *   SSE2   - 16 channels per step (any x86-64 desktop build)
+ *   Scalar - one channel per step (other targets)
+ * Every backend sums in 32-bit integers and divides the same way, so all
+ * backends agree bit for bit.
+ */
+class ImageResampler
+{
+public:
+    /** Largest reduction per axis; keeps the block sums within 32 bits. */
+    static constexpr int k_MaxFactor = 256;
+
+    /** Name of the compiled-in backend: "AVX2", "SSE2" or "Scalar". */
+    static const char* backendName();
+
+    /**
+     * Downsample the srcW x srcH image at src into the dstW x dstH buffer at
+     * dst, both tightly packed RGBA8. Returns false, leaving dst untouched,
+     * if a size is not positive, dst is larger than src on either axis, or
+     * the reduction exceeds k_MaxFactor.
+     */
+    static bool downsample(const uint8_t* src, int srcW, int srcH, uint8_t* dst, int dstW, int dstH);
+
+    /** Reference one-channel-at-a-time version of downsample(). */
+    static bool downsampleScalar(const uint8_t* src, int srcW, int srcH, uint8_t* dst, int dstW, int dstH);
+};
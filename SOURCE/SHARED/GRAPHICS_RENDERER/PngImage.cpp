@@ -0,0 +1,466 @@
+#include "PngImage.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+
+static const uint8_t k_PngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+static const int     k_MaxPngSide      = 8192;
+
+namespace
+{
+uint32_t pngCrc(const uint8_t* data, size_t size, uint32_t crc = 0)
+{
+    static const std::array<uint32_t, 256> table = []
+    {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+uint32_t readBE32(const uint8_t* p)
+{
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+// Canonical Huffman code as counts per length and symbols in code order.
+struct HuffmanCode
+{
+    uint16_t counts[16];
+    uint16_t symbols[288];
+
+    // False if the lengths over-subscribe the code. Incomplete codes are
+    // allowed; a code that is never completed fails when it is read.
+    bool build(const uint8_t* lengths, int n)
+    {
+        std::memset(counts, 0, sizeof(counts));
+        for (int s = 0; s < n; ++s) counts[lengths[s]]++;
+        int left = 1;
+        for (int len = 1; len < 16; ++len)
+        {
+            left = (left << 1) - counts[len];
+            if (left < 0) return false;
+        }
+        uint16_t offsets[16] = {};
+        for (int len = 1; len < 15; ++len)
+            offsets[len + 1] = offsets[len] + counts[len];
+        for (int s = 0; s < n; ++s)
+            if (lengths[s]) symbols[offsets[lengths[s]]++] = static_cast<uint16_t>(s);
+        return true;
+    }
+};
+
+// RFC 1951 inflate over a zlib stream. Any malformed input, or output past
+// limit, latches ok = false.
+struct Inflater
+{
+    const uint8_t*        in;
+    size_t                size;
+    size_t                limit;
+    std::vector<uint8_t>& out;
+    size_t                pos      = 0;
+    uint32_t              bitBuf   = 0;
+    int                   bitCount = 0;
+    bool                  ok       = true;
+
+    int bits(int n)
+    {
+        while (bitCount < n)
+        {
+            if (pos >= size) { ok = false; return 0; }
+            bitBuf |= uint32_t(in[pos++]) << bitCount;
+            bitCount += 8;
+        }
+        int value = static_cast<int>(bitBuf & ((1u << n) - 1));
+        bitBuf >>= n;
+        bitCount -= n;
+        return value;
+    }
+
+    int decode(const HuffmanCode& code)
+    {
+        int bitsSoFar = 0, first = 0, index = 0;
+        for (int len = 1; len < 16 && ok; ++len)
+        {
+            bitsSoFar |= bits(1);
+            int count = code.counts[len];
+            if (bitsSoFar - count < first) return code.symbols[index + (bitsSoFar - first)];
+            index += count;
+            first  = (first + count) << 1;
+            bitsSoFar <<= 1;
+        }
+        ok = false;
+        return 0;
+    }
+
+    void stored()
+    {
+        bitBuf = 0;
+        bitCount = 0;
+        if (pos + 4 > size) { ok = false; return; }
+        unsigned len  = in[pos] | (in[pos + 1] << 8);
+        unsigned nlen = in[pos + 2] | (in[pos + 3] << 8);
+        pos += 4;
+        if (len != (~nlen & 0xFFFF) || pos + len > size || out.size() + len > limit) { ok = false; return; }
+        out.insert(out.end(), in + pos, in + pos + len);
+        pos += len;
+    }
+
+    void codes(const HuffmanCode& lengthCode, const HuffmanCode& distCode)
+    {
+        static const uint16_t lengthBase[29]  = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                                  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const uint8_t  lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                                  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+        static const uint16_t distBase[30]    = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                                  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                                  8193, 12289, 16385, 24577 };
+        static const uint8_t  distExtra[30]   = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                                  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+        while (ok)
+        {
+            int symbol = decode(lengthCode);
+            if (!ok || symbol == 256) return;
+            if (symbol < 256)
+            {
+                if (out.size() >= limit) { ok = false; return; }
+                out.push_back(static_cast<uint8_t>(symbol));
+                continue;
+            }
+            symbol -= 257;
+            if (symbol >= 29) { ok = false; return; }
+            size_t length = lengthBase[symbol] + bits(lengthExtra[symbol]);
+            int    dist   = decode(distCode);
+            if (!ok || dist >= 30) { ok = false; return; }
+            size_t back = distBase[dist] + bits(distExtra[dist]);
+            if (!ok || back > out.size() || out.size() + length > limit) { ok = false; return; }
+            size_t from = out.size() - back;
+            for (size_t i = 0; i < length; ++i)
+                out.push_back(out[from + i]);
+        }
+    }
+
+    void fixed()
+    {
+        // Built once; function-local statics so concurrent decoders are safe.
+        static const HuffmanCode lengthCode = []
+        {
+            uint8_t lengths[288];
+            int s = 0;
+            for (; s < 144; ++s) lengths[s] = 8;
+            for (; s < 256; ++s) lengths[s] = 9;
+            for (; s < 280; ++s) lengths[s] = 7;
+            for (; s < 288; ++s) lengths[s] = 8;
+            HuffmanCode code;
+            code.build(lengths, 288);
+            return code;
+        }();
+        static const HuffmanCode distCode = []
+        {
+            uint8_t lengths[30];
+            std::memset(lengths, 5, sizeof(lengths));
+            HuffmanCode code;
+            code.build(lengths, 30);
+            return code;
+        }();
+        codes(lengthCode, distCode);
+    }
+
+    void dynamic()
+    {
+        static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+        int lengthCount = bits(5) + 257;
+        int distCount   = bits(5) + 1;
+        int codeCount   = bits(4) + 4;
+        if (!ok || lengthCount > 286 || distCount > 30) { ok = false; return; }
+
+        uint8_t lengths[320] = {};
+        for (int i = 0; i < codeCount; ++i)
+            lengths[order[i]] = static_cast<uint8_t>(bits(3));
+        HuffmanCode lengthsCode;
+        if (!ok || !lengthsCode.build(lengths, 19)) { ok = false; return; }
+
+        int index = 0;
+        while (ok && index < lengthCount + distCount)
+        {
+            int symbol = decode(lengthsCode);
+            if (symbol < 16) { lengths[index++] = static_cast<uint8_t>(symbol); continue; }
+            uint8_t value = 0;
+            int     repeat;
+            if (symbol == 16)
+            {
+                if (index == 0) { ok = false; return; }
+                value  = lengths[index - 1];
+                repeat = 3 + bits(2);
+            }
+            else if (symbol == 17) repeat = 3 + bits(3);
+            else                   repeat = 11 + bits(7);
+            if (index + repeat > lengthCount + distCount) { ok = false; return; }
+            while (repeat--) lengths[index++] = value;
+        }
+        if (!ok || lengths[256] == 0) { ok = false; return; }
+
+        HuffmanCode lengthCode, distCode;
+        if (!lengthCode.build(lengths, lengthCount) || !distCode.build(lengths + lengthCount, distCount))
+        {
+            ok = false;
+            return;
+        }
+        codes(lengthCode, distCode);
+    }
+
+    bool run()
+    {
+        // zlib header: deflate, no preset dictionary, valid check bits.
+        if (size < 2 || (in[0] & 0x0F) != 8 || (in[1] & 0x20) || ((in[0] << 8) | in[1]) % 31) return false;
+        pos = 2;
+        bool last = false;
+        while (ok && !last)
+        {
+            last = bits(1);
+            switch (bits(2))
+            {
+                case 0:  stored();  break;
+                case 1:  fixed();   break;
+                case 2:  dynamic(); break;
+                default: ok = false;
+            }
+        }
+        return ok;
+    }
+};
+
+uint8_t paeth(int a, int b, int c)
+{
+    int p = a + b - c, pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) return static_cast<uint8_t>(a);
+    return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+void appendBE32(std::string& out, uint32_t v)
+{
+    out.push_back(static_cast<char>(v >> 24));
+    out.push_back(static_cast<char>(v >> 16));
+    out.push_back(static_cast<char>(v >> 8));
+    out.push_back(static_cast<char>(v));
+}
+
+void appendChunk(std::string& out, const char* type, const std::string& data)
+{
+    appendBE32(out, static_cast<uint32_t>(data.size()));
+    size_t typeAt = out.size();
+    out.append(type, 4);
+    out += data;
+    appendBE32(out, pngCrc(reinterpret_cast<const uint8_t*>(out.data()) + typeAt, data.size() + 4));
+}
+} // namespace
+
+bool PngImage::decode(std::string_view bytes)
+{
+    mWidth = mHeight = 0;
+    mRGBA.clear();
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    if (bytes.size() < 8 || std::memcmp(data, k_PngSignature, 8) != 0) return false;
+
+    int                  width = 0, height = 0, depth = 0, colorType = -1;
+    std::vector<uint8_t> idat;
+    uint8_t              palette[256][4] = {};
+    int                  paletteSize = 0;
+    bool                 ended = false;
+
+    for (size_t pos = 8; !ended;)
+    {
+        if (pos + 12 > bytes.size()) return false;
+        uint32_t length = readBE32(data + pos);
+        if (length > bytes.size() - pos - 12) return false;
+        const uint8_t* type  = data + pos + 4;
+        const uint8_t* chunk = type + 4;
+        if (pngCrc(type, length + 4) != readBE32(chunk + length)) return false;
+        pos += 12 + length;
+
+        if (std::memcmp(type, "IHDR", 4) == 0)
+        {
+            if (length != 13) return false;
+            width = static_cast<int>(readBE32(chunk));
+            height = static_cast<int>(readBE32(chunk + 4));
+            depth = chunk[8];
+            colorType = chunk[9];
+            if (chunk[10] != 0 || chunk[11] != 0 || chunk[12] != 0) return false; // interlaced
+            if (width <= 0 || height <= 0 || width > k_MaxPngSide || height > k_MaxPngSide) return false;
+        }
+        else if (std::memcmp(type, "PLTE", 4) == 0)
+        {
+            paletteSize = static_cast<int>(length / 3);
+            if (paletteSize > 256) return false;
+            for (int i = 0; i < paletteSize; ++i)
+            {
+                std::memcpy(palette[i], chunk + i * 3, 3);
+                palette[i][3] = 255;
+            }
+        }
+        else if (std::memcmp(type, "tRNS", 4) == 0 && colorType == 3)
+        {
+            for (uint32_t i = 0; i < length && i < 256; ++i)
+                palette[i][3] = chunk[i];
+        }
+        else if (std::memcmp(type, "IDAT", 4) == 0)
+            idat.insert(idat.end(), chunk, chunk + length);
+        else if (std::memcmp(type, "IEND", 4) == 0)
+            ended = true;
+    }
+
+    int channels;
+    switch (colorType)
+    {
+        case 0:  channels = 1; break;
+        case 2:  channels = 3; break;
+        case 3:  channels = 1; break;
+        case 4:  channels = 2; break;
+        case 6:  channels = 4; break;
+        default: return false;
+    }
+    bool depthOk = (depth == 8) || (depth == 16 && colorType != 3)
+                || ((depth == 1 || depth == 2 || depth == 4) && (colorType == 0 || colorType == 3));
+    if (!depthOk || (colorType == 3 && paletteSize == 0)) return false;
+
+    const size_t stride = (size_t(width) * channels * depth + 7) / 8;
+    const size_t bpp    = std::max<size_t>(1, size_t(channels) * depth / 8);
+    const size_t raw    = (stride + 1) * height;
+
+    std::vector<uint8_t> scan;
+    scan.reserve(raw);
+    Inflater inflater{ idat.data(), idat.size(), raw, scan };
+    if (!inflater.run() || scan.size() != raw) return false;
+
+    // Undo the per-row filters in place; row r's bytes start at r * (stride + 1) + 1.
+    for (int y = 0; y < height; ++y)
+    {
+        uint8_t*       row   = scan.data() + y * (stride + 1);
+        uint8_t        kind  = row[0];
+        uint8_t*       cur   = row + 1;
+        const uint8_t* prior = y > 0 ? cur - (stride + 1) : nullptr;
+        for (size_t i = 0; i < stride; ++i)
+        {
+            int a = i >= bpp ? cur[i - bpp] : 0;
+            int b = prior ? prior[i] : 0;
+            int c = (prior && i >= bpp) ? prior[i - bpp] : 0;
+            switch (kind)
+            {
+                case 0:  break;
+                case 1:  cur[i] += a; break;
+                case 2:  cur[i] += b; break;
+                case 3:  cur[i] += (a + b) / 2; break;
+                case 4:  cur[i] += paeth(a, b, c); break;
+                default: return false;
+            }
+        }
+    }
+
+    mRGBA.resize(size_t(width) * height * 4);
+    const int maxSample = (1 << std::min(depth, 8)) - 1;
+    for (int y = 0; y < height; ++y)
+    {
+        const uint8_t* row = scan.data() + y * (stride + 1) + 1;
+        uint8_t*       px  = mRGBA.data() + size_t(y) * width * 4;
+        for (int x = 0; x < width; ++x, px += 4)
+        {
+            // Sample c of pixel x, reduced to 8 bits (16-bit keeps its high byte).
+            auto sample = [&](int c) -> int
+            {
+                if (depth >= 8) return row[(size_t(x) * channels + c) * (depth / 8)];
+                size_t bit = size_t(x) * depth;
+                return (row[bit / 8] >> (8 - depth - bit % 8)) & maxSample;
+            };
+            switch (colorType)
+            {
+                case 0:
+                    px[0] = px[1] = px[2] = static_cast<uint8_t>(sample(0) * 255 / maxSample);
+                    px[3] = 255;
+                    break;
+                case 2:
+                    px[0] = static_cast<uint8_t>(sample(0));
+                    px[1] = static_cast<uint8_t>(sample(1));
+                    px[2] = static_cast<uint8_t>(sample(2));
+                    px[3] = 255;
+                    break;
+                case 3:
+                {
+                    int index = sample(0);
+                    if (index >= paletteSize) { mRGBA.clear(); return false; }
+                    std::memcpy(px, palette[index], 4);
+                    break;
+                }
+                case 4:
+                    px[0] = px[1] = px[2] = static_cast<uint8_t>(sample(0));
+                    px[3] = static_cast<uint8_t>(sample(1));
+                    break;
+                case 6:
+                    for (int c = 0; c < 4; ++c) px[c] = static_cast<uint8_t>(sample(c));
+                    break;
+            }
+        }
+    }
+
+    mWidth  = width;
+    mHeight = height;
+    return true;
+}
+
+std::string PngImage::encode(const uint8_t* rgba, int width, int height)
+{
+    const size_t stride = size_t(width) * 4;
+
+    std::string header;
+    appendBE32(header, static_cast<uint32_t>(width));
+    appendBE32(header, static_cast<uint32_t>(height));
+    header += std::string("\x08\x06\x00\x00\x00", 5); // 8-bit RGBA, not interlaced
+
+    // Filter byte 0 per row, then the row.
+    std::string scan;
+    scan.reserve((stride + 1) * height);
+    for (int y = 0; y < height; ++y)
+    {
+        scan.push_back('\0');
+        scan.append(reinterpret_cast<const char*>(rgba) + y * stride, stride);
+    }
+
+    std::string zlib("\x78\x01", 2);
+    for (size_t pos = 0; pos < scan.size() || pos == 0;)
+    {
+        size_t len = std::min<size_t>(scan.size() - pos, 65535);
+        bool   last = pos + len == scan.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<char>(len & 0xFF));
+        zlib.push_back(static_cast<char>(len >> 8));
+        zlib.push_back(static_cast<char>(~len & 0xFF));
+        zlib.push_back(static_cast<char>((~len >> 8) & 0xFF));
+        zlib.append(scan, pos, len);
+        pos += len;
+        if (last) break;
+    }
+    uint32_t a = 1, b = 0;
+    for (unsigned char c : scan)
+    {
+        a = (a + c) % 65521;
+        b = (b + a) % 65521;
+    }
+    appendBE32(zlib, (b << 16) | a);
+
+    std::string png(reinterpret_cast<const char*>(k_PngSignature), 8);
+    appendChunk(png, "IHDR", header);
+    appendChunk(png, "IDAT", zlib);
+    appendChunk(png, "IEND", "");
+    return png;
+}
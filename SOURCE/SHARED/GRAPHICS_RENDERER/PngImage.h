@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Minimal PNG codec for host-side rendering, with no zlib dependency.
+ *
+ * decode() reads non-interlaced greyscale, RGB, palette, grey+alpha and RGBA
+ * images at any bit depth (16-bit samples keep their high byte), inflating
+ * the IDAT stream itself and checking every chunk CRC. Pixels come out as
+ * 8-bit RGBA, row-major. Palette transparency (tRNS) is honoured.
+ *
+ * encode() writes 8-bit RGBA with deflate "stored" blocks: larger than a real
+ * encoder's output, but byte-for-byte reproducible, which is what golden
+ * frames need.
+ */
+class PngImage
+{
+public:
+    /** Decode PNG bytes. Returns false, leaving the image empty, on any error. */
+    bool decode(std::string_view bytes);
+
+    /** Encode width x height RGBA pixels as PNG bytes. */
+    static std::string encode(const uint8_t* rgba, int width, int height);
+
+    int                         width()  const { return mWidth; }
+    int                         height() const { return mHeight; }
+    const std::vector<uint8_t>& rgba()   const { return mRGBA; }
+
+private:
+    int                  mWidth  = 0;
+    int                  mHeight = 0;
+    std::vector<uint8_t> mRGBA;
+};
@@ -0,0 +1,168 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Bounded LRU cache of decoded images, keyed by path, for platforms that
+ * upload them to the GPU (the Raylib renderer). Texture is the platform's
+ * handle; release() is called exactly once for every texture that leaves the
+ * cache, by eviction, replacement, invalidate(), clear() or destruction.
+ *
+ * Size is what the caller reports on insert(), so the budget is a VRAM byte
+ * budget. Inserting past it evicts least-recently-used entries, except:
+ *  - pinned paths (see setPinned), which stay however old they are;
+ *  - the most recently used entry, which is the one on screen.
+ * Either may leave the cache over budget; the next eviction catches up once
+ * they are unpinned or displaced.
+ */
+template <typename Texture>
+class TextureCache
+{
+public:
+    using Release = std::function<void(Texture&)>;
+
+    struct Stats
+    {
+        size_t hits        = 0;
+        size_t misses      = 0;
+        size_t evictions   = 0;
+        size_t entries     = 0;
+        size_t pinned      = 0; // cached entries that are pinned
+        size_t bytesUsed   = 0;
+        size_t budgetBytes = 0;
+    };
+
+    TextureCache(size_t budgetBytes, Release release)
+    : mRelease(std::move(release))
+    {
+        mStats.budgetBytes = budgetBytes;
+    }
+
+    ~TextureCache() { clear(); }
+
+    TextureCache(const TextureCache&)            = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    /**
+     * Return the cached texture for path and mark it most recently used, or
+     * nullptr on a miss. Updates the hit/miss counters.
+     */
+    Texture* find(const std::string& path)
+    {
+        auto it = mIndex.find(path);
+        if (it == mIndex.end())
+        {
+            mStats.misses++;
+            return nullptr;
+        }
+        mStats.hits++;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return &it->second->texture;
+    }
+
+    /** True if path is cached. Does not touch LRU order or counters. */
+    bool contains(const std::string& path) const { return mIndex.count(path) != 0; }
+
+    /**
+     * Insert or replace the texture for path as the most recently used entry,
+     * taking ownership, and evict to fit. The returned reference stays valid
+     * until the entry leaves the cache.
+     */
+    Texture& insert(const std::string& path, Texture texture, size_t bytes)
+    {
+        invalidate(path);
+        mEntries.push_front({ path, std::move(texture), bytes });
+        mIndex[path] = mEntries.begin();
+        mStats.bytesUsed += bytes;
+        evictToFit();
+        return mEntries.front().texture;
+    }
+
+    /**
+     * Replace the set of pinned paths. Paths need not be cached yet; a pinned
+     * path inserted later is protected from then on. Unpinned entries become
+     * evictable again, and are evicted now if the cache is over budget.
+     */
+    void setPinned(const std::vector<std::string>& paths)
+    {
+        mPinned.clear();
+        mPinned.insert(paths.begin(), paths.end());
+        evictToFit();
+    }
+
+    bool isPinned(const std::string& path) const { return mPinned.count(path) != 0; }
+
+    /** Release and drop the entry for path, if any. */
+    void invalidate(const std::string& path)
+    {
+        auto it = mIndex.find(path);
+        if (it == mIndex.end()) return;
+        erase(it->second);
+    }
+
+    void clear()
+    {
+        while (!mEntries.empty())
+            erase(std::prev(mEntries.end()));
+    }
+
+    /** Change the byte budget, evicting immediately if it shrank. */
+    void setBudget(size_t budgetBytes)
+    {
+        mStats.budgetBytes = budgetBytes;
+        evictToFit();
+    }
+
+    Stats getStats() const
+    {
+        Stats stats   = mStats;
+        stats.entries = mEntries.size();
+        stats.pinned  = 0;
+        for (const auto& path : mPinned)
+            stats.pinned += mIndex.count(path);
+        return stats;
+    }
+
+private:
+    struct Entry
+    {
+        std::string path;
+        Texture     texture;
+        size_t      bytes = 0;
+    };
+    using Iterator = typename std::list<Entry>::iterator;
+
+    std::list<Entry>                          mEntries; // front = most recently used
+    std::unordered_map<std::string, Iterator> mIndex;
+    std::unordered_set<std::string>           mPinned;
+    Release                                   mRelease;
+    Stats                                     mStats;
+
+    void erase(Iterator it)
+    {
+        mStats.bytesUsed -= it->bytes;
+        if (mRelease) mRelease(it->texture);
+        mIndex.erase(it->path);
+        mEntries.erase(it);
+    }
+
+    void evictToFit()
+    {
+        // Oldest first, stopping short of the most recently used entry.
+        auto it = mEntries.end();
+        while (mStats.bytesUsed > mStats.budgetBytes && it != mEntries.begin())
+        {
+            --it;
+            if (it == mEntries.begin()) break;
+            if (isPinned(it->path)) continue;
+            Iterator victim = it++;
+            erase(victim);
+            mStats.evictions++;
+        }
+    }
+};
@@ -0,0 +1,80 @@
+#include "NoteBuilder.h"
+#include "../FILE_OPERATOR/FileOperator.h"
+#include <algorithm>
+
+NoteBuilder::NoteBuilder(std::string notePath, std::string basePath)
+: mNotePath(std::move(notePath))
+, mBasePath(std::move(basePath))
+{
+}
+
+void NoteBuilder::refresh(const std::vector<uint32_t>& clueOrder, const DiscoveryBits& discovered,
+                          const ClueTextLoader& loadClue, FileOperator& files, uint32_t externalAppends)
+{
+    bool rewrite = false;
+    if (!mBuilt)
+    {
+        for (size_t i = 0; i < clueOrder.size(); ++i)
+        {
+            mPositions.emplace(clueOrder[i], i);
+            mMembers.set(clueOrder[i]);
+        }
+        mText    = files.load(mBasePath);
+        mBuilt   = true;
+        rewrite  = true;
+    }
+    if (externalAppends != mExternalAppends)
+    {
+        mExternalAppends = externalAppends;
+        rewrite          = true;
+    }
+
+    std::string tail; // new sections after every existing one
+    DiscoveryBits changed = (discovered & mMembers) ^ mIncluded;
+    changed.forEach([&](uint32_t id)
+    {
+        size_t position = mPositions[id];
+        auto   it = std::lower_bound(mSections.begin(), mSections.end(), position,
+                                     [](const Section& s, size_t p) { return s.position < p; });
+
+        if (mIncluded.test(id))
+        {
+            size_t length = it->length;
+            mText.erase(it->offset, length);
+            it = mSections.erase(it);
+            shiftSections(it, length, false);
+            mIncluded.set(id, false);
+            rewrite = true;
+            return;
+        }
+
+        std::string text = loadClue(id);
+        mStats.clueLoads++;
+        bool   atEnd  = it == mSections.end();
+        size_t offset = atEnd ? mText.size() : it->offset;
+        mText.insert(offset, text);
+        it = mSections.insert(it, { position, id, offset, text.size() });
+        shiftSections(it + 1, text.size(), true);
+        mIncluded.set(id);
+
+        if (atEnd) tail += text;
+        else       rewrite = true;
+    });
+
+    if (rewrite)
+    {
+        files.writeToFile(mNotePath, mText);
+        mStats.rewrites++;
+    }
+    else if (!tail.empty())
+    {
+        files.appendToFile(mNotePath, tail);
+        mStats.appends++;
+    }
+}
+
+void NoteBuilder::shiftSections(std::vector<Section>::iterator from, size_t delta, bool grow)
+{
+    for (; from != mSections.end(); ++from)
+        from->offset = grow ? from->offset + delta : from->offset - delta;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../GAME_STATE/DiscoveryBits.h"
+
+class FileOperator;
+
+/**
+ * Keeps one note file equal to its base text followed by the text of every
+ * discovered clue, in clue order, without rebuilding it from scratch.
+ *
+ * The builder holds the note in memory as the base plus one section per
+ * included clue. refresh() visits only the clues whose discovered bit
+ * changed since the last call and loads text for newly included ones. If
+ * every new clue lands after the last section, the note is appended to;
+ * otherwise the sections are spliced in memory and the note rewritten in
+ * one write. Either way the storage reads are proportional to the clues
+ * that changed, not to how many the note holds.
+ */
+class NoteBuilder
+{
+public:
+    using ClueTextLoader = std::function<std::string(uint32_t clueID)>;
+
+    struct Stats
+    {
+        size_t clueLoads = 0; // calls to the ClueTextLoader
+        size_t rewrites  = 0; // whole-note writes
+        size_t appends   = 0; // appends of new trailing sections
+    };
+
+    NoteBuilder(std::string notePath, std::string basePath);
+
+    /**
+     * Bring the note in line with discovered. clueOrder lists the note's
+     * clue IDs in the order their sections appear and must not change
+     * between calls.
+     *
+     * externalAppends is Notes::getAppendCount() for the note. When it has
+     * moved since the last call the file was appended to behind the
+     * builder's back, so it is rewritten from memory.
+     */
+    void refresh(const std::vector<uint32_t>& clueOrder, const DiscoveryBits& discovered,
+                 const ClueTextLoader& loadClue, FileOperator& files, uint32_t externalAppends = 0);
+
+    const std::string& getText()  const { return mText; }
+    Stats              getStats() const { return mStats; }
+
+private:
+    struct Section
+    {
+        size_t   position; // index in clueOrder
+        uint32_t clueID;
+        size_t   offset;   // into mText
+        size_t   length;
+    };
+
+    std::string                          mNotePath;
+    std::string                          mBasePath;
+    bool                                 mBuilt = false;
+    std::string                          mText;
+    std::unordered_map<uint32_t, size_t> mPositions; // clue ID -> index in clueOrder
+    DiscoveryBits                        mMembers;
+    DiscoveryBits                        mIncluded;
+    std::vector<Section>                 mSections;  // sorted by position
+    uint32_t                             mExternalAppends = 0;
+    Stats                                mStats;
+
+    void shiftSections(std::vector<Section>::iterator from, size_t delta, bool grow);
+};
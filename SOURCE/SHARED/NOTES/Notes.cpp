@@ -0,0 +1,55 @@
+#include "Notes.h"
+#include "../FILE_OPERATOR/FileOperator.h"
+#include <algorithm>
+
+void Notes::setPaths(std::vector<std::string> paths)
+{
+    mPaths = std::move(paths);
+}
+
+void Notes::queueAppend(const std::string& notePath, const std::string& sourcePath)
+{
+    mPending.push_back({ notePath, sourcePath });
+}
+
+void Notes::dropAppends(const std::string& notePath)
+{
+    mPending.erase(std::remove_if(mPending.begin(), mPending.end(),
+                                  [&](const PendingAppend& append) { return append.notePath == notePath; }),
+                   mPending.end());
+}
+
+void Notes::flush(FileOperator& files)
+{
+    // Gather each note's clues so a note is appended to once per flush,
+    // keeping the order in which they were discovered.
+    std::vector<std::string> noteOrder;
+    std::vector<std::string> noteText;
+    for (const PendingAppend& append : mPending)
+    {
+        std::string text = files.load(append.sourcePath);
+        if (text.empty()) continue;
+
+        size_t i = 0;
+        while (i < noteOrder.size() && noteOrder[i] != append.notePath) ++i;
+        if (i == noteOrder.size())
+        {
+            noteOrder.push_back(append.notePath);
+            noteText.emplace_back();
+        }
+        noteText[i] += text;
+    }
+    mPending.clear();
+
+    for (size_t i = 0; i < noteOrder.size(); ++i)
+    {
+        files.appendToFile(noteOrder[i], noteText[i]);
+        mAppendCounts[noteOrder[i]]++;
+    }
+}
+
+uint32_t Notes::getAppendCount(const std::string& notePath) const
+{
+    auto it = mAppendCounts.find(notePath);
+    return it != mAppendCounts.end() ? it->second : 0;
+}
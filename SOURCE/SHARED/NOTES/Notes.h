@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class FileOperator;
+
+/**
+ * The player's notes: the ordered list of note files browsed in notes mode,
+ * plus clue text waiting to be appended to them.
+ *
+ * Appends are queued instead of written so a discovery never waits on
+ * storage. flush() performs them, reading each clue file then and issuing
+ * one append per note.
+ */
+class Notes
+{
+public:
+    const std::vector<std::string>& getPaths() const { return mPaths; }
+    void   setPaths(std::vector<std::string> paths);
+    bool   empty() const { return mPaths.empty(); }
+    size_t size()  const { return mPaths.size(); }
+    const std::string& operator[](size_t i) const { return mPaths[i]; }
+
+    /** Queue the contents of sourcePath to be appended to notePath on the next flush. */
+    void queueAppend(const std::string& notePath, const std::string& sourcePath);
+    bool hasPendingAppends() const { return !mPending.empty(); }
+
+    /** Forget the appends queued for notePath, for a caller about to write the clues itself. */
+    void dropAppends(const std::string& notePath);
+
+    /** Perform every queued append, in order. */
+    void flush(FileOperator& files);
+
+    /** How many appends flush() has made to notePath so far. */
+    uint32_t getAppendCount(const std::string& notePath) const;
+
+private:
+    struct PendingAppend
+    {
+        std::string notePath;
+        std::string sourcePath;
+    };
+
+    std::vector<std::string>        mPaths;
+    std::vector<PendingAppend>      mPending;
+    std::map<std::string, uint32_t> mAppendCounts;
+};
@@ -1,69 +1,122 @@
 #include "Scene.h"
 
-Scene::Scene(std::string sceneID, std::string parentID, std::string name,
-             std::string primaryPath, std::string secondaryPath)
-: mSceneID(sceneID)
-, mParentSceneID(parentID)
-, mName(name)
-, mPrimaryPath(primaryPath)
-, mSecondaryPath(secondaryPath)
+Scene::Scene(std::string_view sceneID, std::string_view parentID, std::string_view name,
+             std::string_view primaryPath, std::string_view secondaryPath, SceneArena* arena)
+: mSceneID(sceneID, arena)
+, mParentSceneID(parentID, arena)
+, mName(name, arena)
+, mPrimaryPath(primaryPath, arena)
+, mSecondaryPath(secondaryPath, arena)
+, mNoteTarget(arena)
+, mLoresPath(arena)
+, mParentPath(arena)
+, mChildScenes(arena)
+, mZones(arena)
+, mHitIndex(arena)
 {
 }
 
-std::string Scene::getSceneID() const        { return mSceneID; }
-std::string Scene::getParentSceneID() const  { return mParentSceneID; }
-std::string Scene::getName() const           { return mName; }
-std::string Scene::getPrimaryPath() const    { return mPrimaryPath; }
-std::string Scene::getSecondaryPath() const  { return mSecondaryPath; }
+std::string_view Scene::getSceneID() const        { return mSceneID; }
+std::string_view Scene::getParentSceneID() const  { return mParentSceneID; }
+std::string_view Scene::getName() const           { return mName; }
+std::string_view Scene::getPrimaryPath() const    { return mPrimaryPath; }
+std::string_view Scene::getSecondaryPath() const  { return mSecondaryPath; }
 
-void Scene::setSceneID(std::string sceneID)  { mSceneID = sceneID; }
+void Scene::setSceneID(std::string_view sceneID)  { mSceneID.assign(sceneID); }
 
-void Scene::addChildScene(std::string childScene)
+void Scene::addChildScene(std::string_view childScene)
 {
-    mChildScenes.push_back(childScene);
+    mChildScenes.emplace_back(childScene, mChildScenes.get_allocator());
 }
 
-void Scene::addZone(Zone zone)
+void Scene::addZone(const Zone& zone)
 {
-    mZones.push_back(zone);
+    mZones.add(zone);
+    mHitIndex.clear();
 }
 
-std::vector<std::string> Scene::getChildScenes() const { return mChildScenes; }
-std::vector<Zone>        Scene::getZones()        const { return mZones; }
+void Scene::addZone(const Zone::Bounds& bounds, const int16_t* xs, const int16_t* ys, int count,
+                    std::string_view zoneID, std::string_view target,
+                    std::string_view noteTarget, std::string_view label)
+{
+    mZones.add(bounds, xs, ys, count, mSceneID, zoneID, target, noteTarget, label);
+    mHitIndex.clear();
+}
+
+void Scene::buildHitIndex()
+{
+    mHitIndex.build(mZones);
+}
+
+int Scene::findZoneIndex(int x, int y) const
+{
+    int hit = mHitIndex.lookup(x, y);
+    if (hit != SceneHitIndex::k_NotIndexed)
+        return hit;
+
+    for (size_t i = 0; i < mZones.size(); ++i)
+        if (mZones.containsPoint(i, x, y))
+            return (int)i;
+    return SceneHitIndex::k_NoZone;
+}
+
+const ArenaVector<ArenaString>& Scene::getChildScenes() const { return mChildScenes; }
+const ZoneTable&                Scene::getZones()        const { return mZones; }
+
+Scene::HitResult Scene::hitTest(int x, int y) const
+{
+    HitResult result;
+    result.zoneIndex = findZoneIndex(x, y);
+    if (result.zoneIndex < 0) return result;
+
+    ZoneTable::ZoneView zone = mZones[result.zoneIndex];
+    result.zoneID     = zone.getZoneID();
+    result.target     = zone.getTarget();
+    result.noteTarget = zone.getNoteTarget();
+    return result;
+}
+
+void Scene::hitTestBatch(const Zone::Point* points, size_t count, int* zoneIndices) const
+{
+    for (size_t i = 0; i < count; ++i)
+        zoneIndices[i] = findZoneIndex(points[i].first, points[i].second);
+}
 
 std::string Scene::getInterceptingZoneID(int x, int y) const
 {
-    for (auto zone : mZones)
-    {
-        if (zone.containsPoint(x, y))
-            return zone.getZoneID();
-    }
-    return "";
+    return std::string(hitTest(x, y).zoneID);
 }
 
 bool Scene::isRoot()                    const { return mIsRoot; }
 void Scene::setIsRoot(bool isRoot)            { mIsRoot = isRoot; }
 bool Scene::isDiscovered()              const { return mIsDiscovered; }
 void Scene::setIsDiscovered(bool d)           { mIsDiscovered = d; }
-std::string Scene::getParentPath()      const { return mParentPath; }
-void Scene::setParentPath(std::string path)   { mParentPath = path; }
-std::string Scene::getNoteTarget()      const { return mNoteTarget; }
-void Scene::setNoteTarget(std::string path)   { mNoteTarget = path; }
+std::string_view Scene::getParentPath() const   { return mParentPath; }
+void Scene::setParentPath(std::string_view path) { mParentPath.assign(path); }
+std::string_view Scene::getNoteTarget() const   { return mNoteTarget; }
+void Scene::setNoteTarget(std::string_view path) { mNoteTarget.assign(path); }
+std::string_view Scene::getLoresPath() const    { return mLoresPath; }
+void Scene::setLoresPath(std::string_view path)  { mLoresPath.assign(path); }
 
 std::string Scene::getInterceptingZoneNoteTarget(int x, int y) const
 {
-    for (auto zone : mZones)
-        if (zone.containsPoint(x, y))
-            return zone.getNoteTarget();
-    return "";
+    return std::string(hitTest(x, y).noteTarget);
 }
 
 std::string Scene::getInterceptingZoneTarget(int x, int y) const
 {
-    for (auto zone : mZones)
-    {
-        if (zone.containsPoint(x, y))
-            return zone.getTarget();
-    }
-    return "";
+    return std::string(hitTest(x, y).target);
+}
+
+size_t Scene::estimateBytes() const
+{
+    size_t bytes = sizeof(Scene)
+                 + mSceneID.capacity() + mParentSceneID.capacity() + mName.capacity()
+                 + mPrimaryPath.capacity() + mSecondaryPath.capacity()
+                 + mNoteTarget.capacity() + mParentPath.capacity() + mLoresPath.capacity();
+    for (const auto& child : mChildScenes)
+        bytes += sizeof(ArenaString) + child.capacity();
+    bytes += mZones.memoryBytes();
+    bytes += mHitIndex.memoryBytes();
+    return bytes;
 }
@@ -4,8 +4,12 @@
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include "../ZONE/Zone.h"
+#include "../ZONE/ZoneTable.h"
+#include "SceneArena.h"
+#include "SceneHitIndex.h"
 
 /**
  * This class defines the majority of the gameplay.
@@ -14,48 +18,103 @@
  *   primaryPath   - main content (PNG for locations, markdown for notes)
  *   secondaryPath - supplementary content (markdown summary for locations,
  *                   associated PNG for notes). May be empty.
+ * Hi-res location scenes also keep their 320x240 image as loresPath, for
+ * renderers to show while the hi-res one loads; it is empty otherwise.
+ *
+ * A scene given a SceneArena keeps its strings, zones and hit index in the
+ * arena; see SceneFactory::build(json, arena).
  */
 class Scene
 {
 public:
-    Scene(std::string sceneID       = "",
-          std::string parentID      = "Main",
-          std::string name          = "",
-          std::string primaryPath   = "",
-          std::string secondaryPath = "");
-
-    std::string getSceneID()        const;
-    void setSceneID(std::string sceneID);
-    std::string getParentSceneID()  const;
-    std::string getName()           const;
-    std::string getPrimaryPath()    const;
-    std::string getSecondaryPath()  const;
+    /**
+     * Outcome of a single hit query. The views point into the scene's zone
+     * and stay valid only while the scene is alive and unmodified; copy them
+     * before doing anything that may replace the scene (e.g. loadScene).
+     */
+    struct HitResult
+    {
+        int              zoneIndex = -1; // -1 when no zone was hit
+        std::string_view zoneID;
+        std::string_view target;
+        std::string_view noteTarget;
+
+        explicit operator bool() const { return zoneIndex >= 0; }
+    };
+
+    Scene(std::string_view sceneID       = "",
+          std::string_view parentID      = "Main",
+          std::string_view name          = "",
+          std::string_view primaryPath   = "",
+          std::string_view secondaryPath = "",
+          SceneArena*      arena         = nullptr);
+
+    // Views into the scene's own storage; valid while the scene is unmodified.
+    std::string_view getSceneID()       const;
+    void setSceneID(std::string_view sceneID);
+    std::string_view getParentSceneID() const;
+    std::string_view getName()          const;
+    std::string_view getPrimaryPath()   const;
+    std::string_view getSecondaryPath() const;
+    /** Resolve the first zone containing (x, y) in one lookup. */
+    HitResult   hitTest(int x, int y)                   const;
+
+    /**
+     * Resolve count points in one call, e.g. when replaying a recorded touch
+     * log. zoneIndices[i] receives the index of the first zone containing
+     * points[i], or -1.
+     */
+    void        hitTestBatch(const Zone::Point* points, size_t count, int* zoneIndices) const;
     std::string getInterceptingZoneID(int x, int y)     const;
     std::string getInterceptingZoneTarget(int x, int y) const;
     bool        isRoot()                                const;
     void        setIsRoot(bool isRoot);
     bool        isDiscovered()                          const;
     void        setIsDiscovered(bool discovered);
-    std::string getParentPath()                         const;
-    void        setParentPath(std::string path);
+    std::string_view getParentPath()                    const;
+    void        setParentPath(std::string_view path);
     std::string getInterceptingZoneNoteTarget(int x, int y) const;
-    std::string getNoteTarget() const;
-    void        setNoteTarget(std::string path);
+    std::string_view getNoteTarget() const;
+    void        setNoteTarget(std::string_view path);
+    std::string_view getLoresPath() const;
+    void        setLoresPath(std::string_view path);
 
-    void addChildScene(std::string childScene);
-    void addZone(Zone zone);
-    std::vector<std::string> getChildScenes() const;
-    std::vector<Zone>        getZones()       const;
+    void addChildScene(std::string_view childScene);
+    void addZone(const Zone& zone);
+
+    /** Add a zone given as planar vertex arrays, without building a Zone. */
+    void addZone(const Zone::Bounds& bounds, const int16_t* xs, const int16_t* ys, int count,
+                 std::string_view zoneID, std::string_view target,
+                 std::string_view noteTarget, std::string_view label);
+
+    const ArenaVector<ArenaString>& getChildScenes() const;
+    const ZoneTable&                getZones()       const;
+
+    /**
+     * Precompute the zone hit index so the getInterceptingZone* lookups skip
+     * the per-zone ray-cast. Called by SceneFactory once all zones are added;
+     * addZone() discards a stale index and lookups fall back to scanning.
+     */
+    void buildHitIndex();
+    bool hasHitIndex() const { return mHitIndex.isBuilt(); }
+
+    /** Approximate memory footprint of this scene, used for cache budgeting. */
+    size_t estimateBytes() const;
 private:
-    std::string mSceneID        = "";
-    std::string mParentSceneID  = "";
-    std::string mName           = "";
-    std::string mPrimaryPath    = ""; // PNG for locations, markdown for notes
-    std::string mSecondaryPath  = ""; // markdown for locations, PNG for notes (optional)
-    std::string mNoteTarget     = ""; // data-root-relative path of the note .md to append to on discovery
+    ArenaString mSceneID;
+    ArenaString mParentSceneID;
+    ArenaString mName;
+    ArenaString mPrimaryPath;    // PNG for locations, markdown for notes
+    ArenaString mSecondaryPath;  // markdown for locations, PNG for notes (optional)
+    ArenaString mNoteTarget;     // data-root-relative path of the note .md to append to on discovery
+    ArenaString mLoresPath;      // 320x240 PNG when mPrimaryPath is the hi-res one, else empty
     bool        mIsRoot         = false;
     bool        mIsDiscovered   = false;
-    std::string mParentPath     = "";
-    std::vector<std::string> mChildScenes;
-    std::vector<Zone> mZones;
+    ArenaString mParentPath;
+    ArenaVector<ArenaString> mChildScenes;
+    ZoneTable         mZones;
+    SceneHitIndex     mHitIndex;
+
+    // Index of the first zone containing (x, y), or -1.
+    int findZoneIndex(int x, int y) const;
 };
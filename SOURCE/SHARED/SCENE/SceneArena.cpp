@@ -0,0 +1,90 @@
+#include "SceneArena.h"
+#include <algorithm>
+#include <cstdint>
+
+static const size_t k_MinBlockBytes = 1024;
+
+SceneArena::SceneArena(size_t initialBytes)
+{
+    if (initialBytes > 0)
+        addBlock(initialBytes);
+}
+
+SceneArena::~SceneArena()
+{
+    releaseBlocks();
+}
+
+void* SceneArena::allocate(size_t bytes, size_t alignment)
+{
+    while (true)
+    {
+        if (mCurrent < mBlocks.size())
+        {
+            Block&    block   = mBlocks[mCurrent];
+            uintptr_t base    = reinterpret_cast<uintptr_t>(block.data);
+            uintptr_t aligned = (base + mOffset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+            size_t    end     = (aligned - base) + bytes;
+            if (end <= block.size)
+            {
+                mStats.bytesUsed += end - mOffset;
+                mStats.highWater  = std::max(mStats.highWater, mStats.bytesUsed);
+                mStats.liveAllocations++;
+                mOffset = end;
+                return reinterpret_cast<void*>(aligned);
+            }
+            // Wasted tail still counts as used, so the high-water mark covers it.
+            mStats.bytesUsed += block.size - mOffset;
+            if (mCurrent + 1 < mBlocks.size())
+            {
+                mCurrent++;
+                mOffset = 0;
+                continue;
+            }
+        }
+        addBlock(bytes + alignment);
+    }
+}
+
+void SceneArena::deallocate(void* /*p*/, size_t /*bytes*/)
+{
+    // Memory is reclaimed by reset(); only the live count changes here.
+    if (mStats.liveAllocations > 0)
+        mStats.liveAllocations--;
+}
+
+bool SceneArena::reset()
+{
+    if (mStats.liveAllocations > 0)
+        return false;
+
+    if (mBlocks.size() > 1)
+    {
+        size_t total = std::max(mStats.highWater, mStats.capacity);
+        releaseBlocks();
+        addBlock(total);
+    }
+    mCurrent         = 0;
+    mOffset          = 0;
+    mStats.bytesUsed = 0;
+    return true;
+}
+
+void SceneArena::addBlock(size_t minBytes)
+{
+    size_t last = mBlocks.empty() ? 0 : mBlocks.back().size;
+    size_t size = std::max({ minBytes, last * 2, k_MinBlockBytes });
+    mBlocks.push_back({ static_cast<char*>(::operator new(size)), size });
+    mStats.capacity += size;
+    mStats.blockAllocations++;
+    mCurrent = mBlocks.size() - 1;
+    mOffset  = 0;
+}
+
+void SceneArena::releaseBlocks()
+{
+    for (Block& block : mBlocks)
+        ::operator delete(block.data);
+    mBlocks.clear();
+    mStats.capacity = 0;
+}
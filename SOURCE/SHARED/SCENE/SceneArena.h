@@ -0,0 +1,106 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Monotonic buffer that holds one scene at a time: the Scene object, its
+ * strings, packed zones and hit index. Allocations bump a pointer and are
+ * never freed individually; reset() rewinds the whole buffer before the next
+ * scene is built, so repeated navigation reuses the same memory instead of
+ * fragmenting the heap.
+ *
+ * When a scene outgrows the buffer, another block is taken from the heap.
+ * The next reset() folds all blocks into one sized to the high-water mark,
+ * so once every scene has been visited the arena stops touching the heap.
+ *
+ * reset() refuses (returns false) while any allocation is still live, i.e.
+ * while a scene built in the arena has not been destroyed yet.
+ */
+class SceneArena
+{
+public:
+    struct Stats
+    {
+        size_t bytesUsed        = 0; // bytes handed out since the last reset
+        size_t highWater        = 0; // largest bytesUsed seen
+        size_t capacity         = 0; // bytes reserved across all blocks
+        size_t blockAllocations = 0; // heap allocations made for blocks
+        size_t liveAllocations  = 0; // allocations not yet deallocated
+    };
+
+    explicit SceneArena(size_t initialBytes = 0);
+    ~SceneArena();
+
+    SceneArena(const SceneArena&)            = delete;
+    SceneArena& operator=(const SceneArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment);
+    void  deallocate(void* p, size_t bytes);
+
+    /** Rewind to empty. Returns false, leaving the arena untouched, if allocations are still live. */
+    bool reset();
+
+    Stats getStats() const { return mStats; }
+
+private:
+    struct Block
+    {
+        char*  data;
+        size_t size;
+    };
+
+    void addBlock(size_t minBytes);
+    void releaseBlocks();
+
+    std::vector<Block> mBlocks;
+    size_t             mCurrent = 0; // index of the block being filled
+    size_t             mOffset  = 0; // bytes used in the current block
+    Stats              mStats;
+};
+
+/**
+ * Standard allocator over a SceneArena. A null arena falls back to the global
+ * heap, so the same container types serve arena and heap-built scenes.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    ArenaAllocator(SceneArena* arena = nullptr) noexcept : mArena(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : mArena(other.arena()) {}
+
+    T* allocate(size_t n)
+    {
+        if (!mArena) return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(mArena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        if (!mArena) ::operator delete(p);
+        else         mArena->deallocate(p, n * sizeof(T));
+    }
+
+    SceneArena* arena() const noexcept { return mArena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return mArena == other.arena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return mArena != other.arena(); }
+
+private:
+    SceneArena* mArena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
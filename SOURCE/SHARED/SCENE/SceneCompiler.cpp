@@ -0,0 +1,144 @@
+#include "SceneCompiler.h"
+#include "SceneFactory.h"
+#include "../ZONE/ZoneTable.h"
+#include "../UTIL/ByteIO.h"
+#include "../UTIL/Fnv1a.h"
+#include <nlohmann/json.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+// Interns strings while a record is written; the table precedes the zones.
+class StringTable
+{
+public:
+    uint16_t intern(std::string_view sv)
+    {
+        std::string s(sv);
+        auto it = mIndex.find(s);
+        if (it != mIndex.end()) return it->second;
+        uint16_t idx = static_cast<uint16_t>(mStrings.size());
+        mStrings.push_back(s);
+        mIndex.emplace(s, idx);
+        return idx;
+    }
+
+    const std::vector<std::string>& strings() const { return mStrings; }
+
+private:
+    std::vector<std::string>                  mStrings;
+    std::unordered_map<std::string, uint16_t> mIndex;
+};
+
+// Writes one bounds + polygon block, as SceneFactory reads it back.
+void writeGeometry(ByteWriter& out, const ZoneTable::ZoneView& zone)
+{
+    const Zone::Bounds& b = zone.getBounds();
+    out.i16(b.mX); out.i16(b.mY); out.i16(b.mW); out.i16(b.mH);
+    ZoneTable::PolygonView poly = zone.getPolygon();
+    out.u16(static_cast<uint16_t>(poly.size()));
+    for (auto [x, y] : poly)
+    {
+        out.i16(x);
+        out.i16(y);
+    }
+}
+
+// Byte offset of sourceLength in the record header.
+constexpr size_t k_SourceOffset = 12;
+
+bool sameGeometry(const ZoneTable::ZoneView& a, const ZoneTable::ZoneView& b)
+{
+    const Zone::Bounds& ba = a.getBounds();
+    const Zone::Bounds& bb = b.getBounds();
+    return ba.mX == bb.mX && ba.mY == bb.mY && ba.mW == bb.mW && ba.mH == bb.mH
+        && a.getPolygon() == b.getPolygon();
+}
+} // namespace
+
+std::string SceneCompiler::compile(const std::string& jsonString)
+{
+    if (!nlohmann::json::accept(jsonString))
+        return "";
+
+    auto lores = SceneFactory(false).build(jsonString);
+    auto hires = SceneFactory(true).build(jsonString);
+
+    const ZoneTable& loresZones = lores->getZones();
+    const ZoneTable& hiresZones = hires->getZones();
+    if (loresZones.size() != hiresZones.size())
+        return "";
+
+    // Zones are written to a separate body so the string table, which must
+    // precede them, is complete by the time the header is assembled.
+    std::string bodyBytes;
+    ByteWriter  body{ bodyBytes };
+    StringTable table;
+    for (std::string_view s : { lores->getSceneID(), lores->getParentSceneID(),
+                                  lores->getName(), lores->getPrimaryPath(),
+                                  hires->getPrimaryPath(), lores->getSecondaryPath(),
+                                  lores->getParentPath(), lores->getNoteTarget() })
+        body.u16(table.intern(s));
+
+    for (size_t i = 0; i < loresZones.size(); ++i)
+    {
+        ZoneTable::ZoneView lz = loresZones[i];
+        ZoneTable::ZoneView hz = hiresZones[i];
+        body.u16(table.intern(lz.getZoneID()));
+        body.u16(table.intern(lz.getTarget()));
+        body.u16(table.intern(lz.getNoteTarget()));
+        body.u16(table.intern(lz.getLabel()));
+
+        bool separateHires = !sameGeometry(lz, hz);
+        body.u8(separateHires ? 1 : 0);
+        writeGeometry(body, lz);
+        if (separateHires)
+            writeGeometry(body, hz);
+    }
+
+    std::string record;
+    ByteWriter  out{ record };
+    for (char c : k_Magic) out.u8(static_cast<uint8_t>(c));
+    out.u16(k_Version);
+    out.u16((lores->isRoot() ? 1 : 0) | (lores->isDiscovered() ? 2 : 0));
+    out.u16(static_cast<uint16_t>(table.strings().size()));
+    out.u16(static_cast<uint16_t>(loresZones.size()));
+    out.u32(static_cast<uint32_t>(jsonString.size()));
+    out.u32(fnv1a32(jsonString.data(), jsonString.size()));
+    for (const std::string& s : table.strings())
+    {
+        out.u16(static_cast<uint16_t>(s.size()));
+        record += s;
+    }
+    record += bodyBytes;
+    return record;
+}
+
+bool SceneCompiler::isCompiledFrom(const std::string& record, const std::string& jsonString)
+{
+    ByteReader in{ record, k_SourceOffset };
+    uint32_t   length = in.u32();
+    uint32_t   hash   = in.u32();
+    return in.ok && length == jsonString.size()
+        && hash == fnv1a32(jsonString.data(), jsonString.size());
+}
+
+std::string SceneCompiler::recordPath(const std::string& jsonPath)
+{
+    static const std::string ext = ".json";
+    if (jsonPath.size() < ext.size() ||
+        jsonPath.compare(jsonPath.size() - ext.size(), ext.size(), ext) != 0)
+        return "";
+    return jsonPath.substr(0, jsonPath.size() - ext.size()) + ".kscb";
+}
+
+void SceneCompiler::recordPath(const std::string& jsonPath, std::string& out)
+{
+    static const std::string ext = ".json";
+    out.clear();
+    if (jsonPath.size() < ext.size() ||
+        jsonPath.compare(jsonPath.size() - ext.size(), ext.size(), ext) != 0)
+        return;
+    out.append(jsonPath, 0, jsonPath.size() - ext.size()).append(".kscb");
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * Compiles a scene JSON string into a compact binary scene record (.kscb) that
+ * SceneFactory::buildFromRecord() can turn into a Scene without a JSON parse.
+ *
+ * The scene JSON stays the source of truth. A record lives next to its JSON
+ * (Avery_Full.json -> Avery_Full.kscb) and GameRunner falls back to the JSON
+ * whenever the record is missing or does not validate. A record that is
+ * present is trusted, so the JSON is never read alongside it; keeping records
+ * current is the compiler's job (KSC_SceneCompiler, compile_scenes.py).
+ * Each record still names its source (see isCompiledFrom()) for tools.
+ *
+ * Record layout (all integers little-endian):
+ *
+ *   header      "KSCB"  u16 version  u16 flags (bit0 isRoot, bit1 isDiscovered)
+ *               u16 stringCount  u16 zoneCount
+ *               u32 sourceLength  u32 sourceHash    - of the JSON, fnv1a32
+ *   strings     stringCount x { u16 length, bytes }   - interned, no terminator
+ *   scene       u16 string index x 8: id, parent, name, loresPath, hiresPath,
+ *               secondaryPath, parentPath, notePath
+ *   zones       zoneCount x {
+ *                   u16 string index x 4: id, target, noteTarget, label
+ *                   u8  flags (bit0 has separate hi-res geometry)
+ *                   geometry (lo-res)
+ *                   geometry (hi-res, only when flag bit0 is set)
+ *               }
+ *   geometry    i16 x, y, w, h (precomputed AABB)  u16 pointCount
+ *               pointCount x { i16 x, i16 y }       - prescaled to 320x240
+ *
+ * Geometry is produced by running the JSON through SceneFactory in both modes,
+ * so a record always builds the exact same Scene as its JSON.
+ */
+class SceneCompiler
+{
+public:
+    static constexpr char     k_Magic[4] = { 'K', 'S', 'C', 'B' };
+    static constexpr uint16_t k_Version  = 2;
+
+    /**
+     * Compile a scene JSON document into a binary record.
+     * Returns an empty string if the JSON is malformed.
+     */
+    static std::string compile(const std::string& jsonString);
+
+    /**
+     * True if record's header names jsonString as its source, i.e. the JSON
+     * has not been edited since the record was compiled.
+     */
+    static bool isCompiledFrom(const std::string& record, const std::string& jsonString);
+
+    /**
+     * Map a data-root-relative scene JSON path to its compiled record path.
+     * Returns an empty string for paths that do not end in ".json".
+     */
+    static std::string recordPath(const std::string& jsonPath);
+
+    /** recordPath() into out, reusing its capacity. */
+    static void recordPath(const std::string& jsonPath, std::string& out);
+};
@@ -1,6 +1,10 @@
 #include "SceneFactory.h"
+#include "SceneCompiler.h"
+#include "../UTIL/ByteIO.h"
 #include "../ZONE/Zone.h"
 #include <nlohmann/json.hpp>
+#include <string_view>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -9,80 +13,476 @@ SceneFactory::SceneFactory(bool useHires)
 {
 }
 
-std::unique_ptr<Scene> SceneFactory::build(const std::string& jsonString)
+namespace
 {
-    json j = json::parse(jsonString, nullptr, false); // false = no exceptions
-    if (j.is_discarded())
-        return std::make_unique<Scene>();
-
-    std::string sceneID       = j.value("id",             "");
-    std::string parentID      = j.value("parent",         "Main");
-    std::string name          = j.value("name",           "");
-    std::string primaryPath   = mUseHires ? j.value("hires_image_path", "")
-                                          : j.value("lores_image_path",  "");
-    if (primaryPath.empty())
-        primaryPath = j.value("lores_image_path", "");
-    std::string secondaryPath = j.value("secondary_path", "");
+// Streams a scene document through nlohmann's SAX interface and keeps only
+// the values the current mode reads, so memory follows the size of the
+// resulting scene rather than the document. Unknown keys and values of the
+// wrong type are skipped, as are hires_* fields on lores builds.
+class SceneSaxHandler : public nlohmann::json_sax<json>
+{
+public:
+    struct PendingZone
+    {
+        std::string        id, target, noteTarget, label;
+        int                x = 0, y = 0, w = 0, h = 0;
+        bool               hasHiresKey = false;   // "hires_points" present, whatever its value
+        int                loresCount  = 0;       // elements in "points"
+        int                hiresCount  = 0;       // elements in "hires_points"
+        std::vector<float> lores, hires;          // interleaved x, y in document units
+    };
 
-    auto scene = std::make_unique<Scene>(sceneID, parentID, name, primaryPath, secondaryPath);
-    scene->setIsRoot(j.value("isRoot", false));
-    scene->setIsDiscovered(j.value("isDiscovered", false));
-    scene->setParentPath(j.value("parent_path", ""));
-    scene->setNoteTarget(j.value("notePath", ""));
+    explicit SceneSaxHandler(bool useHires) : mUseHires(useHires) {}
 
-    float hiresScaleX = 1.0f, hiresScaleY = 1.0f;
-    if (mUseHires && j.contains("hires_canvas") && j["hires_canvas"].is_object())
+    std::string sceneID, parentID = "Main", name, loresPath, hiresPath;
+    std::string secondaryPath, parentPath, notePath;
+    bool        isRoot       = false;
+    bool        isDiscovered = false;
+    bool        hasCanvas    = false;
+    float       canvasW      = 320.0f;
+    float       canvasH      = 240.0f;
+    std::vector<PendingZone> zones;
+
+    bool null() override                                   { value(); return true; }
+    bool boolean(bool val) override
+    {
+        if (value())
+        {
+            if (mField == Field::IsRoot)       isRoot       = val;
+            if (mField == Field::IsDiscovered) isDiscovered = val;
+        }
+        return true;
+    }
+    bool number_integer(number_integer_t val) override     { return number((double)val); }
+    bool number_unsigned(number_unsigned_t val) override   { return number((double)val); }
+    bool number_float(number_float_t val, const string_t&) override { return number(val); }
+    bool string(string_t& val) override
+    {
+        if (value())
+            if (std::string* field = stringField())
+                *field = std::move(val);
+        return true;
+    }
+    bool binary(binary_t&) override                        { value(); return true; }
+
+    bool start_object(std::size_t) override
+    {
+        if (mSkip == 0 && element())
+        {
+            Ctx top = mDepth ? mStack[mDepth - 1] : Ctx::None;
+            if (top == Ctx::None)                                 return push(Ctx::Root);
+            if (top == Ctx::Root && mField == Field::Canvas)     { hasCanvas = true; return push(Ctx::Canvas); }
+            if (top == Ctx::Zones)                              { zones.emplace_back(); return push(Ctx::Zone); }
+        }
+        mSkip++;
+        return true;
+    }
+    bool start_array(std::size_t) override
+    {
+        if (mSkip == 0 && element())
+        {
+            Ctx top = mDepth ? mStack[mDepth - 1] : Ctx::None;
+            if (top == Ctx::Root && mField == Field::Zones)       return push(Ctx::Zones);
+            if (top == Ctx::Zone && mField == Field::Points)      return push(Ctx::Points);
+            if (top == Ctx::Zone && mField == Field::HiresPoints) return push(Ctx::Points);
+            if (top == Ctx::Points)                             { mCoord = 0; return push(Ctx::Point); }
+        }
+        mSkip++;
+        return true;
+    }
+    bool end_object() override
+    {
+        // A hires build that found hires_points no longer needs the lores ones.
+        if (mSkip == 0 && mStack[mDepth - 1] == Ctx::Zone && zones.back().hasHiresKey)
+            std::vector<float>().swap(zones.back().lores);
+        return pop();
+    }
+    bool end_array() override
     {
-        float cw = j["hires_canvas"].value("width",  320.0f);
-        float ch = j["hires_canvas"].value("height", 240.0f);
-        hiresScaleX = 320.0f / cw;
-        hiresScaleY = 240.0f / ch;
+        if (mSkip == 0 && mStack[mDepth - 1] == Ctx::Point)
+        {
+            // A missing coordinate reads as 0.
+            std::vector<float>& out = points();
+            for (; mCoord < 2; ++mCoord)
+                out.push_back(0.0f);
+        }
+        return pop();
     }
 
-    if (j.contains("zones") && j["zones"].is_array())
+    bool key(string_t& val) override
     {
-        for (auto& z : j["zones"])
+        if (mSkip > 0) return true;
+        mField = Field::None;
+        switch (mStack[mDepth - 1])
         {
-            const char* pointsKey = (mUseHires && z.contains("hires_points")) ? "hires_points" : "points";
-            float scaleX = (pointsKey[0] == 'h') ? hiresScaleX : 1.0f;
-            float scaleY = (pointsKey[0] == 'h') ? hiresScaleY : 1.0f;
-            if (z.contains(pointsKey) && z[pointsKey].is_array() && !z[pointsKey].empty())
+        case Ctx::Root:
+            if      (val == "id")               mField = Field::ID;
+            else if (val == "parent")           mField = Field::Parent;
+            else if (val == "name")             mField = Field::Name;
+            else if (val == "lores_image_path") mField = Field::LoresPath;
+            else if (val == "secondary_path")   mField = Field::SecondaryPath;
+            else if (val == "parent_path")      mField = Field::ParentPath;
+            else if (val == "notePath")         mField = Field::NotePath;
+            else if (val == "isRoot")           mField = Field::IsRoot;
+            else if (val == "isDiscovered")     mField = Field::IsDiscovered;
+            else if (val == "zones")            mField = Field::Zones;
+            else if (mUseHires && val == "hires_image_path") mField = Field::HiresPath;
+            else if (mUseHires && val == "hires_canvas")     mField = Field::Canvas;
+            break;
+        case Ctx::Canvas:
+            if      (val == "width")  mField = Field::Width;
+            else if (val == "height") mField = Field::Height;
+            break;
+        case Ctx::Zone:
+            if      (val == "id")         mField = Field::ZoneID;
+            else if (val == "target")     mField = Field::Target;
+            else if (val == "noteTarget") mField = Field::NoteTarget;
+            else if (val == "label")      mField = Field::Label;
+            else if (val == "x")          mField = Field::X;
+            else if (val == "y")          mField = Field::Y;
+            else if (val == "width")      mField = Field::W;
+            else if (val == "height")     mField = Field::H;
+            else if (val == "points")
+            {
+                mField = Field::Points;
+                zones.back().loresCount = 0;
+                zones.back().lores.clear();
+            }
+            else if (mUseHires && val == "hires_points")
             {
-                Zone::Polygon poly;
-                int minX = 320, minY = 240, maxX = 0, maxY = 0;
-                for (auto& pt : z[pointsKey])
-                {
-                    int px = (int)(pt[0].get<float>() * scaleX);
-                    int py = (int)(pt[1].get<float>() * scaleY);
-                    poly.push_back({px, py});
-                    if (px < minX) minX = px;
-                    if (py < minY) minY = py;
-                    if (px > maxX) maxX = px;
-                    if (py > maxY) maxY = py;
-                }
-                Zone::Bounds bounds(minX, minY, maxX - minX, maxY - minY);
-                Zone zone(*scene, bounds,
-                          z.value("id", ""),
-                          z.value("target", ""),
-                          z.value("noteTarget", ""),
-                          z.value("label", ""));
-                zone.setPolygon(std::move(poly));
-                scene->addZone(std::move(zone));
+                mField = Field::HiresPoints;
+                zones.back().hasHiresKey = true;
+                zones.back().hiresCount  = 0;
+                zones.back().hires.clear();
             }
-            else
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override
+    {
+        return false;
+    }
+
+private:
+    enum class Ctx : uint8_t { None, Root, Canvas, Zones, Zone, Points, Point };
+    enum class Field : uint8_t
+    {
+        None, ID, Parent, Name, LoresPath, HiresPath, SecondaryPath, ParentPath, NotePath,
+        IsRoot, IsDiscovered, Canvas, Width, Height, Zones,
+        ZoneID, Target, NoteTarget, Label, X, Y, W, H, Points, HiresPoints
+    };
+
+    // Deepest level read: root > zones > zone > points > point.
+    static const int k_MaxDepth = 5;
+
+    bool  mUseHires;
+    Ctx   mStack[k_MaxDepth];
+    int   mDepth       = 0;
+    int   mSkip        = 0;     // depth inside a skipped container
+    Field mField       = Field::None;
+    int   mCoord       = 0;     // coordinates read from the current point
+    bool  mHiresPoints = false; // the open points array is "hires_points"
+
+    bool push(Ctx ctx)
+    {
+        if (ctx == Ctx::Points) mHiresPoints = mField == Field::HiresPoints;
+        mStack[mDepth++] = ctx;
+        return true;
+    }
+    bool pop()
+    {
+        if (mSkip > 0) mSkip--;
+        else           mDepth--;
+        return true;
+    }
+
+    // Counts an element of an open points array; true if the value is read.
+    bool element()
+    {
+        if (mDepth > 0 && mStack[mDepth - 1] == Ctx::Points)
+        {
+            PendingZone& zone = zones.back();
+            (mHiresPoints ? zone.hiresCount : zone.loresCount)++;
+        }
+        return true;
+    }
+    // Counts a scalar; true if it is the direct value of the current field,
+    // not one nested in a skipped container under it.
+    bool value()
+    {
+        if (mSkip == 0) element();
+        return mSkip == 0;
+    }
+
+    std::vector<float>& points()
+    {
+        return mHiresPoints ? zones.back().hires : zones.back().lores;
+    }
+
+    bool number(double val)
+    {
+        if (mSkip > 0 || mDepth == 0) return true;
+        switch (mStack[mDepth - 1])
+        {
+        case Ctx::Point:
+            if (mCoord < 2) { points().push_back((float)val); mCoord++; }
+            break;
+        case Ctx::Canvas:
+            if (mField == Field::Width)  canvasW = (float)val;
+            if (mField == Field::Height) canvasH = (float)val;
+            break;
+        case Ctx::Zone:
+            if (mField == Field::X) zones.back().x = (int)val;
+            if (mField == Field::Y) zones.back().y = (int)val;
+            if (mField == Field::W) zones.back().w = (int)val;
+            if (mField == Field::H) zones.back().h = (int)val;
+            break;
+        case Ctx::Points:
+            element();
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    std::string* stringField()
+    {
+        if (mDepth == 0) return nullptr;
+        Ctx top = mStack[mDepth - 1];
+        if (top == Ctx::Root)
+        {
+            switch (mField)
+            {
+            case Field::ID:            return &sceneID;
+            case Field::Parent:        return &parentID;
+            case Field::Name:          return &name;
+            case Field::LoresPath:     return &loresPath;
+            case Field::HiresPath:     return &hiresPath;
+            case Field::SecondaryPath: return &secondaryPath;
+            case Field::ParentPath:    return &parentPath;
+            case Field::NotePath:      return &notePath;
+            default:                   return nullptr;
+            }
+        }
+        if (top == Ctx::Zone)
+        {
+            switch (mField)
             {
-                scene->addZone(Zone(*scene,
-                                   Zone::Bounds(z.value("x",      0),
-                                                z.value("y",      0),
-                                                z.value("width",  0),
-                                                z.value("height", 0)),
-                                   z.value("id", ""),
-                                   z.value("target", ""),
-                                   z.value("noteTarget", ""),
-                                   z.value("label", "")));
+            case Field::ZoneID:     return &zones.back().id;
+            case Field::Target:     return &zones.back().target;
+            case Field::NoteTarget: return &zones.back().noteTarget;
+            case Field::Label:      return &zones.back().label;
+            default:                return nullptr;
             }
         }
+        return nullptr;
     }
+};
+} // namespace
 
+template <typename Make>
+auto SceneFactory::buildJson(const std::string& jsonString, Make make)
+{
+    SceneSaxHandler doc(mUseHires);
+    if (!json::sax_parse(jsonString, &doc))
+        return make("", "Main", "", "", "");
+
+    std::string_view primaryPath = mUseHires ? doc.hiresPath : doc.loresPath;
+    if (primaryPath.empty())
+        primaryPath = doc.loresPath;
+
+    auto scene = make(doc.sceneID, doc.parentID, doc.name, primaryPath, doc.secondaryPath);
+    scene->setIsRoot(doc.isRoot);
+    scene->setIsDiscovered(doc.isDiscovered);
+    scene->setParentPath(doc.parentPath);
+    scene->setNoteTarget(doc.notePath);
+    if (primaryPath != doc.loresPath)
+        scene->setLoresPath(doc.loresPath);
+
+    float hiresScaleX = 1.0f, hiresScaleY = 1.0f;
+    if (mUseHires && doc.hasCanvas)
+    {
+        hiresScaleX = 320.0f / doc.canvasW;
+        hiresScaleY = 240.0f / doc.canvasH;
+    }
+
+    std::vector<int16_t> xs, ys;
+    for (const SceneSaxHandler::PendingZone& z : doc.zones)
+    {
+        bool  useHiresPoints = mUseHires && z.hasHiresKey;
+        int   count          = useHiresPoints ? z.hiresCount : z.loresCount;
+        const std::vector<float>& pts = useHiresPoints ? z.hires : z.lores;
+        float scaleX = useHiresPoints ? hiresScaleX : 1.0f;
+        float scaleY = useHiresPoints ? hiresScaleY : 1.0f;
+
+        if (count == 0)
+        {
+            scene->addZone(Zone::Bounds(z.x, z.y, z.w, z.h), nullptr, nullptr, 0,
+                           z.id, z.target, z.noteTarget, z.label);
+            continue;
+        }
+
+        xs.clear();
+        ys.clear();
+        int minX = 320, minY = 240, maxX = 0, maxY = 0;
+        for (size_t i = 0; i + 1 < pts.size(); i += 2)
+        {
+            int px = (int)(pts[i]     * scaleX);
+            int py = (int)(pts[i + 1] * scaleY);
+            xs.push_back((int16_t)px);
+            ys.push_back((int16_t)py);
+            if (px < minX) minX = px;
+            if (py < minY) minY = py;
+            if (px > maxX) maxX = px;
+            if (py > maxY) maxY = py;
+        }
+        scene->addZone(Zone::Bounds(minX, minY, maxX - minX, maxY - minY),
+                       xs.data(), ys.data(), (int)xs.size(),
+                       z.id, z.target, z.noteTarget, z.label);
+    }
+
+    scene->buildHitIndex();
     return scene;
 }
+
+std::unique_ptr<Scene> SceneFactory::build(const std::string& jsonString)
+{
+    return buildJson(jsonString, [](auto&&... args)
+    {
+        return std::make_unique<Scene>(args...);
+    });
+}
+
+std::shared_ptr<Scene> SceneFactory::build(const std::string& jsonString, SceneArena& arena)
+{
+    return buildJson(jsonString, [&arena](auto&&... args)
+    {
+        return std::allocate_shared<Scene>(ArenaAllocator<Scene>(&arena), args..., &arena);
+    });
+}
+
+template <typename Make>
+auto SceneFactory::buildRecord(const std::string& record, Make make)
+{
+    using Ptr = decltype(make("", "", "", "", ""));
+
+    ByteReader in{ record };
+    for (char c : SceneCompiler::k_Magic)
+        if (in.u8() != static_cast<uint8_t>(c)) return Ptr();
+    if (in.u16() != SceneCompiler::k_Version) return Ptr();
+
+    uint16_t flags       = in.u16();
+    uint16_t stringCount = in.u16();
+    uint16_t zoneCount   = in.u16();
+    in.u32(); // source length and hash, checked by SceneCompiler::isCompiledFrom()
+    in.u32();
+
+    // Strings stay views into the record until the scene copies them. The
+    // table and vertex scratch are kept per thread (the prefetcher builds on
+    // a worker) so steady-state builds reuse their capacity.
+    thread_local std::vector<std::string_view> strings;
+    thread_local std::vector<int16_t>          xs, ys;
+
+    strings.clear();
+    for (uint16_t i = 0; i < stringCount && in.ok; ++i)
+    {
+        strings.push_back(in.view(in.u16()));
+    }
+
+    // Reads a string-table index and resolves it; an out-of-range index
+    // invalidates the record.
+    auto next = [&]() -> std::string_view
+    {
+        uint16_t idx = in.u16();
+        if (idx < strings.size()) return strings[idx];
+        in.ok = false;
+        return {};
+    };
+
+    std::string_view sceneID       = next();
+    std::string_view parentID      = next();
+    std::string_view name          = next();
+    std::string_view loresPath     = next();
+    std::string_view hiresPath     = next();
+    std::string_view secondaryPath = next();
+    std::string_view parentPath    = next();
+    std::string_view notePath      = next();
+    if (!in.ok) return Ptr();
+
+    // Matches buildJson(): a scene without a hi-res image falls back to lores.
+    bool hires = mUseHires && !hiresPath.empty();
+    auto scene = make(sceneID, parentID, name, hires ? hiresPath : loresPath, secondaryPath);
+    scene->setIsRoot((flags & 1) != 0);
+    scene->setIsDiscovered((flags & 2) != 0);
+    scene->setParentPath(parentPath);
+    scene->setNoteTarget(notePath);
+    if (hires && hiresPath != loresPath)
+        scene->setLoresPath(loresPath);
+
+    // Reads one bounds + polygon block; keep = false skips the vertices.
+    auto readGeometry = [&](Zone::Bounds& bounds, bool keep)
+    {
+        bounds.mX = in.i16(); bounds.mY = in.i16();
+        bounds.mW = in.i16(); bounds.mH = in.i16();
+        uint16_t count = in.u16();
+        if (!keep)
+        {
+            in.skip(4u * count);
+            return;
+        }
+        xs.clear();
+        ys.clear();
+        for (uint16_t p = 0; p < count && in.ok; ++p)
+        {
+            xs.push_back(static_cast<int16_t>(in.i16()));
+            ys.push_back(static_cast<int16_t>(in.i16()));
+        }
+    };
+
+    for (uint16_t z = 0; z < zoneCount && in.ok; ++z)
+    {
+        std::string_view zoneID     = next();
+        std::string_view target     = next();
+        std::string_view noteTarget = next();
+        std::string_view label      = next();
+        bool separateHires = (in.u8() & 1) != 0;
+
+        Zone::Bounds bounds(0, 0, 0, 0);
+        Zone::Bounds hiresBounds(0, 0, 0, 0);
+        readGeometry(bounds, !(separateHires && mUseHires));
+        if (separateHires)
+        {
+            readGeometry(hiresBounds, mUseHires);
+            if (mUseHires) bounds = hiresBounds;
+        }
+        if (!in.ok) return Ptr();
+
+        scene->addZone(bounds, xs.data(), ys.data(), (int)xs.size(),
+                       zoneID, target, noteTarget, label);
+    }
+
+    if (!in.ok) return Ptr();
+    scene->buildHitIndex();
+    return scene;
+}
+
+std::unique_ptr<Scene> SceneFactory::buildFromRecord(const std::string& record)
+{
+    return buildRecord(record, [](auto&&... args)
+    {
+        return std::make_unique<Scene>(args...);
+    });
+}
+
+std::shared_ptr<Scene> SceneFactory::buildFromRecord(const std::string& record, SceneArena& arena)
+{
+    return buildRecord(record, [&arena](auto&&... args)
+    {
+        return std::allocate_shared<Scene>(ArenaAllocator<Scene>(&arena), args..., &arena);
+    });
+}
@@ -11,19 +11,51 @@
  * Parses a scene JSON string and constructs a fully populated Scene.
  * Used by GameRunner to build the active scene from file content.
  *
+ * The JSON is streamed rather than loaded into a DOM: only the keys the
+ * current mode reads are kept, so hires_points on lores builds, zone actions
+ * and unknown fields cost nothing beyond the parse itself.
+ *
  * Zone coordinates in JSON must be in 320x240 game space.
  */
 class SceneFactory
 {
 public:
     /**
-     * useHires — if true, primaryPath is read from "hires_image_path";
-     *            if false (default), from "lores_image_path".
+     * useHires — if true, primaryPath is read from "hires_image_path"
+     *            and "lores_image_path" is kept as the scene's loresPath;
+     *            if false (default), primaryPath is "lores_image_path".
      */
     explicit SceneFactory(bool useHires = false);
 
     std::unique_ptr<Scene> build(const std::string& jsonString);
 
+    /**
+     * Build into arena instead of the heap: the Scene object, its strings,
+     * zones and hit index all live in the arena until the returned scene is
+     * destroyed and the arena is reset. The arena must outlive the scene.
+     */
+    std::shared_ptr<Scene> build(const std::string& jsonString, SceneArena& arena);
+
+    /**
+     * Build a Scene from a binary record produced by SceneCompiler, without
+     * parsing any JSON. Returns nullptr if the record is truncated, has the
+     * wrong magic or version, or references an out-of-range string, so the
+     * caller can fall back to build() with the scene JSON.
+     */
+    std::unique_ptr<Scene> buildFromRecord(const std::string& record);
+
+    /**
+     * Arena counterpart of buildFromRecord(). Strings are read in place from
+     * the record, so a warmed-up arena makes this build heap-free.
+     */
+    std::shared_ptr<Scene> buildFromRecord(const std::string& record, SceneArena& arena);
+
 private:
     bool mUseHires;
+
+    // make(sceneID, parentID, name, primaryPath, secondaryPath) allocates the Scene.
+    template <typename Make>
+    auto buildJson(const std::string& jsonString, Make make);
+    template <typename Make>
+    auto buildRecord(const std::string& record, Make make);
 };
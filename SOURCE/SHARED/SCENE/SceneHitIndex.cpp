@@ -0,0 +1,132 @@
+#include "SceneHitIndex.h"
+#include "../ZONE/ZoneTable.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Polygons up to this many vertices sort their crossings in a stack buffer;
+// larger ones fall back to the heap for the duration of build().
+constexpr int k_StackCrossings = 64;
+
+// Marks the x samples of row y covered by zone, mirroring Zone::containsPoint:
+// inclusive AABB cull, then an even-odd count of the edges whose crossing lies
+// strictly right of x. Crossings use the exact expression containsPoint does,
+// so every sample agrees with the ray-cast bit for bit.
+// crossings must hold one float per polygon vertex.
+void markRow(ZoneTable::ZoneView zone, int y, int zoneIndex, int* owner, float* crossings)
+{
+    const Zone::Bounds& b = zone.getBounds();
+    if (y < b.mY || y > b.mY + b.mH) return;
+
+    int xLo = std::max(0, b.mX);
+    int xHi = std::min(SceneHitIndex::k_MaxX, b.mX + b.mW);
+    if (xLo > xHi) return;
+
+    ZoneTable::PolygonView poly = zone.getPolygon();
+    if (poly.empty())
+    {
+        for (int x = xLo; x <= xHi; ++x)
+            if (owner[x] < 0) owner[x] = zoneIndex;
+        return;
+    }
+
+    size_t count = 0;
+    int n = poly.size();
+    for (int i = 0, j = n - 1; i < n; j = i++)
+    {
+        int xi = poly.x(i), yi = poly.y(i);
+        int xj = poly.x(j), yj = poly.y(j);
+        if ((yi > y) != (yj > y))
+            crossings[count++] = (xj - xi) * (float)(y - yi) / (yj - yi) + xi;
+    }
+    std::sort(crossings, crossings + count);
+
+    // Sweep left to right; x is inside when an odd number of crossings lie
+    // strictly to its right.
+    size_t passed = 0;
+    for (int x = xLo; x <= xHi; ++x)
+    {
+        while (passed < count && !(x < crossings[passed]))
+            ++passed;
+        if (((count - passed) & 1) && owner[x] < 0)
+            owner[x] = zoneIndex;
+    }
+}
+} // namespace
+
+SceneHitIndex::SceneHitIndex(SceneArena* arena)
+: mRowStart(arena)
+, mSpans(arena)
+{
+}
+
+void SceneHitIndex::build(const ZoneTable& zones)
+{
+    clear();
+    if (zones.size() > UINT16_MAX) return;
+
+    SceneArena* arena = mRowStart.get_allocator().arena();
+    mRowStart.reserve(k_MaxY + 2);
+
+    // Build scratch stays off the arena so it does not count toward the
+    // scene's footprint there.
+    int owner[k_MaxX + 1];
+    int maxVertices = 0;
+    for (size_t z = 0; z < zones.size(); ++z)
+        maxVertices = std::max(maxVertices, (int)zones[z].getPolygon().size());
+    float              stackCrossings[k_StackCrossings];
+    std::vector<float> heapCrossings(maxVertices > k_StackCrossings ? maxVertices : 0);
+    float* crossings = heapCrossings.empty() ? stackCrossings : heapCrossings.data();
+
+    for (int y = 0; y <= k_MaxY; ++y)
+    {
+        mRowStart.push_back((uint16_t)mSpans.size());
+        std::fill(owner, owner + k_MaxX + 1, k_NoZone);
+        for (size_t z = 0; z < zones.size(); ++z)
+            markRow(zones[z], y, (int)z, owner, crossings);
+
+        for (int x = 0; x <= k_MaxX; )
+        {
+            int zone  = owner[x];
+            int start = x;
+            while (x <= k_MaxX && owner[x] == zone) ++x;
+            if (zone != k_NoZone)
+                mSpans.push_back({ (int16_t)start, (int16_t)(x - 1), (uint16_t)zone });
+        }
+        if (mSpans.size() > UINT16_MAX)
+        {
+            clear();
+            return;
+        }
+    }
+    mRowStart.push_back((uint16_t)mSpans.size());
+    if (!arena) mSpans.shrink_to_fit(); // an arena copy would only waste space
+}
+
+void SceneHitIndex::clear()
+{
+    mRowStart.clear();
+    mRowStart.shrink_to_fit();
+    mSpans.clear();
+    mSpans.shrink_to_fit();
+}
+
+int SceneHitIndex::lookup(int x, int y) const
+{
+    if (!isBuilt() || x < 0 || x > k_MaxX || y < 0 || y > k_MaxY)
+        return k_NotIndexed;
+
+    auto first = mSpans.begin() + mRowStart[y];
+    auto last  = mSpans.begin() + mRowStart[y + 1];
+    auto it    = std::upper_bound(first, last, x,
+                                  [](int px, const Span& s) { return px < s.x0; });
+    if (it == first) return k_NoZone;
+    --it;
+    return x <= it->x1 ? (int)it->zone : k_NoZone;
+}
+
+size_t SceneHitIndex::memoryBytes() const
+{
+    return mRowStart.capacity() * sizeof(uint16_t) + mSpans.capacity() * sizeof(Span);
+}
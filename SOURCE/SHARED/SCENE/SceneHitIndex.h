@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SceneArena.h"
+
+class ZoneTable;
+
+/**
+ * Precomputed zone lookup for the 320x240 game space, built once per scene so a
+ * tap resolves to its zone without running every zone's ray-cast.
+ *
+ * Stored as per-scanline span lists: for each row y in [0, 240], a sorted list
+ * of inclusive x ranges tagged with the index of the first zone (in scene
+ * order) that contains them. Spans are derived from the same edge-crossing
+ * expression Zone::containsPoint uses, so lookups match first-match scanning
+ * exactly. A full-resolution zone-ID raster would be ~77 KB; a downsampled
+ * one needs a fallback for mixed cells. Spans for typical scenes stay in the
+ * low kilobytes and need no fallback.
+ *
+ * Points outside [0, 320] x [0, 240] are not indexed; lookup() reports
+ * k_NotIndexed and the caller falls back to scanning.
+ *
+ * Storage comes from the given SceneArena or the heap if none. Build scratch
+ * lives on the stack (about 1.5 KB), spilling to the heap only for polygons
+ * of more than 64 vertices.
+ */
+class SceneHitIndex
+{
+public:
+    static constexpr int k_MaxX       = 320;
+    static constexpr int k_MaxY       = 240;
+    static constexpr int k_NoZone     = -1;
+    static constexpr int k_NotIndexed = -2;
+
+    explicit SceneHitIndex(SceneArena* arena = nullptr);
+
+    void build(const ZoneTable& zones);
+    void clear();
+    bool isBuilt() const { return !mRowStart.empty(); }
+
+    /**
+     * Index of the first zone containing (x, y), k_NoZone if none, or
+     * k_NotIndexed if the index is not built or the point is out of range.
+     */
+    int lookup(int x, int y) const;
+
+    size_t memoryBytes() const;
+
+private:
+    struct Span
+    {
+        int16_t  x0;   // inclusive
+        int16_t  x1;   // inclusive
+        uint16_t zone;
+    };
+
+    ArenaVector<uint16_t> mRowStart; // k_MaxY + 2 entries; row y spans [mRowStart[y], mRowStart[y + 1])
+    ArenaVector<Span>     mSpans;
+};
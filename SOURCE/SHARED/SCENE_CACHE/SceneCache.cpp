@@ -0,0 +1,88 @@
+#include "SceneCache.h"
+#include "../SCENE/Scene.h"
+
+SceneCache::SceneCache(size_t budgetBytes)
+{
+    mStats.budgetBytes = budgetBytes;
+}
+
+std::shared_ptr<Scene> SceneCache::find(const std::string& path)
+{
+    auto it = mIndex.find(path);
+    if (it == mIndex.end())
+    {
+        mStats.misses++;
+        return nullptr;
+    }
+    mStats.hits++;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return it->second->scene;
+}
+
+bool SceneCache::contains(const std::string& path) const
+{
+    return mIndex.count(path) != 0;
+}
+
+std::shared_ptr<Scene> SceneCache::peek(const std::string& path) const
+{
+    auto it = mIndex.find(path);
+    return it != mIndex.end() ? it->second->scene : nullptr;
+}
+
+void SceneCache::insert(const std::string& path, std::shared_ptr<Scene> scene)
+{
+    invalidate(path);
+    if (!scene) return;
+
+    size_t bytes = scene->estimateBytes();
+    if (bytes > mStats.budgetBytes) return;
+
+    evictToFit(bytes);
+    mEntries.push_front({ path, std::move(scene), bytes });
+    mIndex[path] = mEntries.begin();
+    mStats.bytesUsed += bytes;
+    mStats.entries    = mEntries.size();
+}
+
+void SceneCache::invalidate(const std::string& path)
+{
+    auto it = mIndex.find(path);
+    if (it == mIndex.end()) return;
+    mStats.bytesUsed -= it->second->bytes;
+    mEntries.erase(it->second);
+    mIndex.erase(it);
+    mStats.entries = mEntries.size();
+}
+
+void SceneCache::clear()
+{
+    mEntries.clear();
+    mIndex.clear();
+    mStats.bytesUsed = 0;
+    mStats.entries   = 0;
+}
+
+void SceneCache::setBudget(size_t budgetBytes)
+{
+    mStats.budgetBytes = budgetBytes;
+    evictToFit(0);
+}
+
+SceneCache::Stats SceneCache::getStats() const
+{
+    return mStats;
+}
+
+void SceneCache::evictToFit(size_t incomingBytes)
+{
+    while (!mEntries.empty() && mStats.bytesUsed + incomingBytes > mStats.budgetBytes)
+    {
+        Entry& lru = mEntries.back();
+        mStats.bytesUsed -= lru.bytes;
+        mIndex.erase(lru.path);
+        mEntries.pop_back();
+        mStats.evictions++;
+    }
+    mStats.entries = mEntries.size();
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class Scene;
+
+/**
+ * Bounded LRU cache of built Scenes, keyed by data-root-relative scene path.
+ * Lets GameRunner revisit a scene (navigateUp, switchToLocations, back and
+ * forth between drawers) without re-reading or re-parsing it.
+ *
+ * Size is tracked with Scene::estimateBytes(). Inserting past the budget evicts
+ * least-recently-used entries; a scene larger than the whole budget is not
+ * cached at all, so a budget of 0 disables caching.
+ *
+ * Scenes are shared with the caller, so an entry must be invalidated whenever
+ * the file it was built from is rewritten. (Discovery does not need this:
+ * GameRunner flips isDiscovered on the shared scene and on every rebuild.)
+ */
+class SceneCache
+{
+public:
+    struct Stats
+    {
+        size_t hits        = 0;
+        size_t misses      = 0;
+        size_t evictions   = 0;
+        size_t entries     = 0;
+        size_t bytesUsed   = 0;
+        size_t budgetBytes = 0;
+    };
+
+    explicit SceneCache(size_t budgetBytes);
+
+    /**
+     * Return the cached scene for path and mark it most recently used, or
+     * nullptr on a miss. Updates the hit/miss counters.
+     */
+    std::shared_ptr<Scene> find(const std::string& path);
+
+    /** True if path is cached. Does not touch LRU order or counters. */
+    bool contains(const std::string& path) const;
+
+    /** The cached scene for path, or nullptr. Does not touch LRU order or counters. */
+    std::shared_ptr<Scene> peek(const std::string& path) const;
+
+    /** Insert or replace the entry for path, evicting LRU entries to fit. */
+    void insert(const std::string& path, std::shared_ptr<Scene> scene);
+
+    /** Drop the entry for path, if any. */
+    void invalidate(const std::string& path);
+
+    void clear();
+
+    /** Change the byte budget, evicting immediately if it shrank. */
+    void  setBudget(size_t budgetBytes);
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        std::string            path;
+        std::shared_ptr<Scene> scene;
+        size_t                 bytes = 0;
+    };
+
+    void evictToFit(size_t incomingBytes);
+
+    std::list<Entry>                                            mEntries; // front = most recently used
+    std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+    Stats                                                       mStats;
+};
@@ -0,0 +1,147 @@
+#include "ScenePrefetcher.h"
+#include "SceneCache.h"
+#include "../SCENE/Scene.h"
+
+ScenePrefetcher::ScenePrefetcher(Loader loader, bool background)
+: mLoader(std::move(loader))
+, mBackground(background && KSC_HAS_THREADS)
+{
+#if KSC_HAS_THREADS
+    if (mBackground)
+        mWorker = std::thread(&ScenePrefetcher::workerLoop, this);
+#endif
+}
+
+ScenePrefetcher::~ScenePrefetcher()
+{
+#if KSC_HAS_THREADS
+    if (mWorker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mWake.notify_all();
+        mWorker.join();
+    }
+#endif
+}
+
+void ScenePrefetcher::schedule(const std::vector<std::string>& paths, int budget,
+                               const std::function<bool(const std::string&)>& skip)
+{
+    std::deque<Job> jobs;
+    for (const std::string& path : paths)
+    {
+        if ((int)jobs.size() >= budget) break;
+        if (path.empty() || mDeclined.count(path) || skip(path)) continue;
+        bool duplicate = false;
+        for (const Job& j : jobs)
+            duplicate = duplicate || j.path == path;
+        if (duplicate) continue;
+        jobs.push_back({ path, mEpoch, nullptr });
+    }
+    mStats.scheduled += jobs.size();
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending = std::move(jobs);
+    }
+    mWake.notify_one();
+}
+
+bool ScenePrefetcher::runIdleSlice()
+{
+    if (mBackground) return false;
+    Job job;
+    if (!popPending(job)) return false;
+    job.scene = mLoader(job.path);
+    pushDone(std::move(job));
+    return true;
+}
+
+void ScenePrefetcher::drainInto(SceneCache& cache)
+{
+    std::deque<Job> done;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        done.swap(mDone);
+    }
+    for (Job& job : done)
+    {
+        if (!job.scene || job.epoch != mEpoch)
+        {
+            mStats.dropped++;
+            continue;
+        }
+        cache.insert(job.path, std::move(job.scene));
+        if (!cache.contains(job.path))
+        {
+            // Larger than the whole budget: rebuilding it would be wasted too.
+            mDeclined.insert(job.path);
+            mStats.dropped++;
+            continue;
+        }
+        mUnused.insert(job.path);
+        mStats.completed++;
+    }
+}
+
+void ScenePrefetcher::invalidate()
+{
+    mEpoch++;
+    mUnused.clear();
+    mDeclined.clear();
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPending.clear();
+}
+
+void ScenePrefetcher::noteLoaded(const std::string& path)
+{
+    if (mUnused.erase(path) > 0)
+        mStats.used++;
+}
+
+void ScenePrefetcher::noteBuilt(const std::string& path)
+{
+    mUnused.erase(path);
+}
+
+void ScenePrefetcher::forgetDeclined()
+{
+    mDeclined.clear();
+}
+
+bool ScenePrefetcher::popPending(Job& job)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mPending.empty()) return false;
+    job = std::move(mPending.front());
+    mPending.pop_front();
+    return true;
+}
+
+void ScenePrefetcher::pushDone(Job job)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDone.push_back(std::move(job));
+}
+
+void ScenePrefetcher::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mWake.wait(lock, [this] { return mStopping || !mPending.empty(); });
+        if (mStopping) return;
+
+        Job job = std::move(mPending.front());
+        mPending.pop_front();
+
+        lock.unlock();
+        job.scene = mLoader(job.path);
+        lock.lock();
+
+        mDone.push_back(std::move(job));
+    }
+}
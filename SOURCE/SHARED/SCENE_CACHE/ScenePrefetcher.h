@@ -0,0 +1,120 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "../UTIL/KSC_Threads.h"
+
+class Scene;
+class SceneCache;
+
+/**
+ * Builds the scenes a player can reach next (the active scene's zone targets)
+ * ahead of time and hands them to the SceneCache, so the next tap finds its
+ * scene already built.
+ *
+ * Two modes:
+ *   background - a worker thread runs the loader (desktop builds).
+ *   idle       - runIdleSlice() builds one scene per call from the main loop
+ *                (single-threaded builds, e.g. ESP32).
+ *
+ * The loader is called off the main thread in background mode, so it must only
+ * read storage. Finished scenes are handed over on the main thread by
+ * drainInto(); results scheduled before an invalidate() are dropped so a
+ * build from a replaced session never reaches the cache. A scene the cache
+ * declines (larger than its whole budget) is dropped too, and its path is
+ * not scheduled again until forgetDeclined() or invalidate().
+ */
+class ScenePrefetcher
+{
+public:
+    using Loader = std::function<std::shared_ptr<Scene>(const std::string& path)>;
+
+    struct Stats
+    {
+        size_t scheduled = 0; // targets queued for prefetch
+        size_t completed = 0; // scenes built and inserted into the cache
+        size_t used      = 0; // prefetched scenes later loaded by the player
+        size_t dropped   = 0; // results discarded as stale, unbuildable or declined by the cache
+    };
+
+    ScenePrefetcher(Loader loader, bool background);
+    ~ScenePrefetcher();
+
+    ScenePrefetcher(const ScenePrefetcher&)            = delete;
+    ScenePrefetcher& operator=(const ScenePrefetcher&) = delete;
+
+    /**
+     * Replace any pending work with up to budget of the given paths. Paths for
+     * which skip() returns true (typically: already cached), and paths the
+     * cache has declined, are not queued.
+     */
+    void schedule(const std::vector<std::string>& paths, int budget,
+                  const std::function<bool(const std::string&)>& skip);
+
+    /** Build one pending scene on the calling thread. Returns false if idle. */
+    bool runIdleSlice();
+
+    /** Move finished scenes into the cache. Main thread only. */
+    void drainInto(SceneCache& cache);
+
+    /**
+     * Drop all pending work and every result still in flight, e.g. when a
+     * save slot replaces the session the cache was built for.
+     */
+    void invalidate();
+
+    /**
+     * Record that path was just served from the cache. Counts as used if the
+     * cached scene came from a prefetch that had not been used yet.
+     */
+    void noteLoaded(const std::string& path);
+
+    /**
+     * Record that path missed the cache and was built on demand, so a
+     * prefetched copy, if any, was evicted without being used.
+     */
+    void noteBuilt(const std::string& path);
+
+    /** Let declined paths be scheduled again, e.g. after the cache budget changed. */
+    void forgetDeclined();
+
+    bool  isBackground() const { return mBackground; }
+    Stats getStats()     const { return mStats; }
+
+private:
+    struct Job
+    {
+        std::string            path;
+        unsigned               epoch = 0;
+        std::shared_ptr<Scene> scene;
+    };
+
+    bool popPending(Job& job);
+    void pushDone(Job job);
+    void workerLoop();
+
+    Loader mLoader;
+    bool   mBackground;
+    Stats  mStats;
+
+    // Main thread only.
+    unsigned                        mEpoch = 0; // bumped by invalidate()
+    std::unordered_set<std::string> mUnused;   // prefetched and still cached, not yet loaded
+    std::unordered_set<std::string> mDeclined; // prefetched scenes the cache would not hold
+
+    // Shared with the worker; guarded by mMutex.
+    std::deque<Job>         mPending;
+    std::deque<Job>         mDone;
+    std::mutex              mMutex;
+    std::condition_variable mWake;
+    bool                    mStopping = false;
+#if KSC_HAS_THREADS
+    std::thread             mWorker;
+#endif
+};
@@ -1,7 +1,8 @@
 #include "SceneView.h"
 #include "../GRAPHICS_RENDERER/GraphicsRenderer.h"
 #include "../SCENE/Scene.h"
-#include "../ZONE/Zone.h"
+#include "../ZONE/ZoneTable.h"
+#include <string_view>
 
 static const int CONTENT_X = 0;
 static const int CONTENT_Y = 15;
@@ -13,13 +14,12 @@ SceneView::SceneView(GraphicsRenderer& renderer)
 {
 }
 
-static bool endsWith(const std::string& s, const std::string& suffix)
+static bool endsWith(std::string_view s, std::string_view suffix)
 {
-    if (s.size() < suffix.size()) return false;
-    return s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
 }
 
-static void drawPath(GraphicsRenderer& renderer, const std::string& path, int x, int y)
+static void drawPath(GraphicsRenderer& renderer, std::string_view path, int x, int y)
 {
     if (path.empty()) return;
 
@@ -33,14 +33,14 @@ static void drawPath(GraphicsRenderer& renderer, const std::string& path, int x,
 
 void SceneView::draw(const Scene& scene, bool overlayVisible, bool zoneDisplayVisible)
 {
-    const std::string& primary = scene.getPrimaryPath();
+    std::string_view primary = scene.getPrimaryPath();
 
     if (primary.empty())
     {
         mRenderer.beginContentArea(CONTENT_X, CONTENT_Y, CONTENT_W, CONTENT_H);
-        for (auto zone : scene.getZones())
+        for (const auto& zone : scene.getZones())
         {
-            Zone::Bounds b = zone.getBounds();
+            const Zone::Bounds& b = zone.getBounds();
             mRenderer.drawButton(zone.getLabel(), b.mX, b.mY, b.mW, b.mH);
         }
         mRenderer.endContentArea();
@@ -49,7 +49,11 @@ void SceneView::draw(const Scene& scene, bool overlayVisible, bool zoneDisplayVi
 
     if (endsWith(primary, ".png"))
     {
-        drawPath(mRenderer, primary, 0, 0);
+        std::string_view lores = scene.getLoresPath();
+        if (lores.empty())
+            drawPath(mRenderer, primary, 0, 0);
+        else
+            mRenderer.drawProgressiveImage(primary, lores);
     }
     else
     {
@@ -67,13 +71,16 @@ void SceneView::draw(const Scene& scene, bool overlayVisible, bool zoneDisplayVi
 
     if (zoneDisplayVisible)
     {
-        for (auto zone : scene.getZones())
+        for (const auto& zone : scene.getZones())
         {
             if (zone.hasPolygon())
-                mRenderer.drawPolygon(zone.getPolygon());
+            {
+                ZoneTable::PolygonView poly = zone.getPolygon();
+                mRenderer.drawPolygon(poly.xs(), poly.ys(), poly.size());
+            }
             else
             {
-                Zone::Bounds b = zone.getBounds();
+                const Zone::Bounds& b = zone.getBounds();
                 mRenderer.drawRect(b.mX, b.mY, b.mW, b.mH);
             }
         }
@@ -83,9 +90,9 @@ void SceneView::draw(const Scene& scene, bool overlayVisible, bool zoneDisplayVi
 void SceneView::drawMenu(const Scene& menuScene)
 {
     mRenderer.beginContentArea(CONTENT_X, CONTENT_Y, CONTENT_W, CONTENT_H);
-    for (auto zone : menuScene.getZones())
+    for (const auto& zone : menuScene.getZones())
     {
-        Zone::Bounds b = zone.getBounds();
+        const Zone::Bounds& b = zone.getBounds();
         mRenderer.drawButton(zone.getLabel(), b.mX, b.mY, b.mW, b.mH);
     }
     mRenderer.endContentArea();
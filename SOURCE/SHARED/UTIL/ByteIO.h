@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Little-endian integer encoding shared by the binary formats: the discovery
+ * journal, the slot container and compiled scene records. All three are
+ * stored, so the byte order must never change.
+ */
+
+// Appends little-endian integers to out; raw bytes are appended to out directly.
+struct ByteWriter
+{
+    std::string& out;
+
+    void u8(uint8_t v)   { out.push_back(static_cast<char>(v)); }
+    void u16(uint16_t v) { u8(v & 0xFF); u8(v >> 8); }
+    void u32(uint32_t v) { u16(v & 0xFFFF); u16(v >> 16); }
+    void i16(int v)      { u16(static_cast<uint16_t>(static_cast<int16_t>(v))); }
+};
+
+// Bounds-checked reader over data. Any read past the end latches ok = false
+// and returns zero or empty, so a caller can read a whole block and check ok
+// once.
+struct ByteReader
+{
+    std::string_view data;
+    size_t           pos = 0;
+    bool             ok  = true;
+
+    uint8_t u8()
+    {
+        if (pos + 1 > data.size()) { ok = false; return 0; }
+        return static_cast<uint8_t>(data[pos++]);
+    }
+    uint16_t u16()
+    {
+        uint16_t lo = u8();
+        uint16_t hi = u8();
+        return static_cast<uint16_t>(lo | (hi << 8));
+    }
+    uint32_t u32()
+    {
+        uint32_t lo = u16();
+        uint32_t hi = u16();
+        return lo | (hi << 16);
+    }
+    int i16() { return static_cast<int16_t>(u16()); }
+
+    // The next n bytes as a view into data.
+    std::string_view view(size_t n)
+    {
+        if (n > data.size() - pos) { ok = false; return {}; }
+        pos += n;
+        return data.substr(pos - n, n);
+    }
+    std::string bytes(size_t n) { return std::string(view(n)); }
+    void        skip(size_t n)  { view(n); }
+};
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+static constexpr uint32_t k_Fnv1a32Offset = 2166136261u;
+
+/**
+ * 32-bit FNV-1a over length bytes at data. Pass a previous result as hash to
+ * continue it over more bytes. Used for the slot container checksum, note
+ * blob names, the scene-ID table hash and the source stamp in compiled scene
+ * records, all of which are stored, so the function must never change.
+ */
+inline uint32_t fnv1a32(const void* data, size_t length, uint32_t hash = k_Fnv1a32Offset)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; ++i)
+        hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+/**
+ * KSC_HAS_THREADS is 1 where std::thread is available (desktop builds) and 0
+ * on ESP32, where background work runs from idle() instead. Define it on the
+ * command line to override.
+ */
+#ifndef KSC_HAS_THREADS
+  #ifdef ARDUINO
+    #define KSC_HAS_THREADS 0
+  #else
+    #define KSC_HAS_THREADS 1
+  #endif
+#endif
+
+#if KSC_HAS_THREADS
+  #include <thread>
+#endif
@@ -0,0 +1,108 @@
+#include "PolygonKernel.h"
+
+#if defined(__AVX2__)
+  #define KSC_POLYGON_KERNEL_AVX2 1
+  #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+  #define KSC_POLYGON_KERNEL_SSE2 1
+  #include <emmintrin.h>
+#endif
+
+namespace
+{
+// Parity of edge i (from vertex i-1, or n-1 for i = 0), one edge at a time.
+inline bool crosses(const int16_t* xs, const int16_t* ys, int i, int j, int x, int y)
+{
+    int xi = xs[i], yi = ys[i];
+    int xj = xs[j], yj = ys[j];
+    return (yi > y) != (yj > y) &&
+           x < (xj - xi) * (float)(y - yi) / (yj - yi) + xi;
+}
+
+// Parity of the set bits of a 4-bit mask.
+inline int parity4(int mask) { return (0x6996 >> (mask & 0xF)) & 1; }
+
+#if KSC_POLYGON_KERNEL_SSE2
+// Sign-extend 4 consecutive int16 values to int32 lanes.
+inline __m128i load4(const int16_t* p)
+{
+    __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+    return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+#endif
+} // namespace
+
+const char* PolygonKernel::backendName()
+{
+#if KSC_POLYGON_KERNEL_AVX2
+    return "AVX2";
+#elif KSC_POLYGON_KERNEL_SSE2
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+bool PolygonKernel::containsScalar(const int16_t* xs, const int16_t* ys, int n, int x, int y)
+{
+    bool inside = false;
+    for (int i = 0, j = n - 1; i < n; j = i++)
+        if (crosses(xs, ys, i, j, x, y))
+            inside = !inside;
+    return inside;
+}
+
+bool PolygonKernel::contains(const int16_t* xs, const int16_t* ys, int n, int x, int y)
+{
+    if (n <= 0) return false;
+
+    // Edge 0 closes the polygon (vertex n-1 to 0); every later edge i runs
+    // from vertex i-1 to i, so its endpoints are two overlapping loads.
+    int parity = crosses(xs, ys, 0, n - 1, x, y) ? 1 : 0;
+    int i      = 1;
+
+#if KSC_POLYGON_KERNEL_AVX2
+    const __m256  px = _mm256_set1_ps((float)x);
+    const __m256i py = _mm256_set1_epi32(y);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i xi = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + i)));
+        __m256i yi = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + i)));
+        __m256i xj = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + i - 1)));
+        __m256i yj = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + i - 1)));
+
+        __m256i straddle = _mm256_xor_si256(_mm256_cmpgt_epi32(yi, py), _mm256_cmpgt_epi32(yj, py));
+        __m256  num      = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(xj, xi)),
+                                         _mm256_cvtepi32_ps(_mm256_sub_epi32(py, yi)));
+        __m256  cross    = _mm256_add_ps(_mm256_div_ps(num, _mm256_cvtepi32_ps(_mm256_sub_epi32(yj, yi))),
+                                         _mm256_cvtepi32_ps(xi));
+        __m256  hit      = _mm256_and_ps(_mm256_cmp_ps(px, cross, _CMP_LT_OQ), _mm256_castsi256_ps(straddle));
+        int     mask     = _mm256_movemask_ps(hit);
+        parity ^= parity4(mask ^ (mask >> 4));
+    }
+#elif KSC_POLYGON_KERNEL_SSE2
+    const __m128  px = _mm_set1_ps((float)x);
+    const __m128i py = _mm_set1_epi32(y);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i xi = load4(xs + i);
+        __m128i yi = load4(ys + i);
+        __m128i xj = load4(xs + i - 1);
+        __m128i yj = load4(ys + i - 1);
+
+        __m128i straddle = _mm_xor_si128(_mm_cmpgt_epi32(yi, py), _mm_cmpgt_epi32(yj, py));
+        __m128  num      = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(xj, xi)),
+                                      _mm_cvtepi32_ps(_mm_sub_epi32(py, yi)));
+        __m128  cross    = _mm_add_ps(_mm_div_ps(num, _mm_cvtepi32_ps(_mm_sub_epi32(yj, yi))),
+                                      _mm_cvtepi32_ps(xi));
+        __m128  hit      = _mm_and_ps(_mm_cmplt_ps(px, cross), _mm_castsi128_ps(straddle));
+        parity ^= parity4(_mm_movemask_ps(hit));
+    }
+#endif
+
+    for (; i < n; ++i)
+        if (crosses(xs, ys, i, i - 1, x, y))
+            parity ^= 1;
+
+    return parity != 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Even-odd ray-cast point-in-polygon test over planar int16 vertex arrays
+ * (the ZoneTable layout), evaluated several edges at a time.
+ *
+ * The backend is chosen at compile time:
+ *   AVX2   - 8 edges per step (desktop builds with KSC_ENABLE_AVX2)
+ *   SSE2   - 4 edges per step (any x86-64 desktop build)
+ *   Scalar - one edge per step (ESP32 and other targets)
+ *
+ * Every backend evaluates the same crossing expression as Zone::containsPoint,
+ * x < (xj - xi) * (float)(y - yi) / (yj - yi) + xi, with IEEE single-precision
+ * multiply, divide and add, so all backends agree bit for bit. No AABB cull is
+ * done here; callers cull first.
+ */
+class PolygonKernel
+{
+public:
+    /** Name of the compiled-in backend: "AVX2", "SSE2" or "Scalar". */
+    static const char* backendName();
+
+    /** True if (x, y) is inside the n-point polygon (xs[i], ys[i]). */
+    static bool contains(const int16_t* xs, const int16_t* ys, int n, int x, int y);
+
+    /** Reference one-edge-at-a-time version of contains(). */
+    static bool containsScalar(const int16_t* xs, const int16_t* ys, int n, int x, int y);
+};
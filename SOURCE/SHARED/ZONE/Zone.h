@@ -38,6 +38,8 @@ public:
         , mH(other.mH)
         {
         }
+
+        Bounds& operator=(const Bounds& other) = default;
     };
 
     using Point   = std::pair<int, int>;
@@ -51,12 +53,12 @@ public:
     bool           hasPolygon()          const { return !mPolygon.empty(); }
     const Polygon& getPolygon()          const { return mPolygon; }
 
-    const std::string getZoneID()     const { return mZoneID; }
-    const std::string getSceneID()    const { return mSceneID; }
-    const std::string getTarget()     const { return mTarget; }
-    const std::string getNoteTarget() const { return mNoteTarget; }
-    const std::string getLabel()      const { return mLabel; }
-    Bounds            getBounds()     const { return mBounds; }
+    const std::string& getZoneID()     const { return mZoneID; }
+    const std::string& getSceneID()    const { return mSceneID; }
+    const std::string& getTarget()     const { return mTarget; }
+    const std::string& getNoteTarget() const { return mNoteTarget; }
+    const std::string& getLabel()      const { return mLabel; }
+    const Bounds&      getBounds()     const { return mBounds; }
 private:
     std::string mSceneID;    // ID of the scene this zone belongs to
     Bounds      mBounds;
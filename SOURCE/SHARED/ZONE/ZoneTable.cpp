@@ -0,0 +1,124 @@
+#include "ZoneTable.h"
+#include "PolygonKernel.h"
+#include <algorithm>
+
+Zone::Polygon ZoneTable::PolygonView::toPolygon() const
+{
+    Zone::Polygon poly;
+    poly.reserve(mCount);
+    for (int i = 0; i < mCount; ++i)
+        poly.push_back({ x(i), y(i) });
+    return poly;
+}
+
+bool ZoneTable::PolygonView::operator==(const PolygonView& other) const
+{
+    if (mCount != other.mCount) return false;
+    for (int i = 0; i < mCount * 2; ++i)
+        if (mXs[i] != other.mXs[i]) return false;
+    return true;
+}
+
+ZoneTable::ZoneTable(SceneArena* arena)
+: mBounds(arena)
+, mPolygonStart(1, 0, arena)
+, mVertices(arena)
+, mStrings(arena)
+, mStringPool(arena)
+, mStringStart(1, 0, arena)
+, mStringOrder(arena)
+{
+}
+
+void ZoneTable::add(const Zone& zone)
+{
+    mBounds.push_back(zone.getBounds());
+
+    const Zone::Polygon& poly = zone.getPolygon();
+    for (const auto& p : poly) mVertices.push_back(static_cast<int16_t>(p.first));
+    for (const auto& p : poly) mVertices.push_back(static_cast<int16_t>(p.second));
+    mPolygonStart.push_back(static_cast<uint32_t>(mVertices.size()));
+
+    mStrings.push_back({ intern(zone.getSceneID()),
+                         intern(zone.getZoneID()),
+                         intern(zone.getTarget()),
+                         intern(zone.getNoteTarget()),
+                         intern(zone.getLabel()) });
+}
+
+void ZoneTable::add(const Zone::Bounds& bounds, const int16_t* xs, const int16_t* ys, int count,
+                    std::string_view sceneID, std::string_view zoneID, std::string_view target,
+                    std::string_view noteTarget, std::string_view label)
+{
+    mBounds.push_back(bounds);
+
+    mVertices.insert(mVertices.end(), xs, xs + count);
+    mVertices.insert(mVertices.end(), ys, ys + count);
+    mPolygonStart.push_back(static_cast<uint32_t>(mVertices.size()));
+
+    mStrings.push_back({ intern(sceneID), intern(zoneID), intern(target),
+                         intern(noteTarget), intern(label) });
+}
+
+void ZoneTable::clear()
+{
+    *this = ZoneTable(mBounds.get_allocator().arena());
+}
+
+ZoneTable::PolygonView ZoneTable::polygon(size_t zone) const
+{
+    uint32_t start = mPolygonStart[zone];
+    int      count = static_cast<int>(mPolygonStart[zone + 1] - start) / 2;
+    return { mVertices.data() + start, count };
+}
+
+bool ZoneTable::containsPoint(size_t zone, int x, int y) const
+{
+    // Coarse AABB cull first.
+    const Zone::Bounds& b = mBounds[zone];
+    if (x < b.mX || x > b.mX + b.mW ||
+        y < b.mY || y > b.mY + b.mH)
+        return false;
+
+    PolygonView poly = polygon(zone);
+    if (poly.empty())
+        return true; // rect-only zone
+
+    // Ray-cast point-in-polygon test over the planar vertex arrays.
+    return PolygonKernel::contains(poly.xs(), poly.ys(), poly.size(), x, y);
+}
+
+size_t ZoneTable::memoryBytes() const
+{
+    return mBounds.capacity()       * sizeof(Zone::Bounds)
+         + mPolygonStart.capacity() * sizeof(uint32_t)
+         + mVertices.capacity()     * sizeof(int16_t)
+         + mStrings.capacity()      * sizeof(ZoneStrings)
+         + mStringPool.capacity()
+         + mStringStart.capacity()  * sizeof(uint32_t)
+         + mStringOrder.capacity()  * sizeof(uint16_t);
+}
+
+uint16_t ZoneTable::intern(std::string_view s)
+{
+    // Lookups binary-search the sorted indices, so finding a repeated string
+    // costs O(log n) comparisons. Inserting a new one shifts the index array,
+    // making a build O(n^2) in distinct strings, but only in 2-byte moves:
+    // the strings are deduplicated as zones are added, so there is no later
+    // point to sort at, and a scene holds a few hundred at most.
+    auto it = std::lower_bound(mStringOrder.begin(), mStringOrder.end(), s,
+                               [this](uint16_t i, std::string_view v) { return string(i) < v; });
+    if (it != mStringOrder.end() && string(*it) == s) return *it;
+
+    uint16_t index = static_cast<uint16_t>(mStringStart.size() - 1);
+    mStringPool.append(s.data(), s.size());
+    mStringStart.push_back(static_cast<uint32_t>(mStringPool.size()));
+    mStringOrder.insert(it, index);
+    return index;
+}
+
+std::string_view ZoneTable::string(uint16_t index) const
+{
+    return std::string_view(mStringPool).substr(mStringStart[index],
+                                                mStringStart[index + 1] - mStringStart[index]);
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Zone.h"
+#include "../SCENE/SceneArena.h"
+
+/**
+ * Packed structure-of-arrays storage for a scene's zones, so hit testing and
+ * the zone overlay walk a few contiguous buffers instead of one heap block
+ * per polygon and string.
+ *
+ *   bounds   - one Zone::Bounds per zone, in scene order
+ *   vertices - every polygon in one int16 buffer; a polygon of n points is
+ *              stored planar (n x values, then n y values) from its offset
+ *   strings  - ids, targets and labels interned into one character pool
+ *
+ * Zone stays the value type used to build a scene; add() packs it. Readers
+ * get ZoneView handles with the same getters as Zone. Views and the strings
+ * they return are valid while the table is alive and unmodified.
+ *
+ * All buffers come from the given SceneArena, or the heap if none.
+ */
+class ZoneTable
+{
+public:
+    /** A polygon's vertices, read out of the planar vertex buffer. */
+    class PolygonView
+    {
+    public:
+        class Iterator
+        {
+        public:
+            Iterator(const int16_t* xs, const int16_t* ys) : mXs(xs), mYs(ys) {}
+            Zone::Point operator*()  const { return { *mXs, *mYs }; }
+            Iterator&   operator++()       { ++mXs; ++mYs; return *this; }
+            bool operator!=(const Iterator& other) const { return mXs != other.mXs; }
+        private:
+            const int16_t* mXs;
+            const int16_t* mYs;
+        };
+
+        PolygonView(const int16_t* xs = nullptr, int count = 0) : mXs(xs), mCount(count) {}
+
+        int            size()  const { return mCount; }
+        bool           empty() const { return mCount == 0; }
+        int            x(int i) const { return mXs[i]; }
+        int            y(int i) const { return mXs[mCount + i]; }
+        const int16_t* xs()    const { return mXs; }
+        const int16_t* ys()    const { return mXs + mCount; }
+        Iterator       begin() const { return { xs(), ys() }; }
+        Iterator       end()   const { return { xs() + mCount, ys() + mCount }; }
+
+        Zone::Polygon toPolygon() const;
+
+        bool operator==(const PolygonView& other) const;
+        bool operator!=(const PolygonView& other) const { return !(*this == other); }
+
+    private:
+        const int16_t* mXs;
+        int            mCount;
+    };
+
+    class Iterator;
+
+    /** Read-only handle to one packed zone. Cheap to copy. */
+    class ZoneView
+    {
+    public:
+        ZoneView(const ZoneTable& table, size_t index) : mTable(&table), mIndex(index) {}
+
+        bool containsPoint(int x, int y) const { return mTable->containsPoint(mIndex, x, y); }
+
+        bool        hasPolygon() const { return !getPolygon().empty(); }
+        PolygonView getPolygon() const { return mTable->polygon(mIndex); }
+
+        std::string_view    getZoneID()     const { return mTable->string(mTable->mStrings[mIndex].zoneID); }
+        std::string_view    getSceneID()    const { return mTable->string(mTable->mStrings[mIndex].sceneID); }
+        std::string_view    getTarget()     const { return mTable->string(mTable->mStrings[mIndex].target); }
+        std::string_view    getNoteTarget() const { return mTable->string(mTable->mStrings[mIndex].noteTarget); }
+        std::string_view    getLabel()      const { return mTable->string(mTable->mStrings[mIndex].label); }
+        const Zone::Bounds& getBounds()     const { return mTable->mBounds[mIndex]; }
+        size_t              index()         const { return mIndex; }
+
+    private:
+        friend class Iterator;
+        const ZoneTable* mTable;
+        size_t           mIndex;
+    };
+
+    class Iterator
+    {
+    public:
+        Iterator(const ZoneTable& table, size_t i) : mView(table, i) {}
+        const ZoneView& operator*()  const { return mView; }
+        Iterator&       operator++()       { ++mView.mIndex; return *this; }
+        bool operator!=(const Iterator& other) const { return mView.mIndex != other.mView.mIndex; }
+    private:
+        ZoneView mView;
+    };
+
+    explicit ZoneTable(SceneArena* arena = nullptr);
+
+    /** Pack zone at the end of the table. */
+    void add(const Zone& zone);
+
+    /** Pack a zone given as planar vertex arrays, without building a Zone. */
+    void add(const Zone::Bounds& bounds, const int16_t* xs, const int16_t* ys, int count,
+             std::string_view sceneID, std::string_view zoneID, std::string_view target,
+             std::string_view noteTarget, std::string_view label);
+    void clear();
+
+    size_t   size()  const { return mBounds.size(); }
+    bool     empty() const { return mBounds.empty(); }
+    ZoneView operator[](size_t i) const { return { *this, i }; }
+    Iterator begin() const { return { *this, 0 }; }
+    Iterator end()   const { return { *this, size() }; }
+
+    /** Same inclusive AABB cull and ray-cast as Zone::containsPoint. */
+    bool containsPoint(size_t zone, int x, int y) const;
+
+    PolygonView polygon(size_t zone) const;
+
+    const ArenaVector<Zone::Bounds>& bounds() const { return mBounds; }
+
+    /** Heap bytes held by the packed buffers. */
+    size_t memoryBytes() const;
+
+private:
+    struct ZoneStrings
+    {
+        uint16_t sceneID;
+        uint16_t zoneID;
+        uint16_t target;
+        uint16_t noteTarget;
+        uint16_t label;
+    };
+
+    uint16_t         intern(std::string_view s);
+    std::string_view string(uint16_t index) const;
+
+    ArenaVector<Zone::Bounds> mBounds;
+    ArenaVector<uint32_t>     mPolygonStart; // size() + 1 offsets into mVertices
+    ArenaVector<int16_t>      mVertices;
+    ArenaVector<ZoneStrings>  mStrings;
+    ArenaString               mStringPool;
+    ArenaVector<uint32_t>     mStringStart;  // interned string i is [mStringStart[i], mStringStart[i + 1])
+    ArenaVector<uint16_t>     mStringOrder;  // interned string indices, sorted by content
+};
@@ -0,0 +1,97 @@
+/**
+ * KSC — host-side scene compiler
+ *
+ * Walks a KSC_DATA tree and writes a compiled record (.kscb) next to every
+ * scene JSON (any JSON document with a "zones" array). See SceneCompiler.h for
+ * the record format. The JSON stays the source of truth, but the game trusts
+ * a record that is present, so re-run this after editing scene data, before
+ * syncing to the SD card.
+ *
+ * Also brings the scene-ID table (SceneIDTable::k_Path) up to date: scenes
+ * it does not list yet are appended in path order. Existing lines are never
+ * reordered or removed, so saved discovery state keeps its meaning.
+ *
+ * Usage:
+ *   KSC_SceneCompiler [KSC_DATA dir]       (defaults to ./KSC_DATA)
+ */
+
+#include "GAME_STATE/SceneIDTable.h"
+#include "SCENE/SceneCompiler.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+static std::string readFile(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+static bool isSceneJson(const std::string& content)
+{
+    nlohmann::json j = nlohmann::json::parse(content, nullptr, false);
+    return !j.is_discarded() && j.is_object() && j.contains("zones") && j["zones"].is_array();
+}
+
+int main(int argc, char** argv)
+{
+    fs::path dataRoot = (argc > 1) ? fs::path(argv[1]) : fs::path("KSC_DATA");
+    if (!fs::is_directory(dataRoot))
+    {
+        std::cerr << "KSC_SceneCompiler: no data directory at " << dataRoot << "\n";
+        return 1;
+    }
+
+    int compiled = 0, failed = 0;
+    std::vector<std::string> scenePaths;
+    for (const auto& entry : fs::recursive_directory_iterator(dataRoot))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json")
+            continue;
+
+        std::string json = readFile(entry.path());
+        if (!isSceneJson(json))
+            continue;
+
+        scenePaths.push_back("/" + fs::relative(entry.path(), dataRoot).generic_string());
+
+        std::string record = SceneCompiler::compile(json);
+        if (record.empty())
+        {
+            std::cerr << "  failed: " << entry.path().string() << "\n";
+            failed++;
+            continue;
+        }
+
+        fs::path out = entry.path();
+        out.replace_extension(".kscb");
+        std::ofstream file(out, std::ios::binary);
+        file.write(record.data(), (std::streamsize)record.size());
+        compiled++;
+    }
+
+    fs::path     tablePath = dataRoot / fs::path(SceneIDTable::k_Path).relative_path();
+    SceneIDTable table;
+    table.load(readFile(tablePath));
+    std::sort(scenePaths.begin(), scenePaths.end());
+    for (const std::string& path : scenePaths)
+        table.intern(path);
+    size_t added = table.size() - table.stableSize();
+    if (added > 0)
+    {
+        std::ofstream file(tablePath, std::ios::binary);
+        file << table.toText();
+    }
+
+    std::cout << "Compiled " << compiled << " scene(s)";
+    if (failed) std::cout << ", " << failed << " failed";
+    std::cout << "; " << added << " new scene ID(s).\n";
+    return failed ? 1 : 0;
+}
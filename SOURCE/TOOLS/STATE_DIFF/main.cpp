@@ -0,0 +1,92 @@
+/**
+ * KSC — host-side game-state regression check
+ *
+ * Compares every recorded session in a directory (Game_State.json documents
+ * or packed save slots) against a golden Game_State.json, on every core.
+ * See GameStateComparison for what counts as equal. Prints one line per
+ * session that differs, with its scalar, discovery and entry differences.
+ *
+ * Usage:
+ *   KSC_StateDiff <sessions dir> [golden] [threads]
+ *     golden defaults to TESTS/GOLDEN/GAME_STATE/Game_State_Complete.json,
+ *     threads to one per core.
+ *
+ * Exits 0 when every session matches, 1 when any differs, 2 on bad arguments.
+ */
+
+#include "FILE_OPERATOR/FileOperator.h"
+#include "GAME_STATE/GameStateComparison.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+// Plain paths, read-only: all the comparison needs.
+class DiskFileOperator : public FileOperator
+{
+public:
+    std::string load(const std::string& path) override
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    void writeToFile(const std::string&, const std::string&) override {}
+    void appendToFile(const std::string&, const std::string&) override {}
+
+    std::vector<std::string> listDirectory(const std::string& path) override
+    {
+        std::vector<std::string> names;
+        std::error_code          error;
+        for (const auto& entry : fs::directory_iterator(path, error))
+            if (entry.is_regular_file())
+                names.push_back(entry.path().filename().string());
+        return names;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: KSC_StateDiff <sessions dir> [golden] [threads]\n";
+        return 2;
+    }
+    std::string dir        = argv[1];
+    std::string goldenPath = argc > 2 ? argv[2] : "TESTS/GOLDEN/GAME_STATE/Game_State_Complete.json";
+    unsigned    threads    = argc > 3 ? (unsigned)std::stoul(argv[3]) : 0;
+
+    DiskFileOperator files;
+    std::string      golden = files.load(goldenPath);
+    if (golden.empty() || !fs::is_directory(dir))
+    {
+        std::cerr << "KSC_StateDiff: cannot read " << (golden.empty() ? goldenPath : dir) << "\n";
+        return 2;
+    }
+
+    auto results = GameStateComparison::compareDirectory(files, dir, golden, threads);
+    int  differing = 0;
+    std::cout << std::boolalpha;
+    for (const auto& result : results)
+    {
+        if (result.equal) continue;
+        differing++;
+        std::cout << result.name << ":";
+        for (const auto& change : result.diff.scalars)
+            std::cout << " " << change.field << " '" << change.before << "' -> '" << change.after << "';";
+        for (const auto& change : result.diff.discoveries)
+            std::cout << " " << change.mapKey << " " << change.path << " " << change.before << " -> " << change.after << ";";
+        for (const auto& entry : result.diff.entries)
+            std::cout << " entry " << entry << ";";
+        if (result.diff.isEmpty())
+            std::cout << " differs outside the compared fields";
+        std::cout << "\n";
+    }
+
+    std::cout << results.size() << " session(s), " << differing << " differ from " << goldenPath << ".\n";
+    return differing ? 1 : 0;
+}
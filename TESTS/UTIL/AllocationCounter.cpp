@@ -0,0 +1,25 @@
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+// Counting replacements for the global allocation functions, scalar and
+// array alike. Per-thread so background prefetch threads in other tests
+// never skew a measurement.
+static thread_local size_t tAllocations = 0;
+
+size_t allocationsOnThisThread() { return tAllocations; }
+
+static void* countedAlloc(std::size_t size)
+{
+    ++tAllocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size)   { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+
+void operator delete(void* p) noexcept                { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept   { std::free(p); }
+void operator delete[](void* p) noexcept              { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
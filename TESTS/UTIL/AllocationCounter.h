@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * Number of global operator new calls made on the calling thread so far.
+ * The counting operator new/delete replacements live in AllocationCounter.cpp
+ * and apply to the whole test binary.
+ */
+size_t allocationsOnThisThread();
+
+/** Counts allocations made on this thread between construction and count(). */
+class AllocationCounter
+{
+public:
+    AllocationCounter() : mStart(allocationsOnThisThread()) {}
+    size_t count() const { return allocationsOnThisThread() - mStart; }
+private:
+    size_t mStart;
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include "TestFileOperator.h"
+#include <mutex>
+
+/**
+ * TestFileOperator that logs every storage operation, so tests can tell
+ * cache hits from reloads and count what a flush or save wrote. Locked, so
+ * background prefetch and save threads may use it; read the logs from the
+ * test thread once they are idle, or through loadCount().
+ *
+ * memoryWrites: when set, writes to virtual paths (leading '/') stay in the
+ * in-memory map instead of going to disk. Real paths always go to disk.
+ *
+ * lostWrites: when set, writes to paths containing it are dropped without
+ * being logged, as if power was lost before they landed.
+ *
+ * writesBeforePowerLoss: when not negative, that many more writes and
+ * appends land and every later one is dropped, as if power was lost.
+ */
+class CountingFileOperator : public TestFileOperator
+{
+public:
+    bool        memoryWrites = false;
+    std::string lostWrites;
+    int         writesBeforePowerLoss = -1;
+
+    std::map<std::string, int>    loadCounts;
+    std::map<std::string, int>    writeCounts;
+    std::map<std::string, int>    appendCounts;
+    std::map<std::string, int>    listCounts;
+    std::vector<std::string>      loads;   // every load, in order
+    std::vector<std::string>      writes;  // every write that landed, in order
+    std::map<std::string, size_t> written; // bytes of the last write to each path
+
+    std::string load(const std::string& path) override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        loadCounts[path]++;
+        loads.push_back(path);
+        return TestFileOperator::load(path);
+    }
+
+    void writeToFile(const std::string& path, const std::string& content) override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (isLost(path)) return;
+        writeCounts[path]++;
+        writes.push_back(path);
+        written[path] = content.size();
+        if (memoryWrites && isVirtual(path)) files[path] = content;
+        else                                 TestFileOperator::writeToFile(path, content);
+    }
+
+    void appendToFile(const std::string& path, const std::string& content) override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (isLost(path)) return;
+        appendCounts[path]++;
+        if (memoryWrites && isVirtual(path)) files[path] += content;
+        else                                 TestFileOperator::appendToFile(path, content);
+    }
+
+    std::vector<std::string> listDirectory(const std::string& dirPath) override
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        listCounts[dirPath]++;
+        return TestFileOperator::listDirectory(dirPath);
+    }
+
+    /** Loads of path so far; safe while other threads use the operator. */
+    int loadCount(const std::string& path) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto it = loadCounts.find(path);
+        return it == loadCounts.end() ? 0 : it->second;
+    }
+
+    int totalLoads()   const { return sum(loadCounts); }
+    int totalWrites()  const { return sum(writeCounts); }
+    int totalAppends() const { return sum(appendCounts); }
+
+private:
+    mutable std::mutex mMutex;
+
+    bool isLost(const std::string& path)
+    {
+        if (!lostWrites.empty() && path.find(lostWrites) != std::string::npos) return true;
+        if (writesBeforePowerLoss == 0) return true;
+        if (writesBeforePowerLoss > 0) writesBeforePowerLoss--;
+        return false;
+    }
+
+    static bool isVirtual(const std::string& path) { return !path.empty() && path[0] == '/'; }
+
+    int sum(const std::map<std::string, int>& counts) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        int total = 0;
+        for (const auto& [path, n] : counts) total += n;
+        return total;
+    }
+};
@@ -5,8 +5,8 @@
 class NullGraphicsRenderer : public GraphicsRenderer
 {
 public:
-    void drawImage(const std::string&) override {}
-    void drawText(const std::string&, int, int) override {}
-    void drawSVG(const std::string&, int, int, int = 0, int = 0) override {}
-    void drawButton(const std::string&, int, int, int, int) override {}
+    void drawImage(std::string_view) override {}
+    void drawText(std::string_view, int, int) override {}
+    void drawSVG(std::string_view, int, int, int = 0, int = 0) override {}
+    void drawButton(std::string_view, int, int, int, int) override {}
 };
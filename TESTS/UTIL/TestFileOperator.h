@@ -38,7 +38,7 @@ public:
         std::string diskPath = (!diskRoot.empty() && !path.empty() && path[0] == '/')
                              ? diskRoot + path
                              : path;
-        std::ifstream f(diskPath);
+        std::ifstream f(diskPath, std::ios::binary);
         if (!f.is_open()) return "";
         std::ostringstream ss;
         ss << f.rdbuf();
@@ -50,7 +50,7 @@ public:
         std::string diskPath = resolvePath(path, writeRoot);
         fs::path p(diskPath);
         fs::create_directories(p.parent_path());
-        std::ofstream f(p);
+        std::ofstream f(p, std::ios::binary);
         f << content;
     }
 
@@ -64,7 +64,7 @@ public:
         std::string diskPath = resolvePath(path, writeRoot);
         fs::path p(diskPath);
         fs::create_directories(p.parent_path());
-        std::ofstream f(p);
+        std::ofstream f(p, std::ios::binary);
         f << files[path];
     }
 
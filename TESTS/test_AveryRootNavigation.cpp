@@ -18,11 +18,11 @@ static std::pair<int,int> jsonPolygonCentroid(const nlohmann::json& points)
     return { sumX / n, sumY / n };
 }
 
-// Centroid of a Zone::Polygon — coordinates already scaled to 320×240.
-static std::pair<int,int> zoneCentroid(const Zone::Polygon& poly)
+// Centroid of a zone polygon — coordinates already scaled to 320×240.
+static std::pair<int,int> zoneCentroid(const ZoneTable::PolygonView& poly)
 {
     int sumX = 0, sumY = 0;
-    for (auto& [x, y] : poly)
+    for (auto [x, y] : poly)
         { sumX += x; sumY += y; }
     int n = static_cast<int>(poly.size());
     return { sumX / n, sumY / n };
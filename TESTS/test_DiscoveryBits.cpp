@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GAME_STATE/DiscoveryBits.h"
+#include "GAME_STATE/SceneIDTable.h"
+#include "UTIL/TestFileOperator.h"
+#include <nlohmann/json.hpp>
+
+static std::vector<uint32_t> setBits(const DiscoveryBits& bits)
+{
+    std::vector<uint32_t> ids;
+    bits.forEach([&](uint32_t id) { ids.push_back(id); });
+    return ids;
+}
+
+TEST_CASE("DiscoveryBits sets, tests and combines IDs across words", "[DiscoveryBits]")
+{
+    DiscoveryBits a;
+    CHECK(a.none());
+    CHECK_FALSE(a.test(1000));
+
+    for (uint32_t id : { 0u, 5u, 63u, 64u, 130u })
+        a.set(id);
+    CHECK(a.count() == 5);
+    CHECK(a.test(63));
+    CHECK(a.test(64));
+    CHECK_FALSE(a.test(65));
+    CHECK(setBits(a) == std::vector<uint32_t>{ 0, 5, 63, 64, 130 });
+
+    a.set(130, false);
+    a.set(5000, false); // clearing past the end does not grow the set
+    CHECK(setBits(a) == std::vector<uint32_t>{ 0, 5, 63, 64 });
+
+    DiscoveryBits b;
+    b.set(5);
+    b.set(64);
+    b.set(200);
+
+    CHECK(setBits(a ^ b) == std::vector<uint32_t>{ 0, 63, 200 });
+    CHECK(setBits(a & b) == std::vector<uint32_t>{ 5, 64 });
+    CHECK(setBits(a | b) == std::vector<uint32_t>{ 0, 5, 63, 64, 200 });
+
+    DiscoveryBits c = a;
+    c.subtract(b);
+    CHECK(setBits(c) == std::vector<uint32_t>{ 0, 63 });
+
+    // Trailing clear words do not affect equality.
+    DiscoveryBits padded = b;
+    padded.set(900);
+    padded.set(900, false);
+    CHECK(padded == b);
+    CHECK(a != b);
+}
+
+TEST_CASE("DiscoveryBits round-trips through trimmed bytes", "[DiscoveryBits]")
+{
+    DiscoveryBits bits;
+    CHECK(bits.toBytes().empty());
+
+    bits.set(1);
+    bits.set(9);
+    bits.set(70);
+    std::string bytes = bits.toBytes();
+    REQUIRE(bytes.size() == 9); // up to the byte holding bit 70
+    CHECK(static_cast<uint8_t>(bytes[0]) == 0x02);
+    CHECK(static_cast<uint8_t>(bytes[1]) == 0x02);
+    CHECK(static_cast<uint8_t>(bytes[8]) == 0x40);
+    CHECK(DiscoveryBits::fromBytes(bytes) == bits);
+}
+
+TEST_CASE("SceneIDTable keeps file IDs stable and interns the rest after them", "[DiscoveryBits]")
+{
+    SceneIDTable table;
+    table.load("# header\n/A.json\r\n\n/B.json\n/A.json\n/C.json");
+    REQUIRE(table.size() == 3);
+    CHECK(table.stableSize() == 3);
+    CHECK(table.find("/B.json") == 1);
+    CHECK(table.find("/missing.json") == SceneIDTable::k_None);
+
+    uint32_t hash = table.hash();
+    uint32_t id   = table.intern("/D.json");
+    CHECK(id == 3);
+    CHECK_FALSE(table.isStable(id));
+    CHECK(table.intern("/D.json") == id);
+    CHECK(table.hash() == hash);
+
+    // Appending to the file keeps every earlier ID and prefix hash.
+    SceneIDTable grown;
+    grown.load(table.toText());
+    CHECK(grown.stableSize() == 4);
+    CHECK(grown.find("/C.json") == 2);
+    CHECK(grown.hash(3) == hash);
+    CHECK(grown.hash() != hash);
+}
+
+TEST_CASE("Scene_IDs.txt lists every scene in KSC_DATA", "[DiscoveryBits]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    SceneIDTable table;
+    table.load(fileOp.load(SceneIDTable::k_Path));
+    REQUIRE(table.stableSize() > 0);
+
+    // Regenerate with KSC_SceneCompiler when this fails.
+    for (const auto& entry : fs::recursive_directory_iterator("KSC_DATA"))
+    {
+        if (entry.path().extension() != ".json") continue;
+        nlohmann::json j = nlohmann::json::parse(fileOp.load(entry.path().string()), nullptr, false);
+        if (j.is_discarded() || !j.is_object() || !j.contains("zones")) continue;
+
+        std::string path = "/" + fs::relative(entry.path(), "KSC_DATA").generic_string();
+        INFO(path);
+        CHECK(table.find(path) != SceneIDTable::k_None);
+    }
+}
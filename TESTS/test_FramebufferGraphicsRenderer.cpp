@@ -0,0 +1,259 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "GRAPHICS_RENDERER/FramebufferGraphicsRenderer.h"
+#include "GRAPHICS_RENDERER/PngImage.h"
+#include "SCENE/SceneFactory.h"
+#include "SCENE_VIEW/SceneView.h"
+#include "UTIL/TestFileOperator.h"
+#include <cstring>
+
+static const std::string k_GoldenDir      = "TESTS/GOLDEN/FRAMEBUFFER";
+static const std::string k_OutputDir      = "TESTS/OUTPUT/FRAMEBUFFER";
+static const std::string k_FixtureRGB     = k_GoldenDir + "/Fixture_RGB.png";
+static const std::string k_FixturePalette = k_GoldenDir + "/Fixture_Palette.png";
+static const std::string k_AveryRootPath  = "/LOCATIONS/AVERY/ROOT/Avery_Full.json";
+static const std::string k_FileMenuPath   = "/LOCATIONS/AVERY/DESK/COMPUTER/FILE_MENU/File_Menu.json";
+
+using FB = FramebufferGraphicsRenderer;
+
+static const char* k_DiamondSvg =
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"20\" height=\"20\">"
+    "<path d=\"M10 0 L20 10 L10 20 L0 10 Z\" fill=\"#000\"/></svg>";
+
+// Fixture_RGB.png was written with every row filter (row y uses filter y % 5)
+// and a compressed IDAT, so this covers the dynamic-Huffman inflate path.
+static uint16_t fixturePixel(int x, int y)
+{
+    return FB::rgb565(static_cast<uint8_t>(x * 255 / 319), static_cast<uint8_t>(y * 255 / 239),
+                      static_cast<uint8_t>((x ^ y) & 0xFF));
+}
+
+// Compare a frame against its golden PNG, writing it to k_OutputDir for inspection.
+static void checkGolden(TestFileOperator& fileOp, const FB& renderer, const std::string& name)
+{
+    std::vector<uint8_t> rgba  = renderer.toRGBA();
+    std::string          frame = PngImage::encode(rgba.data(), FB::k_Width, FB::k_Height);
+    fileOp.writeToFile(k_OutputDir + "/" + name + ".png", frame);
+
+    PngImage golden;
+    REQUIRE(golden.decode(fileOp.load(k_GoldenDir + "/" + name + ".png")));
+    REQUIRE(golden.width() == FB::k_Width);
+    REQUIRE(golden.height() == FB::k_Height);
+
+    size_t differing = 0;
+    for (size_t i = 0; i < rgba.size(); i += 4)
+        if (std::memcmp(&rgba[i], &golden.rgba()[i], 4) != 0) differing++;
+    INFO(name << ": see " << k_OutputDir);
+    CHECK(differing == 0);
+}
+
+TEST_CASE("PngImage decodes and encodes", "[PngImage]")
+{
+    TestFileOperator fileOp;
+    std::string      rgbBytes = fileOp.load(k_FixtureRGB);
+
+    SECTION("RGB, every filter")
+    {
+        PngImage image;
+        REQUIRE(image.decode(rgbBytes));
+        REQUIRE(image.width() == 320);
+        REQUIRE(image.height() == 240);
+        bool all = true;
+        for (int y = 0; y < 240; ++y)
+            for (int x = 0; x < 320; ++x)
+            {
+                const uint8_t* p = &image.rgba()[(y * 320 + x) * 4];
+                all = all && p[0] == x * 255 / 319 && p[1] == y * 255 / 239 && p[2] == ((x ^ y) & 0xFF) && p[3] == 255;
+            }
+        CHECK(all);
+    }
+
+    SECTION("4-bit palette with transparency")
+    {
+        PngImage image;
+        REQUIRE(image.decode(fileOp.load(k_FixturePalette)));
+        REQUIRE(image.width() == 24);
+        REQUIRE(image.height() == 16);
+        // Index (x / 3 + y / 2) % 16; entry i is (16i, 255 - 16i, 37i), entry 0 transparent.
+        const uint8_t* p = &image.rgba()[(3 * 24 + 7) * 4]; // index 3
+        CHECK(p[0] == 48);
+        CHECK(p[1] == 207);
+        CHECK(p[2] == 111);
+        CHECK(p[3] == 255);
+        CHECK(image.rgba()[3] == 0);
+    }
+
+    SECTION("encode round-trips")
+    {
+        PngImage image, again;
+        REQUIRE(image.decode(rgbBytes));
+        std::string encoded = PngImage::encode(image.rgba().data(), image.width(), image.height());
+        REQUIRE(again.decode(encoded));
+        CHECK(again.rgba() == image.rgba());
+        CHECK(PngImage::encode(again.rgba().data(), 320, 240) == encoded);
+    }
+
+    SECTION("damaged files are rejected")
+    {
+        PngImage    image;
+        std::string flipped = rgbBytes;
+        flipped[rgbBytes.size() / 2] ^= 0x01;
+        CHECK_FALSE(image.decode(flipped));
+        CHECK_FALSE(image.decode(rgbBytes.substr(0, rgbBytes.size() - 20)));
+        CHECK_FALSE(image.decode("version https://git-lfs.github.com/spec/v1\n"));
+        CHECK(image.rgba().empty());
+    }
+}
+
+TEST_CASE("FramebufferGraphicsRenderer rasterizes each primitive", "[FramebufferGraphicsRenderer]")
+{
+    TestFileOperator fileOp;
+    fileOp.files["/IMG/fixture.png"] = fileOp.load(k_FixtureRGB);
+    fileOp.files["/IMG/palette.png"] = fileOp.load(k_FixturePalette);
+    fileOp.files["/TXT/note.md"]     = "# H\nab\n";
+    fileOp.files["/SVG/diamond.svg"] = k_DiamondSvg;
+    FB renderer(fileOp);
+
+    SECTION("images clear the screen and blit at the origin")
+    {
+        renderer.clear(FB::k_White);
+        renderer.drawImage("/IMG/fixture.png");
+        CHECK(renderer.pixel(0, 0) == fixturePixel(0, 0));
+        CHECK(renderer.pixel(123, 45) == fixturePixel(123, 45));
+        CHECK(renderer.pixel(319, 239) == fixturePixel(319, 239));
+
+        renderer.clear(FB::k_White);
+        renderer.drawImage("/IMG/palette.png");
+        CHECK(renderer.pixel(7, 3) == FB::rgb565(48, 207, 111));
+        CHECK(renderer.pixel(100, 100) == FB::k_Black);
+
+        renderer.clear(FB::k_White);
+        renderer.drawImage("/IMG/missing.png");
+        CHECK(renderer.pixel(0, 0) == FB::k_Black);
+    }
+
+    SECTION("buttons")
+    {
+        renderer.clear(FB::k_Yellow);
+        renderer.drawButton("I", 10, 20, 30, 16);
+        CHECK(renderer.pixel(10, 20) == FB::k_White);
+        CHECK(renderer.pixel(39, 35) == FB::k_White);
+        CHECK(renderer.pixel(11, 21) == FB::k_Black);
+        CHECK(renderer.pixel(40, 20) == FB::k_Yellow);
+        // 'I' is centred at x = 10 + (30 - 6) / 2, y = 20 + (16 - 8) / 2;
+        // its middle column is solid from row 0 to 6.
+        CHECK(renderer.pixel(22 + 2, 24) == FB::k_White);
+        CHECK(renderer.pixel(22 + 2, 30) == FB::k_White);
+        CHECK(renderer.pixel(22 + 2, 31) == FB::k_Black);
+    }
+
+    SECTION("markdown headings and body text")
+    {
+        renderer.drawText("/TXT/note.md", 4, 10);
+        // '#' line at size 3: 'H' column 0 is solid, three pixels wide.
+        CHECK(renderer.pixel(4, 10) == FB::k_White);
+        CHECK(renderer.pixel(6, 10 + 3 * 6 + 2) == FB::k_White);
+        CHECK(renderer.pixel(7, 10) == FB::k_Black);
+        // Body line follows at 10 + 3 * 8 + 4, light grey at size 1: 'b' column 0.
+        CHECK(renderer.pixel(4 + 6, 38) == FB::k_LightGrey);
+        CHECK(renderer.pixel(4 + 6, 38 + 6) == FB::k_LightGrey);
+
+        renderer.clear();
+        renderer.setScrollOffset(28);
+        renderer.drawText("/TXT/note.md", 4, 10);
+        CHECK(renderer.pixel(4 + 6, 10) == FB::k_LightGrey);
+    }
+
+    SECTION("SVGs blend white by coverage")
+    {
+        renderer.drawSVG("/SVG/diamond.svg", 100, 100, 40, 40);
+        CHECK(renderer.pixel(120, 120) == FB::k_White);
+        CHECK(renderer.pixel(101, 101) == FB::k_Black);
+        CHECK(renderer.pixel(141, 120) == FB::k_Black);
+        uint16_t edge = renderer.pixel(109, 110); // the edge cuts this pixel diagonally
+        CHECK(edge != FB::k_White);
+        CHECK(edge != FB::k_Black);
+    }
+
+    SECTION("zone outlines")
+    {
+        renderer.drawRect(50, 60, 10, 5);
+        CHECK(renderer.pixel(50, 60) == FB::k_Yellow);
+        CHECK(renderer.pixel(59, 64) == FB::k_Yellow);
+        CHECK(renderer.pixel(55, 62) == FB::k_Black);
+
+        const int16_t xs[] = { 200, 210, 200 };
+        const int16_t ys[] = { 100, 100, 110 };
+        renderer.drawPolygon(xs, ys, 3);
+        CHECK(renderer.pixel(205, 100) == FB::k_Yellow);
+        CHECK(renderer.pixel(200, 105) == FB::k_Yellow);
+        CHECK(renderer.pixel(205, 105) == FB::k_Yellow);
+        CHECK(renderer.pixel(203, 103) == FB::k_Black);
+    }
+
+    SECTION("content area clips")
+    {
+        renderer.beginContentArea(0, 15, 320, 210);
+        renderer.drawImage("/IMG/fixture.png");
+        renderer.drawRect(0, 0, 320, 240);
+        renderer.endContentArea();
+        CHECK(renderer.pixel(5, 5) == FB::k_Black);
+        CHECK(renderer.pixel(5, 15) == fixturePixel(5, 15));
+        CHECK(renderer.pixel(5, 230) == FB::k_Black);
+
+        renderer.drawRect(0, 0, 320, 240);
+        CHECK(renderer.pixel(5, 0) == FB::k_Yellow);
+    }
+}
+
+TEST_CASE("FramebufferGraphicsRenderer frames match their goldens", "[FramebufferGraphicsRenderer]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    FB        renderer(fileOp);
+    SceneView view(renderer);
+
+    SECTION("scene with overlay and zone display")
+    {
+        auto scene = SceneFactory().build(fileOp.load(k_AveryRootPath));
+        REQUIRE(scene);
+        // The scene's own PNG is an LFS pointer in this checkout.
+        fileOp.files[std::string(scene->getPrimaryPath())] = fileOp.load(k_FixtureRGB);
+        view.draw(*scene, true, true);
+        checkGolden(fileOp, renderer, "Avery_Root");
+    }
+
+    SECTION("menu")
+    {
+        auto menu = SceneFactory().build(fileOp.load(k_FileMenuPath));
+        REQUIRE(menu);
+        view.drawMenu(*menu);
+        checkGolden(fileOp, renderer, "File_Menu");
+    }
+}
+
+TEST_CASE("FramebufferGraphicsRenderer frame benchmark", "[FramebufferGraphicsRenderer][!benchmark]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    auto scene = SceneFactory().build(fileOp.load(k_AveryRootPath));
+    auto menu  = SceneFactory().build(fileOp.load(k_FileMenuPath));
+    REQUIRE(scene);
+    REQUIRE(menu);
+    fileOp.files[std::string(scene->getPrimaryPath())] = fileOp.load(k_FixtureRGB);
+
+    FB        renderer(fileOp);
+    SceneView view(renderer);
+
+    BENCHMARK("scene frame: PNG decode, overlay text, zone display")
+    {
+        view.draw(*scene, true, true);
+        return renderer.pixel(0, 0);
+    };
+
+    BENCHMARK("menu frame")
+    {
+        view.drawMenu(*menu);
+        return renderer.pixel(0, 0);
+    };
+}
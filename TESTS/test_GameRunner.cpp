@@ -37,8 +37,8 @@ static void loadGameStateFiles(TestFileOperator& fileOp)
     }
 }
 
-// Runs a full start-game sequence and returns the slot directory written.
-static std::string runStart(TestFileOperator& fileOp)
+// Runs a full start-game sequence and returns the slot written.
+static int runStart(TestFileOperator& fileOp)
 {
     prepareOutputDir();
     fileOp.diskRoot = "KSC_DATA";
@@ -46,7 +46,7 @@ static std::string runStart(TestFileOperator& fileOp)
 
     // Pre-compute the slot index that GameStartManager will choose.
     int nextSlot = 0;
-    while (fs::exists(k_OutputDir + "/KSC_SLOT_" + std::to_string(nextSlot)))
+    while (fs::exists(k_OutputDir + "/KSC_SLOT_" + std::to_string(nextSlot) + ".ksc"))
         nextSlot++;
 
     NullGraphicsRenderer renderer;
@@ -66,8 +66,18 @@ static std::string runStart(TestFileOperator& fileOp)
         }
     }
     runner.registerHit(hitX, hitY);
+    runner.flushGameState(); // the save runs behind the first scene
 
-    return k_OutputDir + "/KSC_SLOT_" + std::to_string(nextSlot);
+    REQUIRE(fs::is_regular_file(k_OutputDir + "/KSC_SLOT_" + std::to_string(nextSlot) + ".ksc"));
+    return nextSlot;
+}
+
+// Reads a slot written by runStart back as it was saved.
+static GameStartManager::SlotContents readStartSlot(TestFileOperator& fileOp, int slot)
+{
+    GameStartManager::SlotContents contents;
+    REQUIRE(GameStartManager(fileOp, k_OutputDir).readSlot(slot, contents));
+    return contents;
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -134,10 +144,8 @@ TEST_CASE("GameRunner start button navigates to first location", "[GameRunner]")
 TEST_CASE("GameRunner start button creates save slot with default Game_State", "[GameRunner]")
 {
     TestFileOperator fileOp;
-    std::string slotDir   = runStart(fileOp);
-    std::string savedJson = fileOp.load(slotDir + "/Game_State.json");
+    std::string savedJson = readStartSlot(fileOp, runStart(fileOp)).gameState;
 
-    REQUIRE(fs::is_directory(slotDir));
     REQUIRE_FALSE(savedJson.empty());
 
     std::string goldenJson = fileOp.load(k_GoldenPath);
@@ -148,16 +156,16 @@ TEST_CASE("GameRunner start button creates save slot with default Game_State", "
 TEST_CASE("GameRunner start button creates save slot with default NOTES_STATE", "[GameRunner]")
 {
     TestFileOperator fileOp;
-    std::string slotDir = runStart(fileOp);
+    auto notes = readStartSlot(fileOp, runStart(fileOp)).notes;
 
-    SECTION("NOTES_STATE/AVERY subdirectory exists")
+    SECTION("the slot holds exactly the AVERY and LIBRARY notes")
     {
-        REQUIRE(fs::is_directory(slotDir + "/NOTES_STATE/AVERY"));
+        REQUIRE(notes.size() == 2);
     }
 
     SECTION("Avery_Note.md content matches original")
     {
-        std::string written  = fileOp.load(slotDir + "/NOTES_STATE/AVERY/Avery_Note.md");
+        std::string written  = notes["AVERY/Avery_Note.md"];
         std::string original = fileOp.load("KSC_DATA/GAME_STATE/NOTES_STATE/AVERY/Avery_Note.md");
         REQUIRE_FALSE(written.empty());
         REQUIRE(written == original);
@@ -165,7 +173,7 @@ TEST_CASE("GameRunner start button creates save slot with default NOTES_STATE",
 
     SECTION("Library_Note.md content matches original")
     {
-        std::string written  = fileOp.load(slotDir + "/NOTES_STATE/LIBRARY/Library_Note.md");
+        std::string written  = notes["LIBRARY/Library_Note.md"];
         std::string original = fileOp.load("KSC_DATA/GAME_STATE/NOTES_STATE/LIBRARY/Library_Note.md");
         REQUIRE_FALSE(written.empty());
         REQUIRE(written == original);
@@ -207,8 +215,7 @@ TEST_CASE("Clue discovery appends text to note after save creation", "[GameRunne
     loadGameStateFiles(fileOp); // puts NOTES_STATE files into fileOp.files
 
     // Step 1: Create a save slot (start screen → Avery root).
-    std::string slotDir = runStart(fileOp);
-    REQUIRE(fs::is_directory(slotDir));
+    int slot = runStart(fileOp);
 
     // Step 2: Confirm defaults — the saved NOTES_STATE note has no clue entries yet.
     std::string defaultNote = fileOp.load("/GAME_STATE/NOTES_STATE/AVERY/Avery_Note.md");
@@ -216,7 +223,7 @@ TEST_CASE("Clue discovery appends text to note after save creation", "[GameRunne
     REQUIRE_FALSE(defaultNote.empty());
     REQUIRE_FALSE(dspClueText.empty());
 
-    std::string savedNote = fileOp.load(slotDir + "/NOTES_STATE/AVERY/Avery_Note.md");
+    std::string savedNote = readStartSlot(fileOp, slot).notes["AVERY/Avery_Note.md"];
     REQUIRE(savedNote == defaultNote);
     REQUIRE(savedNote.find(dspClueText) == std::string::npos);
 
@@ -225,8 +232,10 @@ TEST_CASE("Clue discovery appends text to note after save creation", "[GameRunne
     GameRunner runner(fileOp, renderer);
     runner.loadScene("/LOCATIONS/AVERY/DESK/BOOKS/DSP_CLUE/DSP_Clue.json");
 
-    // Step 4: The DSP clue text must appear in the on-disk NOTES_STATE file
-    //         written to the test output directory.
+    // Step 4: Discovery is written behind; once flushed, the DSP clue text
+    //         must appear in the on-disk NOTES_STATE file written to the
+    //         test output directory.
+    runner.flushGameState();
     std::string writtenNote = fileOp.load(k_OutputDir + "/GAME_STATE/NOTES_STATE/AVERY/Avery_Note.md");
     REQUIRE(writtenNote.find(dspClueText) != std::string::npos);
 }
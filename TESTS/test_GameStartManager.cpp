@@ -1,7 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
+#include "GAME_RUNNER/GameRunner.h"
 #include "GAME_RUNNER/GameStartManager.h"
 #include "GAME_STATE/GameStateComparison.h"
-#include "UTIL/TestFileOperator.h"
+#include "GAME_STATE/SlotContainer.h"
+#include "UTIL/CountingFileOperator.h"
+#include "UTIL/NullGraphicsRenderer.h"
+#include <nlohmann/json.hpp>
 #include <algorithm>
 #include <filesystem>
 
@@ -31,9 +35,9 @@ static void prepareOutputDir()
     fs::create_directories(k_OutputDir);
 }
 
-// Runs save() and returns the slot directory that was written.
+// Runs save() and returns the slot that was written.
 // Always loads Game_State.json and the full NOTES_STATE into the in-memory map.
-static std::string runSave(TestFileOperator& fileOp)
+static int runSave(TestFileOperator& fileOp)
 {
     prepareOutputDir();
 
@@ -46,15 +50,18 @@ static std::string runSave(TestFileOperator& fileOp)
         fileOp.files[path] = content;
     }
 
-    // Pre-compute the slot that GameStartManager will choose.
-    int nextSlot = 0;
-    while (fs::exists(k_OutputDir + "/KSC_SLOT_" + std::to_string(nextSlot)))
-        nextSlot++;
-
     GameStartManager manager(fileOp, k_OutputDir);
-    manager.save();
+    int slot = manager.save();
+    REQUIRE(fs::is_regular_file(k_OutputDir + "/KSC_SLOT_" + std::to_string(slot) + ".ksc"));
+    return slot;
+}
 
-    return k_OutputDir + "/KSC_SLOT_" + std::to_string(nextSlot);
+// Reads a slot back as it was saved.
+static GameStartManager::SlotContents readSavedSlot(TestFileOperator& fileOp, int slot)
+{
+    GameStartManager::SlotContents contents;
+    REQUIRE(GameStartManager(fileOp, k_OutputDir).readSlot(slot, contents));
+    return contents;
 }
 
 TEST_CASE("GameStartManager setSaveDir updates the save directory", "[GameStartManager]")
@@ -69,13 +76,11 @@ TEST_CASE("GameStartManager setSaveDir updates the save directory", "[GameStartM
     REQUIRE(manager.getSaveDir() == k_OutputDir);
 }
 
-TEST_CASE("GameStartManager save copies golden Game_State.json into slot", "[GameStartManager]")
+TEST_CASE("GameStartManager save keeps golden Game_State.json in slot", "[GameStartManager]")
 {
     TestFileOperator fileOp;
-    std::string slotDir   = runSave(fileOp);
-    std::string savedJson = fileOp.load(slotDir + "/Game_State.json");
+    std::string savedJson = readSavedSlot(fileOp, runSave(fileOp)).gameState;
 
-    REQUIRE(fs::is_directory(slotDir));
     REQUIRE_FALSE(savedJson.empty());
 
     std::string goldenJson = fileOp.load(k_GoldenPath);
@@ -86,8 +91,7 @@ TEST_CASE("GameStartManager save copies golden Game_State.json into slot", "[Gam
 TEST_CASE("GameStartManager save slot is not yet the complete game state", "[GameStartManager]")
 {
     TestFileOperator fileOp;
-    std::string slotDir    = runSave(fileOp);
-    std::string savedJson  = fileOp.load(slotDir + "/Game_State.json");
+    std::string savedJson    = readSavedSlot(fileOp, runSave(fileOp)).gameState;
     std::string completeJson = fileOp.load(k_CompletePath);
 
     REQUIRE_FALSE(savedJson.empty());
@@ -124,19 +128,19 @@ TEST_CASE("GameStartManager save slot is not yet the complete game state", "[Gam
     }
 }
 
-TEST_CASE("GameStartManager save copies NOTES_STATE into slot", "[GameStartManager]")
+TEST_CASE("GameStartManager save keeps NOTES_STATE in slot", "[GameStartManager]")
 {
     TestFileOperator fileOp;
-    std::string slotDir = runSave(fileOp);
+    auto notes = readSavedSlot(fileOp, runSave(fileOp)).notes;
 
-    SECTION("NOTES_STATE/AVERY subdirectory exists")
+    SECTION("the slot holds exactly the AVERY and LIBRARY notes")
     {
-        REQUIRE(fs::is_directory(slotDir + "/NOTES_STATE/AVERY"));
+        REQUIRE(notes.size() == 2);
     }
 
     SECTION("Avery_Note.md content matches original")
     {
-        std::string written  = fileOp.load(slotDir + "/NOTES_STATE/AVERY/Avery_Note.md");
+        std::string written  = notes["AVERY/Avery_Note.md"];
         std::string original = fileOp.load("KSC_DATA/GAME_STATE/NOTES_STATE/AVERY/Avery_Note.md");
         REQUIRE_FALSE(written.empty());
         REQUIRE(written == original);
@@ -144,9 +148,681 @@ TEST_CASE("GameStartManager save copies NOTES_STATE into slot", "[GameStartManag
 
     SECTION("Library_Note.md content matches original")
     {
-        std::string written  = fileOp.load(slotDir + "/NOTES_STATE/LIBRARY/Library_Note.md");
+        std::string written  = notes["LIBRARY/Library_Note.md"];
         std::string original = fileOp.load("KSC_DATA/GAME_STATE/NOTES_STATE/LIBRARY/Library_Note.md");
         REQUIRE_FALSE(written.empty());
         REQUIRE(written == original);
     }
 }
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Delta slots
+
+static const std::string k_DeltaOutputDir = "TESTS/OUTPUT/GAME_START_MANAGER/DELTA_SLOTS";
+static const std::string k_DspCluePath    = "/LOCATIONS/AVERY/DESK/BOOKS/DSP_CLUE/DSP_Clue.json";
+static const std::string k_DeskBooksPath  = "/LOCATIONS/AVERY/DESK/BOOKS/FULL/Avery_Desk_Books.json";
+
+static size_t totalBytes(const CountingFileOperator& fileOp)
+{
+    size_t total = 0;
+    for (const auto& [path, bytes] : fileOp.written) total += bytes;
+    return total;
+}
+
+static int noteStoreWrites(const CountingFileOperator& fileOp)
+{
+    int count = 0;
+    for (const auto& [path, bytes] : fileOp.written)
+        count += path.find("/NOTE_STORE/") != std::string::npos;
+    return count;
+}
+
+static int noteStoreLoads(const CountingFileOperator& fileOp)
+{
+    return (int)std::count_if(fileOp.loads.begin(), fileOp.loads.end(), [](const std::string& path)
+                              { return path.find("/NOTE_STORE/") != std::string::npos; });
+}
+
+static void prepareDeltaSlots(CountingFileOperator& fileOp)
+{
+    fs::remove_all(k_DeltaOutputDir);
+    fs::create_directories(k_DeltaOutputDir);
+    fileOp.diskRoot     = "KSC_DATA";
+    fileOp.memoryWrites = true; // GAME_STATE writes (restores) stay in memory; slots go to disk
+    for (const std::string& path : { k_GoldenPath, k_AveryNotePath, k_LibraryNotePath })
+        fileOp.files[path] = fileOp.load(path);
+}
+
+// Discovers the DSP clue the way a session would: the scene in Game_State.json
+// and its text at the end of the Avery note.
+static void discoverDspClue(CountingFileOperator& fileOp)
+{
+    nlohmann::json state = nlohmann::json::parse(fileOp.files[k_GoldenPath]);
+    state["avery_locations"][k_DspCluePath] = true;
+    state["currentMode"]                     = "notes";
+    fileOp.files[k_GoldenPath]               = state.dump(2);
+    fileOp.files[k_AveryNotePath]           += fileOp.load("/NOTES/AVERY/AUDIOPHILE/DSP_Clue.md");
+}
+
+static std::string deltaSlotPath(int slot)
+{
+    return k_DeltaOutputDir + "/KSC_SLOT_" + std::to_string(slot) + ".ksc";
+}
+
+static SlotContainer openDeltaSlot(CountingFileOperator& fileOp, int slot)
+{
+    SlotContainer container;
+    REQUIRE(container.open(fileOp.load(deltaSlotPath(slot))));
+    return container;
+}
+
+static nlohmann::json deltaOf(const SlotContainer& container)
+{
+    REQUIRE(container.contains(GameStartManager::k_DeltaFile));
+    return nlohmann::json::parse(container.get(GameStartManager::k_DeltaFile));
+}
+
+TEST_CASE("GameStartManager later saves store only what changed since the base", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+    const std::string baseState = fileOp.files[k_GoldenPath];
+    const std::string baseNote  = fileOp.files[k_AveryNotePath];
+
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    REQUIRE(manager.save() == 0);
+    CHECK(fileOp.written.size() == 4); // two note blobs, the slot and the index
+    CHECK(noteStoreWrites(fileOp) == 2);
+    SlotContainer base = openDeltaSlot(fileOp, 0);
+    CHECK(base.names() == std::vector<std::string>{ "Game_State.json", GameStartManager::k_NoteManifest });
+    nlohmann::json manifest = nlohmann::json::parse(base.get(GameStartManager::k_NoteManifest));
+    CHECK(manifest.size() == 2);
+    CHECK(fileOp.load(k_DeltaOutputDir + "/NOTE_STORE/" + manifest["AVERY/Avery_Note.md"].get<std::string>())
+          == baseNote);
+
+    discoverDspClue(fileOp);
+    fileOp.written.clear();
+    REQUIRE(manager.save() == 1);
+
+    // One slot file and the index, nothing else.
+    CHECK(fileOp.written.size() == 2);
+    CHECK(fileOp.written.count(deltaSlotPath(1)) == 1);
+    CHECK(fileOp.written.count(k_DeltaOutputDir + "/" + GameStartManager::k_IndexFiles[0]) == 1); // second commit
+
+    SlotContainer  slot1 = openDeltaSlot(fileOp, 1);
+    nlohmann::json delta = deltaOf(slot1);
+    CHECK_FALSE(slot1.contains("Game_State.json"));
+    CHECK(delta["base_slot"] == 0);
+    CHECK(delta["scalars"]["currentMode"] == "notes");
+    CHECK(delta["discoveries"]["avery_locations"][k_DspCluePath] == true);
+    CHECK_FALSE(delta.contains("state"));
+    CHECK(delta["notes"] == nlohmann::json{ { "AVERY/Avery_Note.md", "append" } });
+    CHECK(slot1.get("NOTES_STATE/AVERY/Avery_Note.md") == fileOp.load("/NOTES/AVERY/AUDIOPHILE/DSP_Clue.md"));
+
+    SECTION("a delta slot reads back as the state it saved")
+    {
+        GameStartManager::SlotContents slot;
+        REQUIRE(manager.readSlot(1, slot));
+        CHECK(nlohmann::json::parse(slot.gameState) == nlohmann::json::parse(fileOp.files[k_GoldenPath]));
+        CHECK(slot.notes["AVERY/Avery_Note.md"] == fileOp.files[k_AveryNotePath]);
+        CHECK(slot.notes["LIBRARY/Library_Note.md"] == fileOp.files[k_LibraryNotePath]);
+    }
+
+    SECTION("the base slot is unchanged")
+    {
+        GameStartManager::SlotContents slot;
+        REQUIRE(manager.readSlot(0, slot));
+        CHECK(slot.gameState == baseState);
+        CHECK(slot.notes["AVERY/Avery_Note.md"] == baseNote);
+    }
+
+    SECTION("a rewritten note and keys the diff does not cover are stored whole")
+    {
+        nlohmann::json state = nlohmann::json::parse(fileOp.files[k_GoldenPath]);
+        state["version"] = 2;
+        fileOp.files[k_GoldenPath]      = state.dump(2);
+        fileOp.files[k_LibraryNotePath] = "# Rewritten\n";
+        REQUIRE(manager.save() == 2);
+
+        SlotContainer  slot2     = openDeltaSlot(fileOp, 2);
+        nlohmann::json rewritten = deltaOf(slot2);
+        CHECK(rewritten.contains("state"));
+        CHECK(rewritten["notes"]["LIBRARY/Library_Note.md"] == "text");
+        CHECK(slot2.get("NOTES_STATE/LIBRARY/Library_Note.md") == "# Rewritten\n");
+
+        GameStartManager::SlotContents slot;
+        REQUIRE(manager.readSlot(2, slot));
+        CHECK(nlohmann::json::parse(slot.gameState) == state);
+        CHECK(slot.notes["LIBRARY/Library_Note.md"] == "# Rewritten\n");
+        CHECK(slot.notes["AVERY/Avery_Note.md"] == fileOp.files[k_AveryNotePath]);
+    }
+}
+
+TEST_CASE("GameStartManager save cost does not grow with note size", "[GameStartManager]")
+{
+    auto deltaBytes = [](size_t notePadding)
+    {
+        CountingFileOperator fileOp;
+        prepareDeltaSlots(fileOp);
+        fileOp.files[k_AveryNotePath] += std::string(notePadding, '.');
+
+        GameStartManager manager(fileOp, k_DeltaOutputDir);
+        manager.save();
+        discoverDspClue(fileOp);
+        fileOp.written.clear();
+        int slot = manager.save();
+        CHECK(totalBytes(fileOp) < 1024);
+        return fileOp.written[deltaSlotPath(slot)];
+    };
+
+    CHECK(deltaBytes(64 * 1024) == deltaBytes(0));
+}
+
+TEST_CASE("GameStartManager slot index replaces the save dir scan", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+
+    // Slots left by a version without an index.
+    for (int slot : { 0, 1, 4 })
+        fs::create_directories(k_DeltaOutputDir + "/KSC_SLOT_" + std::to_string(slot));
+
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    CHECK(manager.save() == 5);
+    CHECK(fileOp.listCounts[k_DeltaOutputDir] == 1);
+    CHECK(openDeltaSlot(fileOp, 5).contains("Game_State.json"));
+
+    for (int expected = 6; expected < 10; ++expected)
+        CHECK(manager.save() == expected);
+    CHECK(fileOp.listCounts[k_DeltaOutputDir] == 1);
+
+    SECTION("a lost index falls back to scanning and a new base")
+    {
+        for (const char* file : GameStartManager::k_IndexFiles)
+            fs::remove(k_DeltaOutputDir + "/" + file);
+        CHECK(manager.save() == 10);
+        CHECK(fileOp.listCounts[k_DeltaOutputDir] == 2);
+        CHECK(openDeltaSlot(fileOp, 10).contains("Game_State.json"));
+    }
+
+    SECTION("a delta that outgrows the rebase limit becomes the next base")
+    {
+        fileOp.files[k_AveryNotePath] += std::string(GameStartManager::k_RebaseBytes, '.');
+        CHECK(manager.save() == 10);
+        CHECK(openDeltaSlot(fileOp, 10).contains("Game_State.json"));
+
+        fileOp.files[k_AveryNotePath] += "one more line\n";
+        CHECK(manager.save() == 11);
+        SlotContainer slot11 = openDeltaSlot(fileOp, 11);
+        CHECK(deltaOf(slot11)["base_slot"] == 10);
+        CHECK(slot11.get("NOTES_STATE/AVERY/Avery_Note.md") == "one more line\n");
+    }
+}
+
+TEST_CASE("GameStartManager slots compare and restore in any form", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+    const std::string baseState = fileOp.files[k_GoldenPath];
+    const std::string baseNote  = fileOp.files[k_AveryNotePath];
+
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    REQUIRE(manager.save() == 0);
+    discoverDspClue(fileOp);
+    REQUIRE(manager.save() == 1);
+
+    SECTION("exported slots diff like Game_State documents, plus their notes")
+    {
+        GameStateComparison cmp(manager.exportSlot(0), manager.exportSlot(1));
+        auto diff = cmp.getDiff();
+        REQUIRE(diff.scalars.size() == 1);
+        CHECK(diff.scalars[0].after == "notes");
+        REQUIRE(diff.discoveries.size() == 1);
+        CHECK(diff.discoveries[0].path == k_DspCluePath);
+        CHECK(diff.entries == std::vector<std::string>{ "NOTES_STATE/AVERY/Avery_Note.md" });
+        CHECK(manager.exportSlot(42).empty());
+    }
+
+    SECTION("a slot directory from before the container still reads back")
+    {
+        const std::string dir = k_DeltaOutputDir + "/KSC_SLOT_7";
+        fileOp.writeToFile(dir + "/Game_State.json", baseState);
+        fileOp.writeToFile(dir + "/NOTES_STATE/AVERY/Avery_Note.md", "legacy\n");
+
+        GameStartManager::SlotContents slot;
+        REQUIRE(manager.readSlot(7, slot));
+        CHECK(slot.gameState == baseState);
+        CHECK(slot.notes == std::map<std::string, std::string>{ { "AVERY/Avery_Note.md", "legacy\n" } });
+    }
+
+    SECTION("restore writes the slot back over GAME_STATE")
+    {
+        fileOp.files[GameState::k_JournalPath] = "KSCJ stale";
+        REQUIRE(manager.restore(0));
+        CHECK(fileOp.files[k_GoldenPath] == baseState);
+        CHECK(fileOp.files[k_AveryNotePath] == baseNote);
+        CHECK(fileOp.files[GameState::k_JournalPath].empty());
+
+        fileOp.written.clear();
+        CHECK_FALSE(manager.restore(42));
+        CHECK(fileOp.written.empty());
+    }
+
+    SECTION("power lost after the first restore write leaves no stale journal")
+    {
+        fileOp.files[GameState::k_JournalPath] = "KSCJ stale";
+        fileOp.writesBeforePowerLoss = 1;
+        REQUIRE(manager.restore(0));
+        fileOp.writesBeforePowerLoss = -1;
+        CHECK(fileOp.files[GameState::k_JournalPath].empty());
+    }
+}
+
+TEST_CASE("GameRunner restoreSlot resumes from a saved slot", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+    const std::string baseNote = fileOp.files[k_AveryNotePath];
+    NullGraphicsRenderer renderer;
+
+    // The slot is saved at a scene below Avery's root, before the clue is
+    // found, from the in-memory state as start_button saves it.
+    GameRunner runner(fileOp, renderer, "locations", "", k_DeltaOutputDir);
+    runner.loadScene(k_DeskBooksPath);
+    runner.flushGameState();
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    REQUIRE(manager.beginSave(runner.getGameState().toJson()));
+    manager.waitForSave();
+    int saved = -1;
+    REQUIRE(manager.pollCompleted(saved));
+    REQUIRE(saved == 0);
+
+    runner.loadScene(k_DspCluePath);
+    runner.flushGameState();
+    REQUIRE(runner.getGameState().isDiscovered(k_DspCluePath));
+    REQUIRE(fileOp.files[k_AveryNotePath] != baseNote);
+
+    REQUIRE(runner.restoreSlot(0));
+    CHECK_FALSE(runner.getGameState().isDiscovered(k_DspCluePath));
+    CHECK(fileOp.files[k_AveryNotePath] == baseNote);
+
+    // Discovering the clue again appends it again.
+    runner.loadScene(k_DspCluePath);
+    runner.flushGameState();
+    CHECK(fileOp.files[k_AveryNotePath] == baseNote + fileOp.load("/NOTES/AVERY/AUDIOPHILE/DSP_Clue.md"));
+    CHECK_FALSE(runner.restoreSlot(42));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Shared notes and resuming
+
+TEST_CASE("GameStartManager bases share unchanged note content", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+    const std::string baseNote = fileOp.files[k_AveryNotePath];
+
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    REQUIRE(manager.save() == 0);
+    const nlohmann::json manifest0 = nlohmann::json::parse(openDeltaSlot(fileOp, 0).get(GameStartManager::k_NoteManifest));
+
+    SECTION("a new base writes only the notes that changed")
+    {
+        fileOp.files[k_AveryNotePath] += std::string(GameStartManager::k_RebaseBytes, '.');
+        fileOp.written.clear();
+        REQUIRE(manager.save() == 1);
+        CHECK(noteStoreWrites(fileOp) == 1);
+
+        const nlohmann::json manifest1 = nlohmann::json::parse(openDeltaSlot(fileOp, 1).get(GameStartManager::k_NoteManifest));
+        CHECK(manifest1["LIBRARY/Library_Note.md"] == manifest0["LIBRARY/Library_Note.md"]);
+        CHECK(manifest1["AVERY/Avery_Note.md"] != manifest0["AVERY/Avery_Note.md"]);
+
+        GameStartManager::SlotContents slot0, slot1;
+        REQUIRE(manager.readSlot(0, slot0));
+        REQUIRE(manager.readSlot(1, slot1));
+        CHECK(slot0.notes["AVERY/Avery_Note.md"] == baseNote);
+        CHECK(slot1.notes["AVERY/Avery_Note.md"] == fileOp.files[k_AveryNotePath]);
+        CHECK(slot0.notes["LIBRARY/Library_Note.md"] == slot1.notes["LIBRARY/Library_Note.md"]);
+    }
+
+    SECTION("a different text under a stored blob's name stays in the slot")
+    {
+        const std::string libraryBlob = manifest0["LIBRARY/Library_Note.md"].get<std::string>();
+        prepareDeltaSlots(fileOp);
+        fileOp.TestFileOperator::writeToFile(k_DeltaOutputDir + "/NOTE_STORE/" + libraryBlob, "collision\n");
+
+        GameStartManager fresh(fileOp, k_DeltaOutputDir);
+        REQUIRE(fresh.save() == 0);
+        SlotContainer base = openDeltaSlot(fileOp, 0);
+        CHECK(base.get("NOTES_STATE/LIBRARY/Library_Note.md") == fileOp.files[k_LibraryNotePath]);
+
+        GameStartManager::SlotContents slot;
+        REQUIRE(fresh.readSlot(0, slot));
+        CHECK(slot.notes["LIBRARY/Library_Note.md"] == fileOp.files[k_LibraryNotePath]);
+        CHECK(slot.notes["AVERY/Avery_Note.md"] == baseNote);
+    }
+}
+
+TEST_CASE("GameStartManager load reads notes only when taken", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    REQUIRE(manager.save() == 0);
+    discoverDspClue(fileOp);
+    REQUIRE(manager.save() == 1);
+
+    fileOp.loads.clear();
+    std::string state;
+    REQUIRE(manager.load(1, state));
+    CHECK(nlohmann::json::parse(state) == nlohmann::json::parse(fileOp.files[k_GoldenPath]));
+    CHECK(fileOp.loads == std::vector<std::string>{ deltaSlotPath(1), deltaSlotPath(0) });
+    CHECK(manager.getLoadedNotes() == std::vector<std::string>{ "AVERY/Avery_Note.md", "LIBRARY/Library_Note.md" });
+
+    std::string text;
+    REQUIRE(manager.takeLoadedNote("AVERY/Avery_Note.md", text));
+    CHECK(text == fileOp.files[k_AveryNotePath]); // the base blob plus the appended clue
+    CHECK(noteStoreLoads(fileOp) == 1);
+    CHECK_FALSE(manager.takeLoadedNote("AVERY/Avery_Note.md", text));
+    CHECK(manager.getLoadedNotes() == std::vector<std::string>{ "LIBRARY/Library_Note.md" });
+
+    CHECK_FALSE(manager.load(42, state));
+    CHECK(manager.getLoadedNotes().size() == 1);
+}
+
+TEST_CASE("GameRunner loadSlot applies discoveries now and the rest on first use", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+    const std::string baseNote = fileOp.files[k_AveryNotePath];
+    const std::string dspText  = fileOp.load("/NOTES/AVERY/AUDIOPHILE/DSP_Clue.md");
+    NullGraphicsRenderer renderer;
+
+    // The slot is saved at a scene below Avery's root, before the clue is
+    // found, from the in-memory state as start_button saves it.
+    GameRunner runner(fileOp, renderer, "locations", "", k_DeltaOutputDir);
+    runner.loadScene(k_DeskBooksPath);
+    runner.flushGameState();
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    REQUIRE(manager.beginSave(runner.getGameState().toJson()));
+    manager.waitForSave();
+    int saved = -1;
+    REQUIRE(manager.pollCompleted(saved));
+    REQUIRE(saved == 0);
+
+    runner.loadScene(k_DspCluePath);
+    runner.flushGameState();
+    const std::string sessionNote = fileOp.files[k_AveryNotePath];
+    REQUIRE(sessionNote == baseNote + dspText);
+
+    fileOp.loads.clear();
+    fileOp.written.clear();
+    REQUIRE(runner.loadSlot(0));
+    CHECK_FALSE(runner.getGameState().isDiscovered(k_DspCluePath));
+    CHECK(fileOp.loads == std::vector<std::string>{ deltaSlotPath(0) });
+    CHECK(fileOp.written.empty());
+
+    // The slot's last location is built by the first frame, not Avery's root.
+    runner.draw();
+    CHECK(std::any_of(fileOp.loads.begin(), fileOp.loads.end(), [](const std::string& path)
+                      { return path.find("/LOCATIONS/AVERY/DESK/BOOKS/FULL/") == 0; }));
+    CHECK_FALSE(std::any_of(fileOp.loads.begin(), fileOp.loads.end(), [](const std::string& path)
+                            { return path.find("/LOCATIONS/AVERY/ROOT/") == 0; }));
+    CHECK(runner.getCurrentMode() == "locations");
+    CHECK(runner.getGameState().getCurrentLocation() == k_DeskBooksPath);
+    CHECK(noteStoreLoads(fileOp) == 0);
+    CHECK(fileOp.files[k_AveryNotePath] == sessionNote);
+
+    SECTION("idle restores a note per call before the state is written")
+    {
+        runner.idle();
+        CHECK(fileOp.written.size() == 1);
+        runner.idle();
+        CHECK(fileOp.written.size() == 2);
+        CHECK(fileOp.files[k_AveryNotePath] == baseNote);
+
+        runner.flushGameState();
+        CHECK(fileOp.files[GameState::k_JournalPath].empty());
+        GameRunner restarted(fileOp, renderer);
+        CHECK_FALSE(restarted.getGameState().isDiscovered(k_DspCluePath));
+    }
+
+    SECTION("discovering the clue again restores the note before appending")
+    {
+        runner.loadScene(k_DspCluePath);
+        CHECK(fileOp.files[k_AveryNotePath] == baseNote);
+        CHECK(noteStoreLoads(fileOp) == 1);
+        runner.flushGameState();
+        CHECK(fileOp.files[k_AveryNotePath] == baseNote + dspText);
+    }
+
+    CHECK_FALSE(runner.loadSlot(42));
+}
+
+TEST_CASE("GameRunner loadSlot leaves the session alone when the slot is corrupt", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+    NullGraphicsRenderer renderer;
+
+    GameRunner runner(fileOp, renderer, "locations", "", k_DeltaOutputDir);
+    runner.loadScene(k_DspCluePath);
+    runner.flushGameState();
+    const std::string sessionNote = fileOp.files[k_AveryNotePath];
+
+    const std::string dir = k_DeltaOutputDir + "/KSC_SLOT_7";
+    fileOp.writeToFile(dir + "/Game_State.json", "{ \"currentMode\": ");
+    fileOp.writeToFile(dir + "/NOTES_STATE/AVERY/Avery_Note.md", "corrupt\n");
+
+    CHECK_FALSE(runner.loadSlot(7));
+    CHECK(runner.getGameState().isDiscovered(k_DspCluePath));
+    CHECK_FALSE(runner.getGameState().isDirty());
+
+    // None of the slot's notes are restored over the session's.
+    fileOp.written.clear();
+    runner.idle();
+    CHECK(fileOp.written.empty());
+    CHECK(fileOp.files[k_AveryNotePath] == sessionNote);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Asynchronous saves
+
+TEST_CASE("GameStartManager idle-mode save runs a step at a time and commits last", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    manager.setBackground(false);
+    REQUIRE(manager.beginSave(fileOp.files[k_GoldenPath]));
+    CHECK(manager.isSaving());
+    CHECK(fileOp.written.empty());
+
+    int slices = 0;
+    while (manager.isSaving())
+    {
+        size_t before = fileOp.writes.size();
+        REQUIRE(manager.runIdleSlice());
+        CHECK(fileOp.writes.size() - before <= 1);
+        slices++;
+    }
+    CHECK(slices > 3);
+    CHECK_FALSE(manager.runIdleSlice());
+
+    // Note blobs, then the slot naming them, then the index.
+    REQUIRE(fileOp.writes.size() == 4);
+    CHECK(fileOp.writes[0].find("/NOTE_STORE/") != std::string::npos);
+    CHECK(fileOp.writes[1].find("/NOTE_STORE/") != std::string::npos);
+    CHECK(fileOp.writes[2] == deltaSlotPath(0));
+    CHECK(fileOp.writes[3].find("KSC_Slots_") != std::string::npos);
+
+    int slot = -2;
+    REQUIRE(manager.pollCompleted(slot));
+    CHECK(slot == 0);
+    CHECK_FALSE(manager.pollCompleted(slot));
+
+    GameStartManager::SlotContents contents;
+    REQUIRE(manager.readSlot(0, contents));
+    CHECK(contents.gameState == fileOp.files[k_GoldenPath]);
+    CHECK(contents.notes.size() == 2);
+}
+
+TEST_CASE("GameStartManager background save reports completion", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    manager.setBackground(true);
+    REQUIRE(manager.isBackground() == (KSC_HAS_THREADS != 0));
+
+    REQUIRE(manager.beginSave(fileOp.files[k_GoldenPath]));
+    REQUIRE(manager.beginSave(fileOp.files[k_GoldenPath])); // finishes the first save, then starts
+    manager.waitForSave();
+    CHECK_FALSE(manager.isSaving());
+
+    int first = -2, second = -2;
+    REQUIRE(manager.pollCompleted(first));
+    REQUIRE(manager.pollCompleted(second));
+    CHECK(first == 0);
+    CHECK(second == 1);
+    CHECK(openDeltaSlot(fileOp, 1).contains(GameStartManager::k_DeltaFile));
+
+    SECTION("a save with nothing to write fails without committing")
+    {
+        REQUIRE(manager.beginSave(""));
+        manager.waitForSave();
+        int failed = 0;
+        REQUIRE(manager.pollCompleted(failed));
+        CHECK(failed == -1);
+        CHECK(manager.save() == 2);
+    }
+}
+
+TEST_CASE("GameStartManager power loss before a commit loses only that save", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+    {
+        GameStartManager manager(fileOp, k_DeltaOutputDir);
+        REQUIRE(manager.save() == 0);
+        REQUIRE(manager.save() == 1);
+    }
+
+    SECTION("the index never landed")
+    {
+        fileOp.lostWrites = "KSC_Slots_";
+        REQUIRE(GameStartManager(fileOp, k_DeltaOutputDir).save() == 2);
+        fileOp.lostWrites.clear();
+
+        // The uncommitted slot number is reused; earlier slots are intact.
+        CHECK(GameStartManager(fileOp, k_DeltaOutputDir).save() == 2);
+        GameStartManager::SlotContents contents;
+        CHECK(GameStartManager(fileOp, k_DeltaOutputDir).readSlot(1, contents));
+    }
+
+    SECTION("the index landed torn")
+    {
+        // Commit 2 went to the first copy.
+        std::string newest = k_DeltaOutputDir + "/" + GameStartManager::k_IndexFiles[0];
+        std::string text   = fileOp.load(newest);
+        fileOp.TestFileOperator::writeToFile(newest, text.substr(0, text.size() / 2));
+
+        fileOp.listCounts.clear();
+        CHECK(GameStartManager(fileOp, k_DeltaOutputDir).save() == 1);
+        CHECK(fileOp.listCounts[k_DeltaOutputDir] == 0);
+    }
+
+    SECTION("both copies lost")
+    {
+        for (const char* file : GameStartManager::k_IndexFiles)
+            fs::remove(k_DeltaOutputDir + "/" + file);
+        CHECK(GameStartManager(fileOp, k_DeltaOutputDir).save() == 2);
+    }
+}
+
+TEST_CASE("GameRunner start button shows the first scene before the save is written", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+    NullGraphicsRenderer renderer;
+
+    GameRunner runner(fileOp, renderer, "locations", "", k_DeltaOutputDir);
+    runner.setBackgroundSave(false);
+    std::vector<int> saved;
+    runner.setSaveListener([&](int slot) { saved.push_back(slot); });
+
+    const std::string startScreen = "/BANNERS/START_SCREEN/Start_Screen.json";
+    runner.loadScene(startScreen);
+    nlohmann::json doc = nlohmann::json::parse(fileOp.load(startScreen));
+    for (auto& zone : doc["zones"])
+        if (zone.value("id", "") == "start_button")
+            runner.registerHit(zone.value("x", 0) + zone.value("width", 0) / 2,
+                               zone.value("y", 0) + zone.value("height", 0) / 2);
+
+    CHECK(runner.isSaving());
+    CHECK(fileOp.written.empty());
+
+    // A discovery while saving waits in memory until the save commits.
+    runner.loadScene(k_DspCluePath);
+    const std::string noteBefore = fileOp.files[k_AveryNotePath];
+    while (runner.isSaving())
+    {
+        runner.idle();
+        CHECK(fileOp.files[k_AveryNotePath] == noteBefore);
+    }
+    runner.idle();
+    CHECK(saved == std::vector<int>{ 0 });
+
+    GameStartManager::SlotContents contents;
+    REQUIRE(GameStartManager(fileOp, k_DeltaOutputDir).readSlot(0, contents));
+    CHECK_FALSE(nlohmann::json::parse(contents.gameState)["avery_locations"][k_DspCluePath].get<bool>());
+    CHECK(contents.notes["AVERY/Avery_Note.md"] == noteBefore);
+
+    runner.flushGameState();
+    CHECK(fileOp.files[k_AveryNotePath] != noteBefore);
+}
+
+TEST_CASE("GameRunner start button lets a running save finish before flushing", "[GameStartManager]")
+{
+    CountingFileOperator fileOp;
+    prepareDeltaSlots(fileOp);
+    NullGraphicsRenderer renderer;
+
+    GameRunner runner(fileOp, renderer, "locations", "", k_DeltaOutputDir);
+    runner.setBackgroundSave(false);
+    std::vector<int> saved;
+    runner.setSaveListener([&](int slot) { saved.push_back(slot); });
+
+    const std::string startScreen = "/BANNERS/START_SCREEN/Start_Screen.json";
+    auto pressStart = [&]
+    {
+        runner.loadScene(startScreen);
+        nlohmann::json doc = nlohmann::json::parse(fileOp.load(startScreen));
+        for (auto& zone : doc["zones"])
+            if (zone.value("id", "") == "start_button")
+                runner.registerHit(zone.value("x", 0) + zone.value("width", 0) / 2,
+                                   zone.value("y", 0) + zone.value("height", 0) / 2);
+    };
+
+    pressStart();
+    REQUIRE(runner.isSaving());
+    const std::string noteBefore = fileOp.files[k_AveryNotePath];
+    runner.loadScene(k_DspCluePath);
+
+    // The second press finishes slot 0 before the clue text reaches storage.
+    pressStart();
+    while (runner.isSaving()) runner.idle();
+    runner.idle();
+    CHECK(saved == std::vector<int>{ 0, 1 });
+
+    GameStartManager manager(fileOp, k_DeltaOutputDir);
+    GameStartManager::SlotContents first, second;
+    REQUIRE(manager.readSlot(0, first));
+    REQUIRE(manager.readSlot(1, second));
+    CHECK(first.notes["AVERY/Avery_Note.md"] == noteBefore);
+    CHECK(second.notes["AVERY/Avery_Note.md"] == fileOp.files[k_AveryNotePath]);
+    CHECK(second.notes["AVERY/Avery_Note.md"] != noteBefore);
+}
@@ -0,0 +1,282 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GAME_RUNNER/GameRunner.h"
+#include "GAME_STATE/GameState.h"
+#include "UTIL/CountingFileOperator.h"
+#include "UTIL/NullGraphicsRenderer.h"
+#include <nlohmann/json.hpp>
+
+static const std::string k_StatePath   = "/GAME_STATE/Game_State.json";
+static const std::string k_DspClue     = "/LOCATIONS/AVERY/DESK/BOOKS/DSP_CLUE/DSP_Clue.json";
+static const std::string k_SqlClue     = "/LOCATIONS/AVERY/DESK/BOOKS/SQL_CLUE/SQL_CLUE.json";
+static const std::string k_AveryNote   = "/GAME_STATE/NOTES_STATE/AVERY/Avery_Note.md";
+
+// Journal writes, journal appends and note appends alike.
+static int storageWrites(const CountingFileOperator& fileOp)
+{
+    return fileOp.totalWrites() + fileOp.totalAppends();
+}
+
+// The table KSC_SceneCompiler generated from KSC_DATA.
+static SceneIDTable generatedSceneIDs(TestFileOperator& fileOp)
+{
+    SceneIDTable table;
+    table.load(fileOp.load(SceneIDTable::k_Path));
+    return table;
+}
+
+TEST_CASE("GameState loads and writes back Game_State.json", "[GameState]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    std::string original = fileOp.load(k_StatePath);
+
+    GameState state;
+    REQUIRE(state.load(original));
+    CHECK(state.getCurrentMode() == "locations");
+    REQUIRE(state.getNotes().size() == 2);
+    CHECK(state.getNotes()[0] == k_AveryNote);
+    const GameState::DiscoveryGroup* avery = state.getDiscoveryGroup("avery_locations");
+    REQUIRE(avery);
+    CHECK(avery->ids.size() == 24);
+    CHECK(avery->members.count() == 24);
+    CHECK(state.isDiscovered("/LOCATIONS/AVERY/ROOT/Avery_Full.json"));
+    CHECK_FALSE(state.isDiscovered(k_DspClue));
+    CHECK(state.getDiscovered().count() == 24 - 9);
+    CHECK_FALSE(state.isDirty());
+
+    CHECK(nlohmann::json::parse(state.toJson()) == nlohmann::json::parse(original));
+
+    SECTION("unknown keys survive a round trip")
+    {
+        REQUIRE(state.load(R"({ "currentMode": "notes", "version": 3, "extra": { "a": [1, 2] },
+                                "note_configs": { "clues": { "note_path": "/n.md", "base_path": "/b.md" } },
+                                "clues": { "/c.json": true } })"));
+        nlohmann::json written = nlohmann::json::parse(state.toJson());
+        CHECK(written["version"] == 3);
+        CHECK(written["extra"]["a"][1] == 2);
+        CHECK(written["note_configs"]["clues"]["base_path"] == "/b.md");
+        REQUIRE(state.getNoteConfig("clues"));
+        CHECK(state.getNoteConfig("clues")->notePath == "/n.md");
+        CHECK(state.isDiscovered("/c.json"));
+    }
+
+    SECTION("malformed input leaves an empty state")
+    {
+        CHECK_FALSE(state.load("{ not json"));
+        CHECK(state.getNotes().empty());
+        CHECK_FALSE(state.getDiscoveryGroup("avery_locations"));
+    }
+}
+
+TEST_CASE("GameState batches discoveries into one flush", "[GameState]")
+{
+    CountingFileOperator fileOp;
+    fileOp.memoryWrites = true;
+    fileOp.diskRoot = "KSC_DATA";
+
+    GameState state;
+    state.setSceneIDs(generatedSceneIDs(fileOp));
+    REQUIRE(state.load(fileOp.load(k_StatePath)));
+
+    state.setDiscovered(k_DspClue);
+    state.queueNoteAppend(k_AveryNote, "/NOTES/AVERY/AUDIOPHILE/DSP_Clue.md");
+    state.setDiscovered(k_SqlClue);
+    state.queueNoteAppend(k_AveryNote, "/NOTES/AVERY/BIG_READER/PASSWORD_CLUE.md");
+
+    CHECK(state.isDirty());
+    CHECK(state.isDiscovered(k_DspClue));
+    CHECK(storageWrites(fileOp) == 0);
+
+    state.flush(fileOp);
+    CHECK_FALSE(state.isDirty());
+    CHECK(fileOp.writeCounts[GameState::k_JournalPath] == 1);
+    CHECK(fileOp.appendCounts[k_AveryNote] == 1);
+    CHECK(storageWrites(fileOp) == 2); // no scene files, no Game_State.json
+
+    std::string dsp = fileOp.load("/NOTES/AVERY/AUDIOPHILE/DSP_Clue.md");
+    std::string pwd = fileOp.load("/NOTES/AVERY/BIG_READER/PASSWORD_CLUE.md");
+    CHECK(fileOp.files[k_AveryNote] == dsp + pwd);
+
+    // A 12-byte header and 8 bytes per discovery of a scene with an ID.
+    CHECK(fileOp.files[GameState::k_JournalPath].size() == 12 + 2 * 8);
+    CHECK(state.getJournalBytes() == 28);
+
+    int writes = storageWrites(fileOp);
+    state.flush(fileOp);
+    CHECK(storageWrites(fileOp) == writes);
+}
+
+TEST_CASE("GameState journal replays over Game_State.json", "[GameState]")
+{
+    CountingFileOperator fileOp;
+    fileOp.memoryWrites = true;
+    fileOp.diskRoot = "KSC_DATA";
+    std::string  base     = fileOp.load(k_StatePath);
+    SceneIDTable sceneIDs = generatedSceneIDs(fileOp);
+
+    GameState state;
+    state.setSceneIDs(sceneIDs);
+    REQUIRE(state.load(base));
+    state.setDiscovered(k_DspClue);
+    state.setDiscovered("/NOTES/LOOSE_CLUE.md"); // not in any discovery map
+    state.flush(fileOp);
+    std::string firstFlush = fileOp.files[GameState::k_JournalPath];
+
+    state.setDiscovered(k_SqlClue);
+    state.setDiscovered(k_SqlClue); // already discovered: no record
+    state.flush(fileOp);
+    CHECK(fileOp.appendCounts[GameState::k_JournalPath] == 1);
+    CHECK(fileOp.files[GameState::k_JournalPath].size() == firstFlush.size() + 8);
+
+    const std::string journal = fileOp.files[GameState::k_JournalPath];
+
+    SECTION("a restart sees every journaled discovery")
+    {
+        GameState restarted;
+        restarted.setSceneIDs(sceneIDs);
+        REQUIRE(restarted.load(base));
+        CHECK(restarted.replayJournal(journal) == 3);
+        CHECK(restarted.isDiscovered(k_DspClue));
+        CHECK(restarted.isDiscovered(k_SqlClue));
+        CHECK(restarted.isDiscovered("/NOTES/LOOSE_CLUE.md"));
+        CHECK_FALSE(restarted.isDiscovered(k_AveryNote));
+        CHECK_FALSE(restarted.isDirty());
+        CHECK(restarted.getJournalBytes() == journal.size());
+    }
+
+    SECTION("position changes are journalled, the latest value per flush")
+    {
+        const std::string desk = "/LOCATIONS/AVERY/DESK/MAIN/Avery_Desk.json";
+        state.setCurrentLocation(k_DspClue);
+        state.setCurrentLocation(desk);
+        state.setCurrentMode("notes");
+        state.setCurrentNote(k_AveryNote);
+        CHECK(state.isDirty());
+        int stateWrites = fileOp.writeCounts[k_StatePath];
+        state.flush(fileOp);
+        CHECK_FALSE(state.isDirty());
+        CHECK(fileOp.writeCounts[k_StatePath] == stateWrites); // no Game_State.json rewrite
+        CHECK(fileOp.files[GameState::k_JournalPath].size()
+              == journal.size() + 3 * 9 + std::string("notes").size() + desk.size() + k_AveryNote.size());
+
+        GameState restarted;
+        restarted.setSceneIDs(sceneIDs);
+        REQUIRE(restarted.load(base));
+        CHECK(restarted.replayJournal(fileOp.files[GameState::k_JournalPath]) == 6);
+        CHECK(restarted.getCurrentMode() == "notes");
+        CHECK(restarted.getCurrentLocation() == desk);
+        CHECK(restarted.getCurrentNote() == k_AveryNote);
+        CHECK(restarted.isDiscovered(k_SqlClue));
+    }
+
+    SECTION("a torn last record is dropped and the state compacted")
+    {
+        GameState restarted;
+        restarted.setSceneIDs(sceneIDs);
+        REQUIRE(restarted.load(base));
+        CHECK(restarted.replayJournal(journal.substr(0, journal.size() - 3)) == 2);
+        CHECK_FALSE(restarted.isDiscovered(k_SqlClue));
+        CHECK(restarted.isDirty());
+
+        restarted.flush(fileOp);
+        CHECK(fileOp.files[GameState::k_JournalPath].empty());
+        CHECK(restarted.getJournalBytes() == 0);
+    }
+
+    SECTION("a journal still replays after scenes are added to the table")
+    {
+        SceneIDTable grown;
+        grown.load(sceneIDs.toText() + "/LOCATIONS/LIBRARY/ROOT/Library.json\n");
+        GameState restarted;
+        restarted.setSceneIDs(grown);
+        REQUIRE(restarted.load(base));
+        CHECK(restarted.replayJournal(journal) == 3);
+        CHECK(restarted.isDiscovered(k_SqlClue));
+    }
+
+    SECTION("a journal written against another table is ignored")
+    {
+        SceneIDTable otherIDs;
+        otherIDs.load("/A.json\n");
+        GameState other;
+        other.setSceneIDs(otherIDs);
+        REQUIRE(other.load(base));
+        CHECK(other.replayJournal(journal) == 0);
+        CHECK(other.getJournalBytes() == 0);
+        CHECK_FALSE(other.isDiscovered(k_DspClue));
+
+        // The next write replaces the stale journal instead of appending to it.
+        other.setDiscovered("/A.json");
+        other.flush(fileOp);
+        CHECK(fileOp.files[GameState::k_JournalPath].size() == 12 + 8);
+    }
+
+    SECTION("compaction folds the journal into Game_State.json")
+    {
+        state.compact(fileOp);
+        CHECK(fileOp.files[GameState::k_JournalPath].empty());
+        CHECK(state.getJournalBytes() == 0);
+
+        nlohmann::json written = nlohmann::json::parse(fileOp.files[k_StatePath]);
+        CHECK(written["avery_locations"][k_DspClue] == true);
+        CHECK(written["discovered"] == nlohmann::json::array({ "/NOTES/LOOSE_CLUE.md" }));
+
+        // Replaying the old journal over the compacted state changes nothing.
+        GameState restarted;
+        restarted.setSceneIDs(sceneIDs);
+        REQUIRE(restarted.load(fileOp.files[k_StatePath]));
+        CHECK(restarted.replayJournal(journal) == 3);
+        CHECK(nlohmann::json::parse(restarted.toJson()) == written);
+    }
+
+    SECTION("power lost mid-compaction after adopt() keeps the old journal out")
+    {
+        // A slot that never saw the journaled discoveries.
+        nlohmann::json slot = nlohmann::json::parse(base);
+        slot["currentLocation"] = "/LOCATIONS/AVERY/DESK/Desk.json";
+        REQUIRE(state.adopt(slot.dump()));
+
+        fileOp.writesBeforePowerLoss = 1;
+        state.compact(fileOp);
+        fileOp.writesBeforePowerLoss = -1;
+
+        // Whichever document is on storage, no old discovery is replayed into it.
+        GameState restarted;
+        restarted.setSceneIDs(sceneIDs);
+        std::string onStorage = fileOp.files.count(k_StatePath) ? fileOp.files[k_StatePath] : base;
+        REQUIRE(restarted.load(onStorage));
+        CHECK(restarted.replayJournal(fileOp.files[GameState::k_JournalPath]) == 0);
+        CHECK_FALSE(restarted.isDiscovered(k_DspClue));
+        CHECK_FALSE(restarted.isDiscovered(k_SqlClue));
+    }
+}
+
+TEST_CASE("GameRunner discovery does not touch storage until flushed", "[GameState]")
+{
+    CountingFileOperator fileOp;
+    fileOp.memoryWrites = true;
+    fileOp.diskRoot = "KSC_DATA";
+    NullGraphicsRenderer renderer;
+
+    {
+        GameRunner runner(fileOp, renderer);
+        runner.loadScene(k_DspClue);
+        CHECK(runner.getGameState().isDiscovered(k_DspClue));
+        CHECK(runner.getGameState().isDirty());
+
+        // Within the write-behind delay idle() leaves the batch alone.
+        runner.idle();
+        CHECK(storageWrites(fileOp) == 0);
+    }
+
+    // Destroying the runner flushes what is still pending: a journal
+    // record and the clue text, without rewriting the scene or the state.
+    CHECK(fileOp.writeCounts[GameState::k_JournalPath] == 1);
+    CHECK(fileOp.appendCounts[k_AveryNote] == 1);
+    CHECK(storageWrites(fileOp) == 2);
+
+    // The next run replays the journal and does not discover the clue again.
+    GameRunner runner(fileOp, renderer);
+    runner.loadScene(k_DspClue);
+    CHECK_FALSE(runner.getGameState().isDirty());
+}
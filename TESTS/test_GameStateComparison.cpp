@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include "GAME_STATE/GameStateComparison.h"
+#include "GAME_STATE/SlotContainer.h"
+#include "UTIL/AllocationCounter.h"
 #include "UTIL/TestFileOperator.h"
+#include <nlohmann/json.hpp>
 #include <algorithm>
 
 // Loads Game_State.json (runtime) vs Game_State_Complete.json (golden).
@@ -73,3 +76,156 @@ TEST_CASE("GameStateComparison detects undiscovered clues vs complete golden sta
         }
     }
 }
+
+TEST_CASE("GameStateComparison diffs two packed save slots", "[GameStateComparison]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+
+    std::string note = fileOp.load("/GAME_STATE/NOTES_STATE/AVERY/Avery_Note.md");
+    std::string current = SlotContainer::pack({ { "Game_State.json", fileOp.load("/GAME_STATE/Game_State.json") },
+                                                { "NOTES_STATE/AVERY/Avery_Note.md", note } });
+    std::string complete = SlotContainer::pack({ { "Game_State.json", fileOp.load("TESTS/GOLDEN/GAME_STATE/Game_State_Complete.json") },
+                                                 { "NOTES_STATE/AVERY/Avery_Note.md", note + "A clue.\n" },
+                                                 { "NOTES_STATE/LIBRARY/Library_Note.md", "# Library\n" } });
+
+    CHECK(GameStateComparison(current, current).isEqual());
+    CHECK(GameStateComparison(current, current).getDiff().isEmpty());
+
+    GameStateComparison cmp(current, complete);
+    REQUIRE_FALSE(cmp.isEqual());
+
+    auto diff = cmp.getDiff();
+    CHECK(diff.scalars.empty());
+    CHECK(diff.discoveries.size() == k_ExpectedUndiscovered.size());
+    CHECK(diff.entries == std::vector<std::string>{ "NOTES_STATE/AVERY/Avery_Note.md",
+                                                    "NOTES_STATE/LIBRARY/Library_Note.md" });
+}
+
+TEST_CASE("GameStateComparison isEqual compares values, not formatting", "[GameStateComparison]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    const nlohmann::json state = nlohmann::json::parse(fileOp.load("/GAME_STATE/Game_State.json"));
+
+    CHECK(GameStateComparison(state.dump(2), state.dump()).isEqual());
+    CHECK(GameStateComparison(state.dump(), state.dump(4) + "\n").isEqual());
+
+    SECTION("key order and number spelling do not matter")
+    {
+        CHECK(GameStateComparison(R"({ "a": 1, "b": { "x": [1, 2.5], "y": null } })",
+                                  R"({"b":{"y":null,"x":[1.0,25e-1]},"a":1e0})").isEqual());
+    }
+
+    SECTION("any changed value does")
+    {
+        nlohmann::json changed = state;
+        changed["avery_locations"]["/LOCATIONS/AVERY/DESK/BOOKS/DSP_CLUE/DSP_Clue.json"] = true;
+        CHECK_FALSE(GameStateComparison(state.dump(2), changed.dump()).isEqual());
+
+        changed = state;
+        changed["notes"] = nlohmann::json::array({ state["notes"][1], state["notes"][0] });
+        CHECK_FALSE(GameStateComparison(state.dump(2), changed.dump()).isEqual());
+
+        changed = state;
+        changed["extra"] = { { "nested", { 1, 2 } } };
+        CHECK_FALSE(GameStateComparison(state.dump(2), changed.dump()).isEqual());
+        CHECK(GameStateComparison(state.dump(2), changed.dump()).getDiff().isEmpty()); // outside the diff
+
+        // Same 64 bits, different values.
+        CHECK_FALSE(GameStateComparison(R"({ "a": -1 })", R"({ "a": 18446744073709551615 })").isEqual());
+    }
+
+    SECTION("malformed documents are equal only to themselves")
+    {
+        CHECK(GameStateComparison("{ not json", "{ not json").isEqual());
+        CHECK_FALSE(GameStateComparison("{ not json", "{ not  json").isEqual());
+        CHECK_FALSE(GameStateComparison(state.dump(), "[]").isEqual());
+    }
+}
+
+TEST_CASE("GameStateComparison reads discovery maps the way GameState does", "[GameStateComparison]")
+{
+    // "mixed" holds a number, so it is not a discovery map; a "currentMode"
+    // object of booleans is one; maps on one side only are not compared.
+    const std::string a = R"({ "mixed": { "/A.json": false, "/B.json": 1 },
+                               "currentMode": { "/C.json": false },
+                               "discovered": ["/E.json"],
+                               "only_a": { "/D.json": false } })";
+    const std::string b = R"({ "mixed": { "/A.json": true, "/B.json": 1 },
+                               "currentMode": { "/C.json": true },
+                               "discovered": { "/E.json": false },
+                               "only_b": { "/D.json": true } })";
+
+    auto diff = GameStateComparison(a, b).getDiff();
+    CHECK(diff.scalars.empty());
+    REQUIRE(diff.discoveries.size() == 1);
+    CHECK(diff.discoveries[0].mapKey == "currentMode");
+    CHECK(diff.discoveries[0].path == "/C.json");
+    CHECK_FALSE(diff.discoveries[0].before);
+    CHECK(diff.discoveries[0].after);
+}
+
+TEST_CASE("GameStateComparison allocations do not follow document size", "[GameStateComparison]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    const nlohmann::json state = nlohmann::json::parse(fileOp.load("/GAME_STATE/Game_State.json"));
+
+    auto allocationsFor = [&](int padding)
+    {
+        nlohmann::json padded = state;
+        padded["history"] = nlohmann::json::array();
+        for (int i = 0; i < padding; ++i)
+            padded["history"].push_back({ i, i * 0.5, true });
+        GameStateComparison cmp(padded.dump(), padded.dump(2));
+
+        AllocationCounter allocations;
+        CHECK(cmp.isEqual());
+        return allocations.count();
+    };
+    CHECK(allocationsFor(5000) == allocationsFor(5));
+}
+
+TEST_CASE("GameStateComparison diffs a directory of slots against a golden file", "[GameStateComparison]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    const std::string golden  = fileOp.load("TESTS/GOLDEN/GAME_STATE/Game_State_Complete.json");
+    const std::string current = fileOp.load("/GAME_STATE/Game_State.json");
+    const std::string dir     = "/SESSIONS";
+
+    // Reformatted copies of golden pass; anything with progress missing fails.
+    for (int i = 0; i < 40; ++i)
+    {
+        std::string name = dir + "/session_" + std::to_string(100 + i) + ".json";
+        fileOp.files[name] = i % 4 == 0 ? current : nlohmann::json::parse(golden).dump(i % 3);
+    }
+    fileOp.files[dir + "/slot.ksc"] = SlotContainer::pack({ { "Game_State.json", golden } });
+    fileOp.files[dir + "/torn.json"] = golden.substr(0, golden.size() / 2);
+
+    auto results = GameStateComparison::compareDirectory(fileOp, dir, golden, 4);
+    REQUIRE(results.size() == 42);
+    CHECK(results[0].name == "session_100.json");
+    CHECK(results.back().name == "torn.json");
+
+    for (const auto& result : results)
+    {
+        INFO(result.name);
+        bool progressMissing = result.name == "torn.json" ||
+                               (result.name.rfind("session_", 0) == 0 && std::stoi(result.name.substr(8)) % 4 == 0);
+        CHECK(result.equal == !progressMissing);
+        if (result.name.rfind("session_", 0) == 0 && progressMissing)
+            CHECK(result.diff.discoveries.size() == k_ExpectedUndiscovered.size());
+    }
+
+    // The same answers on one thread.
+    auto serial = GameStateComparison::compareDirectory(fileOp, dir, golden, 1);
+    REQUIRE(serial.size() == results.size());
+    for (size_t i = 0; i < serial.size(); ++i)
+    {
+        CHECK(serial[i].name == results[i].name);
+        CHECK(serial[i].equal == results[i].equal);
+        CHECK(serial[i].diff.discoveries.size() == results[i].diff.discoveries.size());
+    }
+}
@@ -0,0 +1,172 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GAME_STATE/GameState.h"
+#include "GAME_STATE/GameStateMerge.h"
+#include "UTIL/TestFileOperator.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+static const std::string k_DspClue = "/LOCATIONS/AVERY/DESK/BOOKS/DSP_CLUE/DSP_Clue.json";
+static const std::string k_SqlClue = "/LOCATIONS/AVERY/DESK/BOOKS/SQL_CLUE/SQL_CLUE.json";
+
+static json goldenState()
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    return json::parse(fileOp.load("/GAME_STATE/Game_State.json"));
+}
+
+TEST_CASE("GameStateMerge ORs discoveries from both units", "[GameStateMerge]")
+{
+    json base   = goldenState();
+    json ours   = base;
+    json theirs = base;
+    ours["avery_locations"][k_DspClue]   = true;
+    theirs["avery_locations"][k_SqlClue] = true;
+    theirs["library_locations"] = { { "/LOCATIONS/LIBRARY/ROOT/Library.json", true } };
+    theirs["discovered"]        = { "/NOTES/LOOSE_CLUE.md" };
+
+    auto result = GameStateMerge::merge(base.dump(), ours.dump(), theirs.dump());
+    REQUIRE(result.ok);
+    CHECK(result.conflicts.empty());
+
+    json merged = json::parse(result.json);
+    CHECK(merged["avery_locations"][k_DspClue] == true);
+    CHECK(merged["avery_locations"][k_SqlClue] == true);
+    CHECK(merged["library_locations"]["/LOCATIONS/LIBRARY/ROOT/Library.json"] == true);
+    CHECK(merged["discovered"] == json::array({ "/NOTES/LOOSE_CLUE.md" }));
+
+    SECTION("a side that lost a discovery does not undo it")
+    {
+        json reset = base;
+        reset["avery_locations"]["/LOCATIONS/AVERY/ROOT/Avery_Full.json"] = false;
+        for (auto [a, b] : { std::pair{ reset, ours }, std::pair{ ours, reset } })
+        {
+            auto again = GameStateMerge::merge(base.dump(), a.dump(), b.dump());
+            REQUIRE(again.ok);
+            CHECK(again.conflicts.empty());
+            CHECK(json::parse(again.json)["avery_locations"]["/LOCATIONS/AVERY/ROOT/Avery_Full.json"] == true);
+        }
+    }
+
+    SECTION("a discovery only base has is kept")
+    {
+        json discoveredBase = base;
+        discoveredBase["avery_locations"][k_DspClue] = true;
+        json lost = base;
+        lost["avery_locations"].erase(k_DspClue);
+        auto again = GameStateMerge::merge(discoveredBase.dump(), lost.dump(), lost.dump());
+        REQUIRE(again.ok);
+        CHECK(again.conflicts.empty());
+        CHECK(json::parse(again.json)["avery_locations"][k_DspClue] == true);
+    }
+
+    SECTION("merging is symmetric for discovery")
+    {
+        auto swapped = GameStateMerge::merge(base.dump(), theirs.dump(), ours.dump());
+        REQUIRE(swapped.ok);
+        CHECK(json::parse(swapped.json) == merged);
+    }
+}
+
+TEST_CASE("GameStateMerge takes the side that changed a field and reports conflicts", "[GameStateMerge]")
+{
+    json base   = goldenState();
+    json ours   = base;
+    json theirs = base;
+    theirs["currentMode"]     = "notes";
+    theirs["settings"]        = { { "volume", 3 } };
+    ours["currentLocation"]   = "/LOCATIONS/AVERY/DESK/MAIN/Avery_Desk.json";
+    theirs["currentLocation"] = "/LOCATIONS/LIBRARY/ROOT/Library.json";
+    base["version"]           = 1;
+    ours["version"]           = 2;
+    theirs["version"]         = 1;
+
+    auto result = GameStateMerge::merge(base.dump(), ours.dump(), theirs.dump());
+    REQUIRE(result.ok);
+
+    json merged = json::parse(result.json);
+    CHECK(merged["currentMode"] == "notes");               // only theirs changed it
+    CHECK(merged["settings"]["volume"] == 3);              // only theirs added it
+    CHECK(merged["version"] == 2);                         // only ours changed it
+    CHECK(merged["currentLocation"] == ours["currentLocation"]);
+
+    REQUIRE(result.conflicts.size() == 1);
+    const auto& conflict = result.conflicts[0];
+    CHECK(conflict.ours.field == "currentLocation");
+    CHECK(conflict.ours.before == "");
+    CHECK(conflict.ours.after == ours["currentLocation"]);
+    CHECK(conflict.theirs.after == theirs["currentLocation"]);
+
+    SECTION("unknown keys changed on both sides conflict too")
+    {
+        theirs["version"] = 3;
+        auto both = GameStateMerge::merge(base.dump(), ours.dump(), theirs.dump());
+        REQUIRE(both.conflicts.size() == 2);
+        CHECK(both.conflicts[1].ours.field == "version");
+        CHECK(both.conflicts[1].ours.after == "2");
+        CHECK(both.conflicts[1].theirs.after == "3");
+        CHECK(json::parse(both.json)["version"] == 2);
+    }
+
+    SECTION("note configs take the side that changed them and conflict otherwise")
+    {
+        const json note = { { "note_path", "/GAME_STATE/NOTES_STATE/AVERY/Avery_Note.md" },
+                            { "base_path", "/NOTES/AVERY/Avery_Note_Base.md" } };
+        base["note_configs"]   = { { "avery_locations", note }, { "library_locations", note } };
+        ours["note_configs"]   = base["note_configs"];
+        theirs["note_configs"] = base["note_configs"];
+        theirs["note_configs"]["avery_locations"]["base_path"]   = "/NOTES/AVERY/Theirs.md";
+        ours["note_configs"]["library_locations"]["base_path"]   = "/NOTES/LIBRARY/Ours.md";
+        theirs["note_configs"]["library_locations"]["base_path"] = "/NOTES/LIBRARY/Theirs.md";
+        theirs["note_configs"]["loose"] = note;
+
+        auto both = GameStateMerge::merge(base.dump(), ours.dump(), theirs.dump());
+        REQUIRE(both.ok);
+        json configs = json::parse(both.json)["note_configs"];
+        CHECK(configs["avery_locations"]["base_path"] == "/NOTES/AVERY/Theirs.md");
+        CHECK(configs["library_locations"]["base_path"] == "/NOTES/LIBRARY/Ours.md");
+        CHECK(configs["loose"] == note);
+
+        REQUIRE(both.conflicts.size() == 2);
+        CHECK(both.conflicts[1].ours.field == "note_configs.library_locations");
+        CHECK(json::parse(both.conflicts[1].ours.before) == note);
+        CHECK(json::parse(both.conflicts[1].ours.after)["base_path"] == "/NOTES/LIBRARY/Ours.md");
+        CHECK(json::parse(both.conflicts[1].theirs.after)["base_path"] == "/NOTES/LIBRARY/Theirs.md");
+    }
+
+    SECTION("malformed input fails")
+    {
+        CHECK_FALSE(GameStateMerge::merge(base.dump(), "{ not json", theirs.dump()).ok);
+    }
+}
+
+TEST_CASE("GameStateMerge handles thousands of tracked locations", "[GameStateMerge]")
+{
+    json base = { { "currentMode", "locations" }, { "notes", json::array() } };
+    json& map = base["town_locations"] = json::object();
+    for (int i = 0; i < 5000; ++i)
+        map["/LOCATIONS/TOWN/" + std::to_string(i) + ".json"] = false;
+
+    json ours = base, theirs = base;
+    for (int i = 0; i < 5000; ++i)
+    {
+        std::string path = "/LOCATIONS/TOWN/" + std::to_string(i) + ".json";
+        if (i % 2 == 0) ours["town_locations"][path]   = true;
+        if (i % 3 == 0) theirs["town_locations"][path] = true;
+    }
+
+    auto result = GameStateMerge::merge(base.dump(), ours.dump(), theirs.dump());
+    REQUIRE(result.ok);
+    CHECK(result.conflicts.empty());
+
+    GameState merged;
+    REQUIRE(merged.load(result.json));
+    const GameState::DiscoveryGroup* town = merged.getDiscoveryGroup("town_locations");
+    REQUIRE(town);
+    CHECK(town->ids.size() == 5000);
+    CHECK(merged.getDiscovered().count() == 2500 + 1667 - 834); // even, or a multiple of three
+    CHECK(merged.isDiscovered("/LOCATIONS/TOWN/4.json"));
+    CHECK(merged.isDiscovered("/LOCATIONS/TOWN/9.json"));
+    CHECK_FALSE(merged.isDiscovered("/LOCATIONS/TOWN/7.json"));
+}
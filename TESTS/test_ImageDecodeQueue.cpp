@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GRAPHICS_RENDERER/ImageDecodeQueue.h"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+
+// A stand-in for a decoded image: the path it came from.
+struct FakeImage
+{
+    std::string source;
+};
+
+static ImageDecodeQueue<FakeImage>::Decoder fakeDecoder(std::vector<std::string>* order = nullptr)
+{
+    return [order](const std::string& path, FakeImage& image)
+    {
+        if (order) order->push_back(path);
+        if (path.find("missing") != std::string::npos) return false;
+        image.source = path;
+        return true;
+    };
+}
+
+TEST_CASE("ImageDecodeQueue decodes urgent requests first, each path once", "[ImageDecodeQueue]")
+{
+    std::vector<std::string>    order;
+    ImageDecodeQueue<FakeImage> queue(fakeDecoder(&order), nullptr, 0);
+
+    queue.request("/Parent.png", false);
+    queue.request("/Child.png", false);
+    queue.request("/Scene.png", true);
+    queue.request("/Scene_320x240.png", true);
+    queue.request("/Child.png", false);  // already queued
+    queue.request("/Child.png", true);   // now wanted on screen
+
+    while (queue.runIdleSlice()) {}
+    CHECK(order == std::vector<std::string>{ "/Child.png", "/Scene_320x240.png", "/Scene.png", "/Parent.png" });
+    CHECK(queue.isRequested("/Scene.png"));
+
+    // Decoded but not drained: requesting again does not decode again.
+    queue.request("/Scene.png", true);
+    CHECK_FALSE(queue.runIdleSlice());
+
+    std::vector<std::string> drained;
+    CHECK(queue.drain(3, [&](const std::string& path, FakeImage& image, bool ok)
+    {
+        CHECK(ok);
+        CHECK(image.source == path);
+        drained.push_back(path);
+    }) == 3);
+    CHECK(drained == std::vector<std::string>{ "/Child.png", "/Scene_320x240.png", "/Scene.png" });
+    CHECK_FALSE(queue.isRequested("/Scene.png"));
+    CHECK(queue.isRequested("/Parent.png"));
+
+    auto stats = queue.getStats();
+    CHECK(stats.requested == 4);
+    CHECK(stats.decoded   == 3);
+}
+
+TEST_CASE("ImageDecodeQueue reports failures and drops superseded work", "[ImageDecodeQueue]")
+{
+    std::vector<std::string> released;
+    {
+        ImageDecodeQueue<FakeImage> queue(fakeDecoder(), [&](FakeImage& image) { released.push_back(image.source); }, 0);
+
+        queue.request("/missing.png", true);
+        queue.request("/Old_Neighbour.png", false);
+        queue.request("/New_Neighbour.png", false);
+        REQUIRE(queue.runIdleSlice());
+
+        // Navigation moved on: only the new neighbour is still worth decoding.
+        queue.retainOnly({ "/New_Neighbour.png" });
+        CHECK_FALSE(queue.isRequested("/Old_Neighbour.png"));
+        REQUIRE(queue.runIdleSlice());
+        CHECK_FALSE(queue.runIdleSlice());
+
+        bool failed = false;
+        queue.drain(1, [&](const std::string& path, FakeImage&, bool ok) { failed = path == "/missing.png" && !ok; });
+        CHECK(failed);
+        CHECK(queue.getStats().failed == 1);
+    }
+    // The neighbour was decoded but never taken.
+    CHECK(released == std::vector<std::string>{ "/New_Neighbour.png" });
+}
+
+TEST_CASE("ImageDecodeQueue decodes on its worker threads", "[ImageDecodeQueue]")
+{
+    std::atomic<int>            decoding{ 0 };
+    std::atomic<int>            peak{ 0 };
+    ImageDecodeQueue<FakeImage> queue([&](const std::string& path, FakeImage& image)
+    {
+        int now = ++decoding;
+        for (int seen = peak; now > seen && !peak.compare_exchange_weak(seen, now);) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        image.source = path;
+        --decoding;
+        return true;
+    }, nullptr, 4);
+
+    for (int i = 0; i < 40; ++i)
+        queue.request("/IMG_" + std::to_string(i) + ".png", i % 2 == 0);
+
+    std::map<std::string, int> seen;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (seen.size() < 40 && std::chrono::steady_clock::now() < deadline)
+    {
+        queue.drain(1, [&](const std::string& path, FakeImage& image, bool ok)
+        {
+            CHECK(ok);
+            CHECK(image.source == path);
+            seen[path]++;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(seen.size() == 40);
+    CHECK(peak > 1);
+}
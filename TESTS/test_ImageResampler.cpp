@@ -0,0 +1,99 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "GRAPHICS_RENDERER/ImageResampler.h"
+#include <random>
+#include <vector>
+
+static std::vector<uint8_t> noiseImage(int w, int h, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> rgba((size_t)w * h * 4);
+    for (auto& c : rgba) c = (uint8_t)rng();
+    return rgba;
+}
+
+TEST_CASE("ImageResampler averages whole-pixel blocks", "[ImageResampler]")
+{
+    INFO("backend: " << ImageResampler::backendName());
+
+    SECTION("2x2 blocks, rounded")
+    {
+        // One 2x2 block per channel pattern: 0, 1, 2, 2 averages to 1.25 -> 1; 255s stay 255.
+        const uint8_t src[] = {
+            0, 10, 255, 255,    1, 11, 255, 255,
+            2, 12, 255, 255,    2, 13, 255, 255,
+        };
+        uint8_t dst[4] = {};
+        REQUIRE(ImageResampler::downsample(src, 2, 2, dst, 1, 1));
+        CHECK(dst[0] == 1);
+        CHECK(dst[1] == 12); // 11.5 rounds up
+        CHECK(dst[2] == 255);
+        CHECK(dst[3] == 255);
+    }
+
+    SECTION("non-integer ratios cover every source pixel once")
+    {
+        // 7 -> 3 columns: blocks [0, 2), [2, 4), [4, 7).
+        std::vector<uint8_t> src(7 * 1 * 4, 0);
+        for (int x = 0; x < 7; ++x) src[x * 4] = (uint8_t)(x * 10);
+        uint8_t dst[3 * 4] = {};
+        REQUIRE(ImageResampler::downsample(src.data(), 7, 1, dst, 3, 1));
+        CHECK(dst[0]  == 5);
+        CHECK(dst[4]  == 25);
+        CHECK(dst[8]  == 50);
+    }
+
+    SECTION("a flat image stays flat")
+    {
+        std::vector<uint8_t> src((size_t)97 * 61 * 4);
+        for (size_t i = 0; i < src.size(); ++i) src[i] = (uint8_t)(40 + i % 4 * 50);
+        std::vector<uint8_t> dst((size_t)13 * 9 * 4);
+        REQUIRE(ImageResampler::downsample(src.data(), 97, 61, dst.data(), 13, 9));
+        bool flat = true;
+        for (size_t i = 0; i < dst.size(); ++i) flat = flat && dst[i] == 40 + i % 4 * 50;
+        CHECK(flat);
+    }
+
+    SECTION("invalid sizes leave the destination alone")
+    {
+        uint8_t src[4 * 4] = {}, dst[4 * 4] = { 7 };
+        CHECK_FALSE(ImageResampler::downsample(src, 2, 2, dst, 4, 1));   // upscale
+        CHECK_FALSE(ImageResampler::downsample(src, 2, 2, dst, 0, 1));
+        CHECK_FALSE(ImageResampler::downsample(src, 257, 1, dst, 1, 1)); // past k_MaxFactor
+        CHECK(dst[0] == 7);
+    }
+}
+
+TEST_CASE("ImageResampler matches the scalar reference", "[ImageResampler]")
+{
+    INFO("backend: " << ImageResampler::backendName());
+    // Odd widths exercise the scalar tail of every row.
+    const int sizes[][4] = { { 997, 661, 320, 240 }, { 333, 250, 331, 249 }, { 256, 3, 1, 1 }, { 41, 37, 5, 36 } };
+    for (const auto& s : sizes)
+    {
+        std::vector<uint8_t> src = noiseImage(s[0], s[1], (unsigned)s[0]);
+        std::vector<uint8_t> simd((size_t)s[2] * s[3] * 4), scalar(simd.size());
+        REQUIRE(ImageResampler::downsample(src.data(), s[0], s[1], simd.data(), s[2], s[3]));
+        REQUIRE(ImageResampler::downsampleScalar(src.data(), s[0], s[1], scalar.data(), s[2], s[3]));
+        CHECK(simd == scalar);
+    }
+}
+
+TEST_CASE("ImageResampler benchmark", "[ImageResampler][!benchmark]")
+{
+    // A hi-res scene image shrunk for a 640x480 window.
+    std::vector<uint8_t> src = noiseImage(3936, 2648, 1);
+    std::vector<uint8_t> dst((size_t)640 * 480 * 4);
+
+    BENCHMARK("scalar")
+    {
+        ImageResampler::downsampleScalar(src.data(), 3936, 2648, dst.data(), 640, 480);
+        return dst[0];
+    };
+
+    BENCHMARK(ImageResampler::backendName())
+    {
+        ImageResampler::downsample(src.data(), 3936, 2648, dst.data(), 640, 480);
+        return dst[0];
+    };
+}
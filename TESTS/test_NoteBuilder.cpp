@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "NOTES/NoteBuilder.h"
+#include "NOTES/Notes.h"
+#include "UTIL/CountingFileOperator.h"
+#include <nlohmann/json.hpp>
+
+static const std::string k_NotePath = "/GAME_STATE/NOTES_STATE/TEST/Test_Note.md";
+static const std::string k_BasePath = "/NOTES/TEST/Test_Base.md";
+
+static std::string clueText(uint32_t id)
+{
+    return "- clue " + std::to_string(id) + "\n";
+}
+
+static DiscoveryBits bitsOf(std::initializer_list<uint32_t> ids)
+{
+    DiscoveryBits bits;
+    for (uint32_t id : ids) bits.set(id);
+    return bits;
+}
+
+TEST_CASE("NoteBuilder keeps the note equal to base plus discovered clues", "[NoteBuilder]")
+{
+    CountingFileOperator files;
+    files.memoryWrites = true;
+    files.files[k_BasePath] = "# Test\n";
+
+    int  clueLoads = 0;
+    auto loadClue  = [&](uint32_t id) { clueLoads++; return clueText(id); };
+    const std::vector<uint32_t> order = { 10, 3, 7 };
+
+    NoteBuilder builder(k_NotePath, k_BasePath);
+    builder.refresh(order, bitsOf({ 3, 99 }), loadClue, files); // 99 is not in this note
+    CHECK(files.files[k_NotePath] == "# Test\n" + clueText(3));
+    CHECK(clueLoads == 1);
+    CHECK(files.totalWrites() == 1);
+
+    SECTION("a clue after the last section is appended")
+    {
+        builder.refresh(order, bitsOf({ 3, 7 }), loadClue, files);
+        CHECK(files.files[k_NotePath] == "# Test\n" + clueText(3) + clueText(7));
+        CHECK(clueLoads == 2);
+        CHECK(files.totalWrites() == 1);
+        CHECK(files.totalAppends() == 1);
+    }
+
+    SECTION("a clue before an included one is spliced in")
+    {
+        builder.refresh(order, bitsOf({ 3, 7, 10 }), loadClue, files);
+        CHECK(files.files[k_NotePath] == "# Test\n" + clueText(10) + clueText(3) + clueText(7));
+        CHECK(clueLoads == 3);
+        CHECK(files.totalWrites() == 2);
+        CHECK(files.totalAppends() == 0);
+    }
+
+    SECTION("a clue no longer discovered is removed without loading anything")
+    {
+        builder.refresh(order, bitsOf({ 3, 7, 10 }), loadClue, files);
+        int loads = files.totalLoads();
+        builder.refresh(order, bitsOf({ 7, 10 }), loadClue, files);
+        CHECK(files.files[k_NotePath] == "# Test\n" + clueText(10) + clueText(7));
+        CHECK(clueLoads == 3);
+        CHECK(files.totalLoads() == loads);
+    }
+
+    SECTION("an unchanged refresh touches nothing")
+    {
+        int loads = files.totalLoads();
+        builder.refresh(order, bitsOf({ 3 }), loadClue, files);
+        CHECK(files.totalLoads() == loads);
+        CHECK(files.totalWrites() == 1);
+        CHECK(files.totalAppends() == 0);
+        CHECK(clueLoads == 1);
+    }
+
+    SECTION("an append made elsewhere is overwritten from memory")
+    {
+        files.files[k_NotePath] += clueText(7);
+        builder.refresh(order, bitsOf({ 3, 7 }), loadClue, files, 1);
+        CHECK(files.files[k_NotePath] == "# Test\n" + clueText(3) + clueText(7));
+        CHECK(files.totalWrites() == 2);
+        CHECK(clueLoads == 2);
+    }
+
+    CHECK(builder.getText() == files.files[k_NotePath]);
+}
+
+TEST_CASE("NoteBuilder appends a clue whose queued text was dropped before the flush", "[NoteBuilder]")
+{
+    // The order refreshNote() uses: drop the note's queued appends, flush
+    // the rest, then refresh the builder with the note's append count.
+    static const std::string k_OtherNote = "/GAME_STATE/NOTES_STATE/TEST/Other_Note.md";
+    CountingFileOperator files;
+    files.memoryWrites = true;
+    files.files[k_BasePath]              = "# Test\n";
+    files.files["/NOTES/TEST/CLUE_3.md"] = clueText(3);
+    files.files["/NOTES/TEST/CLUE_7.md"] = clueText(7);
+
+    const std::vector<uint32_t> order = { 3, 7 };
+    auto loadClue = [&](uint32_t id) { return files.load("/NOTES/TEST/CLUE_" + std::to_string(id) + ".md"); };
+
+    Notes       notes;
+    NoteBuilder builder(k_NotePath, k_BasePath);
+    builder.refresh(order, bitsOf({ 3 }), loadClue, files, notes.getAppendCount(k_NotePath));
+
+    notes.queueAppend(k_NotePath, "/NOTES/TEST/CLUE_7.md");
+    notes.queueAppend(k_OtherNote, "/NOTES/TEST/CLUE_7.md");
+    notes.dropAppends(k_NotePath);
+    notes.flush(files);
+    CHECK(notes.getAppendCount(k_NotePath) == 0);
+    CHECK(notes.getAppendCount(k_OtherNote) == 1);
+
+    builder.refresh(order, bitsOf({ 3, 7 }), loadClue, files, notes.getAppendCount(k_NotePath));
+    CHECK(files.files[k_NotePath] == "# Test\n" + clueText(3) + clueText(7));
+    CHECK(files.writeCounts[k_NotePath] == 1);
+    CHECK(files.appendCounts[k_NotePath] == 1);
+    CHECK(builder.getStats().rewrites == 1);
+}
+
+TEST_CASE("NoteBuilder refresh cost does not depend on clue count", "[NoteBuilder]")
+{
+    for (uint32_t clueCount : { 8u, 1024u })
+    {
+        INFO(clueCount << " clues");
+        CountingFileOperator files;
+        files.memoryWrites = true;
+        files.files[k_BasePath] = "# Test\n";
+
+        std::vector<uint32_t> order;
+        DiscoveryBits         discovered;
+        for (uint32_t id = 0; id < clueCount; ++id)
+        {
+            order.push_back(id);
+            if (id != clueCount / 2 && id != clueCount - 1) discovered.set(id);
+        }
+
+        int  clueLoads = 0;
+        auto loadClue  = [&](uint32_t id) { clueLoads++; return clueText(id); };
+        NoteBuilder builder(k_NotePath, k_BasePath);
+        builder.refresh(order, discovered, loadClue, files);
+
+        // One new trailing clue: one clue load, one append.
+        clueLoads = 0;
+        int ops   = files.totalLoads() + files.totalWrites() + files.totalAppends();
+        discovered.set(clueCount - 1);
+        builder.refresh(order, discovered, loadClue, files);
+        CHECK(clueLoads == 1);
+        CHECK(files.totalLoads() + files.totalWrites() + files.totalAppends() == ops + 1);
+
+        // One new clue in the middle: one clue load, one rewrite.
+        clueLoads = 0;
+        ops       = files.totalLoads() + files.totalWrites() + files.totalAppends();
+        discovered.set(clueCount / 2);
+        builder.refresh(order, discovered, loadClue, files);
+        CHECK(clueLoads == 1);
+        CHECK(files.totalLoads() + files.totalWrites() + files.totalAppends() == ops + 1);
+        CHECK(builder.getText() == files.files[k_NotePath]);
+    }
+}
+
+TEST_CASE("NoteBuilder refresh benchmark", "[NoteBuilder][!benchmark]")
+{
+    for (uint32_t clueCount : { 16u, 256u })
+    {
+        CountingFileOperator files;
+        files.memoryWrites = true;
+        files.files[k_BasePath] = "# Test\n";
+
+        std::vector<uint32_t> order;
+        DiscoveryBits         allButLast, all;
+        for (uint32_t id = 0; id < clueCount; ++id)
+        {
+            std::string clue = "/LOCATIONS/TEST/CLUE_" + std::to_string(id) + ".json";
+            std::string text = "/NOTES/TEST/CLUE_" + std::to_string(id) + ".md";
+            files.files[clue] = nlohmann::json{ { "id", id }, { "secondary_path", text } }.dump(2);
+            files.files[text] = clueText(id);
+            order.push_back(id);
+            all.set(id);
+            if (id + 1 < clueCount) allButLast.set(id);
+        }
+        auto cluePath = [](uint32_t id) { return "/LOCATIONS/TEST/CLUE_" + std::to_string(id) + ".json"; };
+
+        // The rebuild refreshNote used to do: base, then every clue's JSON
+        // parsed for its secondary path, then that file.
+        BENCHMARK("full rebuild, " + std::to_string(clueCount) + " clues")
+        {
+            files.writeToFile(k_NotePath, files.load(k_BasePath));
+            for (uint32_t id : order)
+            {
+                nlohmann::json clue = nlohmann::json::parse(files.load(cluePath(id)), nullptr, false);
+                files.appendToFile(k_NotePath, files.load(clue.value("secondary_path", "")));
+            }
+            return files.files[k_NotePath].size();
+        };
+
+        // Secondary paths parsed once, as GameRunner caches them.
+        std::vector<std::string> secondaryPaths;
+        for (uint32_t id : order)
+            secondaryPaths.push_back(nlohmann::json::parse(files.load(cluePath(id)))["secondary_path"]);
+        auto loadClue = [&](uint32_t id) { return files.load(secondaryPaths[id]); };
+
+        NoteBuilder warm(k_NotePath, k_BasePath);
+        warm.refresh(order, allButLast, loadClue, files);
+
+        BENCHMARK_ADVANCED("incremental, one new clue, " + std::to_string(clueCount) + " clues")
+            (Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<NoteBuilder> builders(meter.runs(), warm);
+            meter.measure([&](int i)
+            {
+                builders[i].refresh(order, all, loadClue, files);
+                return builders[i].getStats().appends;
+            });
+        };
+    }
+}
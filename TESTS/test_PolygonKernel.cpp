@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "SCENE/Scene.h"
+#include "ZONE/PolygonKernel.h"
+#include <cmath>
+#include <random>
+
+// Star-shaped polygons with jittered radii scattered over (and slightly past)
+// the 320x240 game space, so zones overlap and some edges are horizontal.
+static Scene makeSyntheticScene(int zoneCount, int minVertices, int maxVertices, unsigned seed)
+{
+    Scene scene("Synthetic");
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> cx(-10, 330), cy(-10, 250), verts(minVertices, maxVertices);
+    std::uniform_real_distribution<float> radius(4.0f, 40.0f);
+
+    for (int z = 0; z < zoneCount; ++z)
+    {
+        int x0 = cx(rng), y0 = cy(rng), n = verts(rng);
+        Zone::Polygon poly;
+        int minX = 1 << 14, minY = 1 << 14, maxX = -(1 << 14), maxY = -(1 << 14);
+        for (int v = 0; v < n; ++v)
+        {
+            float a = 6.2831853f * v / n;
+            float r = radius(rng);
+            int   px = x0 + (int)std::lround(r * std::cos(a));
+            int   py = y0 + (int)std::lround(r * std::sin(a));
+            poly.push_back({ px, py });
+            minX = std::min(minX, px); minY = std::min(minY, py);
+            maxX = std::max(maxX, px); maxY = std::max(maxY, py);
+        }
+        Zone zone(scene, Zone::Bounds(minX, minY, maxX - minX, maxY - minY), "Z" + std::to_string(z));
+        zone.setPolygon(std::move(poly));
+        scene.addZone(zone);
+    }
+    return scene;
+}
+
+static std::vector<Zone::Point> makeTouchLog(size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> x(-5, 325), y(-5, 245);
+    std::vector<Zone::Point> points;
+    for (size_t i = 0; i < count; ++i)
+        points.push_back({ x(rng), y(rng) });
+    return points;
+}
+
+TEST_CASE("PolygonKernel matches the scalar ray-cast", "[PolygonKernel]")
+{
+    INFO("backend: " << PolygonKernel::backendName());
+    Scene scene = makeSyntheticScene(60, 3, 150, 7);
+
+    int mismatches = 0;
+    for (const auto& zone : scene.getZones())
+    {
+        ZoneTable::PolygonView poly = zone.getPolygon();
+        const Zone::Bounds&    b    = zone.getBounds();
+        for (int y = b.mY - 2; y <= b.mY + b.mH + 2; ++y)
+            for (int x = b.mX - 2; x <= b.mX + b.mW + 2; ++x)
+                if (PolygonKernel::contains(poly.xs(), poly.ys(), poly.size(), x, y) !=
+                    PolygonKernel::containsScalar(poly.xs(), poly.ys(), poly.size(), x, y))
+                    mismatches++;
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("PolygonKernel agrees with Zone containsPoint", "[PolygonKernel]")
+{
+    Scene scene("TestScene");
+    Zone zone(scene, Zone::Bounds(10, 10, 80, 60), "Poly");
+    zone.setPolygon({ { 10, 10 }, { 50, 10 }, { 50, 30 }, { 90, 30 }, { 90, 70 },
+                      { 60, 70 }, { 60, 50 }, { 30, 50 }, { 30, 70 }, { 10, 70 } });
+    ZoneTable table;
+    table.add(zone);
+
+    int mismatches = 0;
+    for (int y = 0; y <= 80; ++y)
+        for (int x = 0; x <= 100; ++x)
+            if (table.containsPoint(0, x, y) != zone.containsPoint(x, y))
+                mismatches++;
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("Scene hitTestBatch resolves every point like hitTest", "[PolygonKernel]")
+{
+    Scene scene = makeSyntheticScene(200, 6, 48, 11);
+    std::vector<Zone::Point> log = makeTouchLog(2000, 3);
+    std::vector<int> batch(log.size());
+
+    auto checkAll = [&]
+    {
+        scene.hitTestBatch(log.data(), log.size(), batch.data());
+        int mismatches = 0;
+        for (size_t i = 0; i < log.size(); ++i)
+            if (batch[i] != scene.hitTest(log[i].first, log[i].second).zoneIndex)
+                mismatches++;
+        CHECK(mismatches == 0);
+    };
+
+    SECTION("scanning")   { checkAll(); }
+    SECTION("hit index")  { scene.buildHitIndex(); checkAll(); }
+}
+
+TEST_CASE("Zone hit-test benchmark", "[PolygonKernel][!benchmark]")
+{
+    Scene scene = makeSyntheticScene(400, 8, 64, 5);
+    std::vector<Zone::Point> log = makeTouchLog(1000, 9);
+    std::vector<int> out(log.size());
+
+    // The pre-packing layout: one Zone object per zone.
+    std::vector<Zone> zones;
+    for (const auto& view : scene.getZones())
+    {
+        Zone zone(scene, view.getBounds(), std::string(view.getZoneID()));
+        zone.setPolygon(view.getPolygon().toPolygon());
+        zones.push_back(std::move(zone));
+    }
+
+    BENCHMARK("Zone::containsPoint scan")
+    {
+        int hits = 0;
+        for (const auto& [x, y] : log)
+            for (const Zone& zone : zones)
+                if (zone.containsPoint(x, y)) { hits++; break; }
+        return hits;
+    };
+
+    BENCHMARK("ZoneTable scan, scalar kernel")
+    {
+        const ZoneTable& table = scene.getZones();
+        int hits = 0;
+        for (const auto& [x, y] : log)
+            for (size_t z = 0; z < table.size(); ++z)
+            {
+                const Zone::Bounds& b = table.bounds()[z];
+                if (x < b.mX || x > b.mX + b.mW || y < b.mY || y > b.mY + b.mH) continue;
+                ZoneTable::PolygonView poly = table.polygon(z);
+                if (PolygonKernel::containsScalar(poly.xs(), poly.ys(), poly.size(), x, y)) { hits++; break; }
+            }
+        return hits;
+    };
+
+    BENCHMARK(std::string("hitTestBatch scan, ") + PolygonKernel::backendName() + " kernel")
+    {
+        scene.hitTestBatch(log.data(), log.size(), out.data());
+        return out[0];
+    };
+
+    Scene indexed = scene;
+    indexed.buildHitIndex();
+    BENCHMARK("hitTestBatch with hit index")
+    {
+        indexed.hitTestBatch(log.data(), log.size(), out.data());
+        return out[0];
+    };
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include "SCENE/Scene.h"
+#include <vector>
 
 TEST_CASE("Scene getSceneID", "[Scene]")
 {
@@ -89,3 +90,73 @@ TEST_CASE("Scene addZone / getZones", "[Scene]")
         REQUIRE(scene.getZones()[1].getZoneID() == "ZoneB");
     }
 }
+
+TEST_CASE("Scene hitTest resolves the first intercepting zone once", "[Scene]")
+{
+    Scene scene("MyScene");
+    scene.addZone(Zone(scene, Zone::Bounds(0, 0, 100, 100),   "Door",  "/door.json"));
+    scene.addZone(Zone(scene, Zone::Bounds(50, 50, 100, 100), "Clue",  "",  "/NOTES/clue.md"));
+    scene.addZone(Zone(scene, Zone::Bounds(200, 0, 50, 50),   "toggleOverlay"));
+
+    SECTION("miss returns an empty result")
+    {
+        Scene::HitResult hit = scene.hitTest(300, 200);
+        REQUIRE_FALSE(hit);
+        REQUIRE(hit.zoneIndex == -1);
+        REQUIRE(hit.zoneID.empty());
+        REQUIRE(hit.target.empty());
+        REQUIRE(hit.noteTarget.empty());
+    }
+
+    SECTION("overlap resolves to the first zone with all of its fields")
+    {
+        Scene::HitResult hit = scene.hitTest(75, 75);
+        REQUIRE(hit);
+        REQUIRE(hit.zoneIndex == 0);
+        REQUIRE(hit.zoneID == "Door");
+        REQUIRE(hit.target == "/door.json");
+        REQUIRE(hit.noteTarget.empty());
+    }
+
+    SECTION("views reference the scene's own strings")
+    {
+        Scene::HitResult hit = scene.hitTest(120, 120);
+        REQUIRE(hit.zoneIndex == 1);
+        REQUIRE(hit.noteTarget == "/NOTES/clue.md");
+        REQUIRE(hit.noteTarget.data() == scene.hitTest(120, 120).noteTarget.data());
+    }
+
+    SECTION("agrees with a brute-force Zone::containsPoint scan")
+    {
+        Zone triangle(scene, Zone::Bounds(150, 100, 100, 100), "Triangle", "/triangle.json");
+        triangle.setPolygon({ { 150, 200 }, { 200, 100 }, { 250, 200 } });
+        scene.addZone(triangle);
+        scene.buildHitIndex();
+
+        // The reference: one Zone per packed zone, first hit in scene order.
+        std::vector<Zone> zones;
+        for (const auto& view : scene.getZones())
+        {
+            Zone zone(scene, view.getBounds(), std::string(view.getZoneID()),
+                      std::string(view.getTarget()), std::string(view.getNoteTarget()));
+            zone.setPolygon(view.getPolygon().toPolygon());
+            zones.push_back(std::move(zone));
+        }
+        REQUIRE(zones.size() == 4);
+
+        for (int y = -5; y <= 245; y += 5)
+            for (int x = -5; x <= 325; x += 5)
+            {
+                int expected = -1;
+                for (size_t i = 0; i < zones.size() && expected < 0; ++i)
+                    if (zones[i].containsPoint(x, y)) expected = (int)i;
+
+                Scene::HitResult hit = scene.hitTest(x, y);
+                REQUIRE(hit.zoneIndex == expected);
+                if (expected < 0) continue;
+                REQUIRE(hit.zoneID     == zones[expected].getZoneID());
+                REQUIRE(hit.target     == zones[expected].getTarget());
+                REQUIRE(hit.noteTarget == zones[expected].getNoteTarget());
+            }
+    }
+}
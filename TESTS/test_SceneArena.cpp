@@ -0,0 +1,195 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GAME_RUNNER/GameRunner.h"
+#include "SCENE/SceneArena.h"
+#include "SCENE/SceneCompiler.h"
+#include "SCENE/SceneFactory.h"
+#include "UTIL/AllocationCounter.h"
+#include "UTIL/TestFileOperator.h"
+#include "UTIL/NullGraphicsRenderer.h"
+
+static const std::string k_AveryRootPath = "/LOCATIONS/AVERY/ROOT/Avery_Full.json";
+static const std::string k_AveryDeskPath = "/LOCATIONS/AVERY/DESK/MAIN/Avery_Desk.json";
+
+// Serves loadInto from the in-memory map by copying into the caller's buffer,
+// so a read into a warm buffer allocates nothing. Real storage may allocate
+// inside the platform's file API, which GameRunner cannot avoid.
+class InMemoryFileOperator : public TestFileOperator
+{
+public:
+    void loadInto(const std::string& path, std::string& out) override
+    {
+        auto it = files.find(path);
+        if (it != files.end()) out.assign(it->second);
+        else                   out = load(path);
+    }
+};
+
+static void checkSameScene(const Scene& a, const Scene& b)
+{
+    CHECK(a.getSceneID()     == b.getSceneID());
+    CHECK(a.getName()        == b.getName());
+    CHECK(a.getPrimaryPath() == b.getPrimaryPath());
+    CHECK(a.getParentPath()  == b.getParentPath());
+    CHECK(a.getNoteTarget()  == b.getNoteTarget());
+    REQUIRE(a.getZones().size() == b.getZones().size());
+    for (size_t i = 0; i < a.getZones().size(); ++i)
+    {
+        CHECK(a.getZones()[i].getZoneID()  == b.getZones()[i].getZoneID());
+        CHECK(a.getZones()[i].getTarget()  == b.getZones()[i].getTarget());
+        CHECK(a.getZones()[i].getPolygon() == b.getZones()[i].getPolygon());
+    }
+    CHECK(a.hasHitIndex() == b.hasHitIndex());
+}
+
+TEST_CASE("SceneArena hands out aligned memory and rewinds on reset", "[SceneArena]")
+{
+    SceneArena arena(256);
+    CHECK(arena.getStats().capacity >= 256);
+    CHECK(arena.getStats().blockAllocations == 1);
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    CHECK(reinterpret_cast<uintptr_t>(b) % 8 == 0);
+    CHECK(arena.getStats().liveAllocations == 2);
+    CHECK(arena.getStats().bytesUsed >= 11);
+
+    SECTION("reset refuses while allocations are live")
+    {
+        arena.deallocate(a, 3);
+        CHECK_FALSE(arena.reset());
+        CHECK(arena.getStats().bytesUsed >= 11);
+
+        arena.deallocate(b, 8);
+        CHECK(arena.reset());
+        CHECK(arena.getStats().bytesUsed == 0);
+        CHECK(arena.allocate(3, 1) == a);
+        arena.deallocate(a, 3);
+    }
+
+    SECTION("overflow blocks are folded into one on reset")
+    {
+        void* big = arena.allocate(4096, 8);
+        CHECK(arena.getStats().blockAllocations == 2);
+        size_t highWater = arena.getStats().highWater;
+
+        arena.deallocate(a, 3);
+        arena.deallocate(b, 8);
+        arena.deallocate(big, 4096);
+        REQUIRE(arena.reset());
+        CHECK(arena.getStats().blockAllocations == 3);
+        CHECK(arena.getStats().capacity >= highWater);
+
+        // The same workload now fits in the single folded block.
+        arena.deallocate(arena.allocate(3, 1), 3);
+        arena.deallocate(arena.allocate(8, 8), 8);
+        arena.deallocate(arena.allocate(4096, 8), 4096);
+        CHECK(arena.getStats().blockAllocations == 3);
+        CHECK(arena.getStats().highWater == highWater);
+    }
+}
+
+TEST_CASE("SceneFactory builds the same scene into an arena", "[SceneArena]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    std::string json = fileOp.load(k_AveryRootPath);
+    SceneArena  arena;
+
+    SECTION("from JSON")
+    {
+        auto heapScene  = SceneFactory().build(json);
+        auto arenaScene = SceneFactory().build(json, arena);
+        checkSameScene(*heapScene, *arenaScene);
+    }
+
+    SECTION("from a compiled record")
+    {
+        std::string record = SceneCompiler::compile(json);
+        auto heapScene  = SceneFactory().buildFromRecord(record);
+        auto arenaScene = SceneFactory().buildFromRecord(record, arena);
+        REQUIRE(arenaScene);
+        checkSameScene(*heapScene, *arenaScene);
+        CHECK_FALSE(SceneFactory().buildFromRecord("KSCB garbage", arena));
+    }
+
+    CHECK(arena.getStats().highWater > 0);
+    CHECK(arena.getStats().liveAllocations == 0);
+}
+
+TEST_CASE("Rebuilding a scene from a record into a warm arena allocates nothing", "[SceneArena]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    std::string record = SceneCompiler::compile(fileOp.load(k_AveryRootPath));
+    SceneFactory factory;
+    SceneArena   arena;
+
+    // Two passes: one to grow the arena, one to fold it into a single block.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        REQUIRE(factory.buildFromRecord(record, arena));
+        REQUIRE(arena.reset());
+    }
+
+    size_t blocks = arena.getStats().blockAllocations;
+
+    AllocationCounter allocations;
+    auto scene = factory.buildFromRecord(record, arena);
+    CHECK(allocations.count() == 0);
+    REQUIRE(scene);
+    CHECK(scene->getZones().size() > 0);
+    CHECK(arena.getStats().blockAllocations == blocks);
+}
+
+TEST_CASE("GameRunner navigation stops growing the scene arena once warm", "[SceneArena]")
+{
+    InMemoryFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    for (const std::string& path : { k_AveryRootPath, k_AveryDeskPath })
+        fileOp.files[SceneCompiler::recordPath(path)] = SceneCompiler::compile(fileOp.load(path));
+    NullGraphicsRenderer renderer;
+    GameRunner runner(fileOp, renderer);
+    runner.enableSceneArena(0);
+    runner.setSceneCacheBudget(0); // the cache declines every scene
+
+    // First visits build on the heap; the arena takes over from the second.
+    for (int i = 0; i < 2; ++i)
+    {
+        runner.loadScene(k_AveryRootPath);
+        runner.loadScene(k_AveryDeskPath);
+    }
+    runner.loadScene(k_AveryRootPath);
+    size_t blocks = runner.getSceneArenaStats().blockAllocations;
+
+    AllocationCounter allocations;
+    for (int i = 0; i < 5; ++i)
+    {
+        runner.loadScene(k_AveryDeskPath);
+        runner.loadScene(k_AveryRootPath);
+    }
+    CHECK(allocations.count() == 0);
+
+    auto stats = runner.getSceneArenaStats();
+    CHECK(stats.blockAllocations == blocks);
+    CHECK(stats.highWater > 0);
+    CHECK(stats.liveAllocations > 0); // the active scene
+    CHECK(runner.getSceneCacheStats().entries == 0);
+}
+
+TEST_CASE("GameRunner still caches scenes that fit with the scene arena enabled", "[SceneArena]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    NullGraphicsRenderer renderer;
+    GameRunner runner(fileOp, renderer);
+    runner.enableSceneArena(0);
+
+    runner.loadScene(k_AveryRootPath);
+    runner.loadScene(k_AveryDeskPath);
+    runner.loadScene(k_AveryRootPath);
+
+    auto cache = runner.getSceneCacheStats();
+    CHECK(cache.entries == 2);
+    CHECK(cache.hits == 1);
+    CHECK(runner.getSceneArenaStats().highWater == 0);
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GAME_RUNNER/GameRunner.h"
+#include "SCENE/Scene.h"
+#include "SCENE_CACHE/SceneCache.h"
+#include "UTIL/CountingFileOperator.h"
+#include "UTIL/NullGraphicsRenderer.h"
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+static const std::string k_AveryRootPath = "/LOCATIONS/AVERY/ROOT/Avery_Full.json";
+static const std::string k_AveryDeskPath = "/LOCATIONS/AVERY/DESK/MAIN/Avery_Desk.json";
+static const std::string k_DspCluePath   = "/LOCATIONS/AVERY/DESK/BOOKS/DSP_CLUE/DSP_Clue.json";
+static const std::string k_OutputDir     = "TESTS/OUTPUT/SCENE_CACHE/KSC_DATA";
+
+static std::shared_ptr<Scene> makeScene(const std::string& id)
+{
+    return std::make_shared<Scene>(id, "Main", "Name", "/primary.png", "/secondary.md");
+}
+
+TEST_CASE("SceneCache find returns inserted scenes and counts hits and misses", "[SceneCache]")
+{
+    SceneCache cache(1024 * 1024);
+    auto scene = makeScene("A");
+
+    CHECK(cache.find("/A.json") == nullptr);
+    cache.insert("/A.json", scene);
+    CHECK(cache.find("/A.json") == scene);
+
+    auto stats = cache.getStats();
+    CHECK(stats.hits      == 1);
+    CHECK(stats.misses    == 1);
+    CHECK(stats.entries   == 1);
+    CHECK(stats.bytesUsed == scene->estimateBytes());
+}
+
+TEST_CASE("SceneCache evicts least recently used scenes to stay within budget", "[SceneCache]")
+{
+    size_t perScene = makeScene("A")->estimateBytes();
+    SceneCache cache(perScene * 2);
+
+    cache.insert("/A.json", makeScene("A"));
+    cache.insert("/B.json", makeScene("B"));
+    cache.find("/A.json");                   // B is now least recently used
+    cache.insert("/C.json", makeScene("C"));
+
+    CHECK(cache.find("/A.json") != nullptr);
+    CHECK(cache.find("/B.json") == nullptr);
+    CHECK(cache.find("/C.json") != nullptr);
+    CHECK(cache.getStats().evictions == 1);
+    CHECK(cache.getStats().bytesUsed <= perScene * 2);
+
+    SECTION("shrinking the budget evicts immediately")
+    {
+        cache.setBudget(perScene);
+        CHECK(cache.getStats().entries == 1);
+        CHECK(cache.find("/C.json") != nullptr);
+    }
+
+    SECTION("a zero budget caches nothing")
+    {
+        cache.setBudget(0);
+        cache.insert("/D.json", makeScene("D"));
+        CHECK(cache.getStats().entries == 0);
+        CHECK(cache.find("/D.json") == nullptr);
+    }
+}
+
+TEST_CASE("SceneCache invalidate drops an entry", "[SceneCache]")
+{
+    SceneCache cache(1024 * 1024);
+    cache.insert("/A.json", makeScene("A"));
+    cache.invalidate("/A.json");
+    CHECK(cache.find("/A.json") == nullptr);
+    CHECK(cache.getStats().bytesUsed == 0);
+}
+
+TEST_CASE("GameRunner serves revisited scenes from the scene cache", "[SceneCache]")
+{
+    CountingFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    NullGraphicsRenderer renderer;
+    GameRunner runner(fileOp, renderer);
+
+    runner.loadScene(k_AveryRootPath);
+    runner.loadScene(k_AveryDeskPath);
+    runner.loadScene(k_AveryRootPath);
+    runner.loadScene(k_AveryDeskPath);
+
+    CHECK(fileOp.loadCounts[k_AveryRootPath] == 1);
+    CHECK(fileOp.loadCounts[k_AveryDeskPath] == 1);
+
+    auto stats = runner.getSceneCacheStats();
+    CHECK(stats.hits   == 2);
+    CHECK(stats.misses == 2);
+
+    SECTION("a zero budget reloads every visit")
+    {
+        runner.setSceneCacheBudget(0);
+        runner.loadScene(k_AveryRootPath);
+        runner.loadScene(k_AveryRootPath);
+        CHECK(fileOp.loadCounts[k_AveryRootPath] == 3);
+    }
+}
+
+TEST_CASE("GameRunner keeps a discovered scene cached without rediscovering it", "[SceneCache]")
+{
+    fs::remove_all(k_OutputDir);
+
+    CountingFileOperator fileOp;
+    fileOp.diskRoot  = "KSC_DATA";
+    fileOp.writeRoot = k_OutputDir;
+    NullGraphicsRenderer renderer;
+    GameRunner runner(fileOp, renderer);
+
+    runner.loadScene(k_DspCluePath);
+    int loadsAfterDiscovery = fileOp.loadCounts[k_DspCluePath];
+
+    runner.loadScene(k_AveryRootPath);
+    runner.loadScene(k_DspCluePath);
+
+    // The cached scene was marked discovered in place, so the revisit skips storage.
+    CHECK(fileOp.loadCounts[k_DspCluePath] == loadsAfterDiscovery);
+    CHECK(runner.getGameState().isDiscovered(k_DspCluePath));
+
+    SECTION("a rebuild from stale storage is not rediscovered")
+    {
+        runner.setSceneCacheBudget(0);
+        runner.loadScene(k_AveryRootPath);
+        runner.loadScene(k_DspCluePath);
+        CHECK(fileOp.loadCounts[k_DspCluePath] > loadsAfterDiscovery);
+
+        runner.flushGameState();
+        std::string note = fileOp.load(k_OutputDir + "/GAME_STATE/NOTES_STATE/AVERY/Avery_Note.md");
+        std::string clue = fileOp.load("/NOTES/AVERY/AUDIOPHILE/DSP_Clue.md");
+        REQUIRE_FALSE(clue.empty());
+        CHECK(note.find(clue) != std::string::npos);
+        CHECK(note.find(clue) == note.rfind(clue));
+    }
+}
@@ -0,0 +1,251 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GAME_RUNNER/GameRunner.h"
+#include "SCENE/SceneCompiler.h"
+#include "SCENE/SceneFactory.h"
+#include "UTIL/CountingFileOperator.h"
+#include "UTIL/TestFileOperator.h"
+#include "UTIL/NullGraphicsRenderer.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+static const std::string k_AveryRootPath = "/LOCATIONS/AVERY/ROOT/Avery_Full.json";
+static const std::string k_DspCluePath   = "/LOCATIONS/AVERY/DESK/BOOKS/DSP_CLUE/DSP_Clue.json";
+static const std::string k_OutputDir     = "TESTS/OUTPUT/SCENE_COMPILER/KSC_DATA";
+
+// Every scene JSON (document with a "zones" array) under KSC_DATA, as a
+// data-root-relative path.
+static std::vector<std::string> allScenePaths()
+{
+    std::vector<std::string> paths;
+    for (const auto& entry : fs::recursive_directory_iterator("KSC_DATA"))
+    {
+        if (entry.path().extension() != ".json") continue;
+        std::ifstream f(entry.path());
+        nlohmann::json j = nlohmann::json::parse(f, nullptr, false);
+        if (j.is_discarded() || !j.contains("zones")) continue;
+        paths.push_back("/" + fs::relative(entry.path(), "KSC_DATA").generic_string());
+    }
+    return paths;
+}
+
+static void requireSameScene(const Scene& a, const Scene& b)
+{
+    CHECK(a.getSceneID()       == b.getSceneID());
+    CHECK(a.getParentSceneID() == b.getParentSceneID());
+    CHECK(a.getName()          == b.getName());
+    CHECK(a.getPrimaryPath()   == b.getPrimaryPath());
+    CHECK(a.getSecondaryPath() == b.getSecondaryPath());
+    CHECK(a.getParentPath()    == b.getParentPath());
+    CHECK(a.getNoteTarget()    == b.getNoteTarget());
+    CHECK(a.getLoresPath()     == b.getLoresPath());
+    CHECK(a.isRoot()           == b.isRoot());
+    CHECK(a.isDiscovered()     == b.isDiscovered());
+
+    auto za = a.getZones();
+    auto zb = b.getZones();
+    REQUIRE(za.size() == zb.size());
+    for (size_t i = 0; i < za.size(); ++i)
+    {
+        CHECK(za[i].getZoneID()     == zb[i].getZoneID());
+        CHECK(za[i].getTarget()     == zb[i].getTarget());
+        CHECK(za[i].getNoteTarget() == zb[i].getNoteTarget());
+        CHECK(za[i].getLabel()      == zb[i].getLabel());
+        CHECK(za[i].getPolygon()    == zb[i].getPolygon());
+        CHECK(za[i].getBounds().mX  == zb[i].getBounds().mX);
+        CHECK(za[i].getBounds().mY  == zb[i].getBounds().mY);
+        CHECK(za[i].getBounds().mW  == zb[i].getBounds().mW);
+        CHECK(za[i].getBounds().mH  == zb[i].getBounds().mH);
+    }
+}
+
+TEST_CASE("SceneCompiler recordPath swaps the .json extension", "[SceneCompiler]")
+{
+    CHECK(SceneCompiler::recordPath(k_AveryRootPath) == "/LOCATIONS/AVERY/ROOT/Avery_Full.kscb");
+    CHECK(SceneCompiler::recordPath("/NOTES/AVERY/Avery_Note_Base.md").empty());
+}
+
+TEST_CASE("SceneCompiler records build the same Scene as their JSON", "[SceneCompiler]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+
+    std::vector<std::string> paths = allScenePaths();
+    REQUIRE_FALSE(paths.empty());
+
+    for (const std::string& path : paths)
+    {
+        INFO("Scene: " << path);
+        std::string json   = fileOp.load(path);
+        std::string record = SceneCompiler::compile(json);
+        REQUIRE_FALSE(record.empty());
+        CHECK(record.size() < json.size());
+
+        for (bool hires : { false, true })
+        {
+            SceneFactory factory(hires);
+            auto fromJson   = factory.build(json);
+            auto fromRecord = factory.buildFromRecord(record);
+            REQUIRE(fromRecord != nullptr);
+            requireSameScene(*fromJson, *fromRecord);
+        }
+    }
+}
+
+TEST_CASE("SceneFactory rejects invalid records", "[SceneCompiler]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    std::string record = SceneCompiler::compile(fileOp.load(k_AveryRootPath));
+    REQUIRE_FALSE(record.empty());
+
+    SceneFactory factory;
+
+    SECTION("a record only matches the JSON it was compiled from")
+    {
+        std::string json = fileOp.load(k_AveryRootPath);
+        CHECK(SceneCompiler::isCompiledFrom(record, json));
+        CHECK_FALSE(SceneCompiler::isCompiledFrom(record, json + " "));
+        std::string edited = json;
+        edited[edited.find("Avery")] = 'a'; // same length
+        CHECK_FALSE(SceneCompiler::isCompiledFrom(record, edited));
+        CHECK_FALSE(SceneCompiler::isCompiledFrom(record.substr(0, 16), json));
+    }
+
+    SECTION("malformed JSON does not compile")
+    {
+        CHECK(SceneCompiler::compile("{ not json").empty());
+    }
+
+    SECTION("wrong magic")
+    {
+        std::string bad = record;
+        bad[0] = 'X';
+        CHECK(factory.buildFromRecord(bad) == nullptr);
+    }
+
+    SECTION("wrong version")
+    {
+        std::string bad = record;
+        bad[4] = static_cast<char>(SceneCompiler::k_Version + 1);
+        CHECK(factory.buildFromRecord(bad) == nullptr);
+    }
+
+    SECTION("every truncation is rejected")
+    {
+        for (size_t len = 0; len < record.size(); ++len)
+            CHECK(factory.buildFromRecord(record.substr(0, len)) == nullptr);
+    }
+}
+
+TEST_CASE("GameRunner prefers a compiled record over the scene JSON", "[SceneCompiler]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    NullGraphicsRenderer renderer;
+
+    // Compile a record whose first zone points somewhere the JSON does not,
+    // so the navigation target reveals which source was used.
+    nlohmann::json doc = nlohmann::json::parse(fileOp.load(k_AveryRootPath));
+    doc["zones"][0]["target"] = "/FROM_RECORD.json";
+    fileOp.files[SceneCompiler::recordPath(k_AveryRootPath)] = SceneCompiler::compile(doc.dump());
+
+    auto scene = SceneFactory().build(fileOp.load(k_AveryRootPath));
+    auto poly  = scene->getZones()[0].getPolygon();
+    int  hitX  = 0, hitY = 0;
+    for (auto [x, y] : poly) { hitX += x; hitY += y; }
+    hitX /= (int)poly.size();
+    hitY /= (int)poly.size();
+
+    struct TrackingFileOperator : TestFileOperator
+    {
+        std::string lastLoadPath;
+        std::string load(const std::string& path) override
+        {
+            lastLoadPath = path;
+            return TestFileOperator::load(path);
+        }
+    } tracking;
+    tracking.diskRoot = fileOp.diskRoot;
+    tracking.files    = fileOp.files;
+
+    GameRunner runner(tracking, renderer);
+
+    SECTION("record is used when present")
+    {
+        runner.loadScene(k_AveryRootPath);
+        runner.registerHit(hitX, hitY);
+        CHECK(tracking.lastLoadPath == "/FROM_RECORD.json");
+    }
+
+    SECTION("corrupt record falls back to the JSON")
+    {
+        tracking.files[SceneCompiler::recordPath(k_AveryRootPath)] = "KSCB garbage";
+        runner.loadScene(k_AveryRootPath);
+        runner.registerHit(hitX, hitY);
+        CHECK(tracking.lastLoadPath == "/LOCATIONS/AVERY/DESK/MAIN/Avery_Desk.json");
+    }
+
+    SECTION("a present record is trusted until the compiler replaces it")
+    {
+        doc["zones"][0]["target"] = "/FROM_EDITED_JSON.json";
+        tracking.files[k_AveryRootPath] = doc.dump();
+        runner.loadScene(k_AveryRootPath);
+        runner.registerHit(hitX, hitY);
+        CHECK(tracking.lastLoadPath == "/FROM_RECORD.json");
+    }
+}
+
+TEST_CASE("GameRunner reads only the record of a compiled scene", "[SceneCompiler]")
+{
+    CountingFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    NullGraphicsRenderer renderer;
+    const std::string recordPath = SceneCompiler::recordPath(k_AveryRootPath);
+    fileOp.files[recordPath] = SceneCompiler::compile(fileOp.load(k_AveryRootPath));
+
+    GameRunner runner(fileOp, renderer);
+    runner.setSceneCacheBudget(0); // every visit rebuilds
+    fileOp.loadCounts.clear();
+
+    for (int visit = 0; visit < 3; ++visit)
+        runner.loadScene(k_AveryRootPath);
+    CHECK(fileOp.loadCounts[recordPath] == 3);
+    CHECK(fileOp.loadCounts[k_AveryRootPath] == 0);
+
+    // Without a record the JSON is read instead.
+    runner.loadScene(k_DspCluePath);
+    CHECK(fileOp.loadCounts[k_DspCluePath] == 1);
+}
+
+TEST_CASE("Clue discovery leaves the compiled record alone and survives a restart", "[SceneCompiler]")
+{
+    fs::remove_all(k_OutputDir);
+
+    TestFileOperator fileOp;
+    fileOp.diskRoot  = "KSC_DATA";
+    fileOp.writeRoot = k_OutputDir;
+    NullGraphicsRenderer renderer;
+
+    std::string recordPath = SceneCompiler::recordPath(k_DspCluePath);
+    std::string record     = SceneCompiler::compile(fileOp.load(k_DspCluePath));
+    fileOp.files[recordPath] = record;
+
+    {
+        GameRunner runner(fileOp, renderer);
+        runner.loadScene(k_DspCluePath);
+        runner.flushGameState(); // discovery is written behind
+    }
+    CHECK_FALSE(fs::exists(k_OutputDir + recordPath));
+    CHECK_FALSE(fs::exists(k_OutputDir + k_DspCluePath));
+
+    // The journal written by the first run is replayed by the next one.
+    fileOp.files[GameState::k_JournalPath] = fileOp.load(k_OutputDir + GameState::k_JournalPath);
+    REQUIRE_FALSE(fileOp.files[GameState::k_JournalPath].empty());
+    GameRunner runner(fileOp, renderer);
+    CHECK(runner.getGameState().isDiscovered(k_DspCluePath));
+    runner.loadScene(k_DspCluePath);
+    CHECK_FALSE(runner.getGameState().isDirty()); // not rediscovered
+    CHECK(fileOp.files[recordPath] == record);
+}
@@ -0,0 +1,207 @@
+#include <catch2/catch_test_macros.hpp>
+#include "SCENE/SceneFactory.h"
+#include "UTIL/AllocationCounter.h"
+#include "UTIL/TestFileOperator.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+// The DOM-based build the streaming factory replaced, kept as the reference.
+static std::unique_ptr<Scene> buildFromDom(const std::string& jsonString, bool useHires)
+{
+    json j = json::parse(jsonString, nullptr, false);
+    if (j.is_discarded()) return std::make_unique<Scene>();
+
+    std::string primaryPath = useHires ? j.value("hires_image_path", "") : j.value("lores_image_path", "");
+    if (primaryPath.empty()) primaryPath = j.value("lores_image_path", "");
+    auto scene = std::make_unique<Scene>(j.value("id", ""), j.value("parent", "Main"), j.value("name", ""),
+                                         primaryPath, j.value("secondary_path", ""));
+    scene->setIsRoot(j.value("isRoot", false));
+    scene->setIsDiscovered(j.value("isDiscovered", false));
+    scene->setParentPath(j.value("parent_path", ""));
+    scene->setNoteTarget(j.value("notePath", ""));
+    if (primaryPath != j.value("lores_image_path", ""))
+        scene->setLoresPath(j.value("lores_image_path", ""));
+
+    float hiresScaleX = 1.0f, hiresScaleY = 1.0f;
+    if (useHires && j.contains("hires_canvas") && j["hires_canvas"].is_object())
+    {
+        hiresScaleX = 320.0f / j["hires_canvas"].value("width",  320.0f);
+        hiresScaleY = 240.0f / j["hires_canvas"].value("height", 240.0f);
+    }
+
+    for (auto& z : j.value("zones", json::array()))
+    {
+        if (!z.is_object()) continue; // the DOM build threw here
+        const char* key  = (useHires && z.contains("hires_points")) ? "hires_points" : "points";
+        float       sx   = key[0] == 'h' ? hiresScaleX : 1.0f;
+        float       sy   = key[0] == 'h' ? hiresScaleY : 1.0f;
+        Zone::Bounds bounds(z.value("x", 0), z.value("y", 0), z.value("width", 0), z.value("height", 0));
+        Zone::Polygon poly;
+        if (z.contains(key) && z[key].is_array() && !z[key].empty())
+        {
+            int minX = 320, minY = 240, maxX = 0, maxY = 0;
+            for (auto& pt : z[key])
+            {
+                int px = (int)(pt[0].get<float>() * sx);
+                int py = (int)(pt[1].get<float>() * sy);
+                poly.push_back({ px, py });
+                minX = std::min(minX, px); minY = std::min(minY, py);
+                maxX = std::max(maxX, px); maxY = std::max(maxY, py);
+            }
+            bounds = Zone::Bounds(minX, minY, maxX - minX, maxY - minY);
+        }
+        Zone zone(*scene, bounds, z.value("id", ""), z.value("target", ""),
+                  z.value("noteTarget", ""), z.value("label", ""));
+        zone.setPolygon(std::move(poly));
+        scene->addZone(zone);
+    }
+    return scene;
+}
+
+static void checkSameAsDom(const std::string& jsonString, bool useHires)
+{
+    auto expected = buildFromDom(jsonString, useHires);
+    auto actual   = SceneFactory(useHires).build(jsonString);
+
+    CHECK(actual->getSceneID()        == expected->getSceneID());
+    CHECK(actual->getParentSceneID()  == expected->getParentSceneID());
+    CHECK(actual->getName()           == expected->getName());
+    CHECK(actual->getPrimaryPath()    == expected->getPrimaryPath());
+    CHECK(actual->getSecondaryPath()  == expected->getSecondaryPath());
+    CHECK(actual->getParentPath()     == expected->getParentPath());
+    CHECK(actual->getNoteTarget()     == expected->getNoteTarget());
+    CHECK(actual->getLoresPath()      == expected->getLoresPath());
+    CHECK(actual->isRoot()            == expected->isRoot());
+    CHECK(actual->isDiscovered()      == expected->isDiscovered());
+
+    const ZoneTable& a = actual->getZones();
+    const ZoneTable& b = expected->getZones();
+    REQUIRE(a.size() == b.size());
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        CHECK(a[i].getZoneID()     == b[i].getZoneID());
+        CHECK(a[i].getTarget()     == b[i].getTarget());
+        CHECK(a[i].getNoteTarget() == b[i].getNoteTarget());
+        CHECK(a[i].getLabel()      == b[i].getLabel());
+        CHECK(a[i].getBounds().mX  == b[i].getBounds().mX);
+        CHECK(a[i].getBounds().mY  == b[i].getBounds().mY);
+        CHECK(a[i].getBounds().mW  == b[i].getBounds().mW);
+        CHECK(a[i].getBounds().mH  == b[i].getBounds().mH);
+        CHECK(a[i].getPolygon()    == b[i].getPolygon());
+    }
+}
+
+TEST_CASE("SceneFactory streaming build matches the DOM build for every scene", "[SceneFactory]")
+{
+    TestFileOperator fileOp;
+    int scenes = 0;
+    for (const auto& entry : fs::recursive_directory_iterator("KSC_DATA"))
+    {
+        if (entry.path().extension() != ".json") continue;
+        std::string content = fileOp.load(entry.path().string());
+        if (!json::accept(content) || !json::parse(content).is_object()) continue;
+
+        INFO(entry.path().string());
+        checkSameAsDom(content, false);
+        checkSameAsDom(content, true);
+        scenes++;
+    }
+    CHECK(scenes > 10);
+}
+
+TEST_CASE("SceneFactory streaming build does not depend on key order", "[SceneFactory]")
+{
+    // Zones before the header, hires_points before points, canvas last.
+    std::string doc = R"({
+        "zones": [
+            { "hires_points": [[400, 400], [800, 400], [800, 800]], "action": { "nested": [1, [2]] },
+              "points": [[10, 10], [20, 10], [20, 20]], "id": "tri", "target": "/T.json" },
+            { "id": "rect", "x": 5, "y": 6, "width": 7.9, "height": 8, "points": [] },
+            { "id": "hiresRect", "hires_points": "none", "points": [[1, 1], [2, 2], [3, 1]] },
+            42, "stray"
+        ],
+        "id": "ORDER", "parent": "P", "name": "Order", "isRoot": true,
+        "lores_image_path": "/lo.png", "hires_image_path": "/hi.png",
+        "notePath": "/NOTES/n.md", "extra": { "zones": [ { "id": "not a zone" } ] },
+        "hires_canvas": { "width": 1600, "height": 1200 }
+    })";
+
+    checkSameAsDom(doc, false);
+    checkSameAsDom(doc, true);
+
+    auto hires = SceneFactory(true).build(doc);
+    REQUIRE(hires->getZones().size() == 3);
+    CHECK(hires->getZones()[0].getPolygon().x(1) == 160);
+    CHECK(hires->getPrimaryPath() == "/hi.png");
+    CHECK(hires->getLoresPath()   == "/lo.png");
+    CHECK_FALSE(hires->getZones()[2].hasPolygon());
+}
+
+TEST_CASE("SceneFactory streaming build ignores scalars nested under a known field", "[SceneFactory]")
+{
+    std::string doc = R"({
+        "id": ["x"], "name": { "a": "n" }, "isRoot": { "a": true }, "isDiscovered": [true, null],
+        "lores_image_path": "/lo.png",
+        "zones": [ { "id": { "b": "z" }, "target": ["/T.json"], "noteTarget": "/N.json",
+                     "x": [1], "y": 2, "width": { "w": 3 }, "height": 4 } ]
+    })";
+
+    auto scene = SceneFactory().build(doc);
+    CHECK(scene->getSceneID().empty());
+    CHECK(scene->getName().empty());
+    CHECK_FALSE(scene->isRoot());
+    CHECK_FALSE(scene->isDiscovered());
+    CHECK(scene->getPrimaryPath() == "/lo.png");
+    REQUIRE(scene->getZones().size() == 1);
+    auto zone = scene->getZones()[0];
+    CHECK(zone.getZoneID().empty());
+    CHECK(zone.getBounds().mX == 0);
+    CHECK(zone.getBounds().mY == 2);
+    CHECK(zone.getBounds().mW == 0);
+    CHECK(zone.getTarget().empty());
+    CHECK(zone.getNoteTarget() == "/N.json");
+}
+
+TEST_CASE("SceneFactory streaming build handles malformed input", "[SceneFactory]")
+{
+    for (const char* doc : { "", "{ not json", "{\"id\": \"X\", \"zones\": [", "[1, 2]", "\"scene\"" })
+    {
+        INFO(doc);
+        auto scene = SceneFactory().build(doc);
+        REQUIRE(scene);
+        CHECK(scene->getSceneID().empty());
+        CHECK(scene->getParentSceneID() == "Main");
+        CHECK(scene->getZones().empty());
+    }
+}
+
+TEST_CASE("SceneFactory memory follows the scene, not the document", "[SceneFactory]")
+{
+    // Fields a lores build never reads: hires geometry, actions, unknown keys.
+    json doc = { { "id", "BIG" }, { "lores_image_path", "/lo.png" }, { "zones", json::array() } };
+    for (int z = 0; z < 4; ++z)
+        doc["zones"].push_back({ { "id", "z" + std::to_string(z) },
+                                 { "points", { { 0, 0 }, { 50, 0 }, { 50, 50 } } } });
+    std::string small = doc.dump();
+
+    for (auto& zone : doc["zones"])
+    {
+        json hires = json::array();
+        for (int p = 0; p < 2000; ++p) hires.push_back({ p, p });
+        zone["hires_points"] = hires;
+        zone["action"]       = { { "type", "navigate" }, { "log", json::array({ 1, 2, 3, 4, 5, 6, 7, 8 }) } };
+    }
+    doc["unused"] = json::array({ json::object({ { "a", 1 } }), json::array({ 1, 2 }) });
+    std::string large = doc.dump();
+    REQUIRE(large.size() > 50 * small.size());
+
+    auto allocationsFor = [](const std::string& text)
+    {
+        AllocationCounter allocations;
+        auto scene = SceneFactory(false).build(text);
+        CHECK(scene->getZones().size() == 4);
+        return allocations.count();
+    };
+    CHECK(allocationsFor(large) == allocationsFor(small));
+}
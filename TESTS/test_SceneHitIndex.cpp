@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+#include "SCENE/Scene.h"
+#include "SCENE/SceneFactory.h"
+#include "SCENE/SceneHitIndex.h"
+#include "UTIL/TestFileOperator.h"
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace fs = std::filesystem;
+
+// First-match linear scan, the reference the index must reproduce.
+static int scanZones(const ZoneTable& zones, int x, int y)
+{
+    for (size_t i = 0; i < zones.size(); ++i)
+        if (zones.containsPoint(i, x, y))
+            return (int)i;
+    return SceneHitIndex::k_NoZone;
+}
+
+// Compares index lookups against the scan over the whole game space plus a
+// margin, returning the number of mismatching points.
+static int countMismatches(const ZoneTable& zones)
+{
+    SceneHitIndex index;
+    index.build(zones);
+    int mismatches = 0;
+    for (int y = -4; y <= SceneHitIndex::k_MaxY + 4; ++y)
+        for (int x = -4; x <= SceneHitIndex::k_MaxX + 4; ++x)
+        {
+            int hit = index.lookup(x, y);
+            if (hit == SceneHitIndex::k_NotIndexed) continue;
+            if (hit != scanZones(zones, x, y)) mismatches++;
+        }
+    return mismatches;
+}
+
+TEST_CASE("SceneHitIndex matches the first-match scan for every KSC_DATA scene", "[SceneHitIndex]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+
+    int scenes = 0;
+    for (const auto& entry : fs::recursive_directory_iterator("KSC_DATA"))
+    {
+        if (entry.path().extension() != ".json") continue;
+        std::ifstream f(entry.path());
+        nlohmann::json j = nlohmann::json::parse(f, nullptr, false);
+        if (j.is_discarded() || !j.contains("zones")) continue;
+        std::string path = "/" + fs::relative(entry.path(), "KSC_DATA").generic_string();
+
+        for (bool hires : { false, true })
+        {
+            auto scene = SceneFactory(hires).build(fileOp.load(path));
+            REQUIRE(scene);
+            CHECK(scene->hasHitIndex());
+            INFO(path << (hires ? " (hires)" : " (lores)"));
+            CHECK(countMismatches(scene->getZones()) == 0);
+        }
+        scenes++;
+    }
+    CHECK(scenes > 0);
+}
+
+TEST_CASE("SceneHitIndex matches the scan for overlapping and irregular polygons", "[SceneHitIndex]")
+{
+    Scene scene("Synthetic");
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> coord(-40, 360);
+    std::uniform_int_distribution<int> vertexCount(3, 9);
+
+    ZoneTable zones;
+    for (int z = 0; z < 24; ++z)
+    {
+        Zone::Polygon poly;
+        int n = vertexCount(rng);
+        int minX = 320, minY = 240, maxX = 0, maxY = 0;
+        for (int v = 0; v < n; ++v)
+        {
+            int px = coord(rng), py = coord(rng) * 240 / 320;
+            poly.push_back({ px, py });
+            minX = std::min(minX, px); minY = std::min(minY, py);
+            maxX = std::max(maxX, px); maxY = std::max(maxY, py);
+        }
+        Zone zone(scene, Zone::Bounds(minX, minY, maxX - minX, maxY - minY), "Z" + std::to_string(z));
+        // Every third zone stays a plain rectangle.
+        if (z % 3 != 0) zone.setPolygon(std::move(poly));
+        zones.add(zone);
+    }
+    CHECK(countMismatches(zones) == 0);
+}
+
+TEST_CASE("Scene hit-testing uses the index and falls back outside it", "[SceneHitIndex]")
+{
+    Scene scene("Scene");
+    scene.addZone(Zone(scene, Zone::Bounds(0, 0, 100, 100),     "Near", "/near.json"));
+    scene.addZone(Zone(scene, Zone::Bounds(300, 200, 100, 100), "Edge", "/edge.json"));
+    CHECK_FALSE(scene.hasHitIndex());
+
+    scene.buildHitIndex();
+    REQUIRE(scene.hasHitIndex());
+    CHECK(scene.getInterceptingZoneID(50, 50)       == "Near");
+    CHECK(scene.getInterceptingZoneTarget(320, 240) == "/edge.json");
+    CHECK(scene.getInterceptingZoneID(200, 150)     == "");
+
+    SECTION("points outside the game space fall back to scanning")
+    {
+        CHECK(scene.getInterceptingZoneID(390, 290) == "Edge");
+        CHECK(scene.getInterceptingZoneID(-1, 50)   == "");
+    }
+
+    SECTION("adding a zone discards the stale index")
+    {
+        scene.addZone(Zone(scene, Zone::Bounds(150, 100, 100, 100), "Late"));
+        CHECK_FALSE(scene.hasHitIndex());
+        CHECK(scene.getInterceptingZoneID(200, 150) == "Late");
+    }
+}
@@ -0,0 +1,164 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GAME_RUNNER/GameRunner.h"
+#include "SCENE/Scene.h"
+#include "SCENE_CACHE/SceneCache.h"
+#include "SCENE_CACHE/ScenePrefetcher.h"
+#include "UTIL/CountingFileOperator.h"
+#include "UTIL/NullGraphicsRenderer.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+static const std::string k_AveryRootPath    = "/LOCATIONS/AVERY/ROOT/Avery_Full.json";
+static const std::string k_AveryDeskPath    = "/LOCATIONS/AVERY/DESK/MAIN/Avery_Desk.json";
+static const std::string k_AveryCabinetPath = "/LOCATIONS/AVERY/CABLE_CABINET/MAIN/Avery_Cable_Cabinet.json";
+
+static auto neverSkip = [](const std::string&) { return false; };
+
+TEST_CASE("ScenePrefetcher idle slices build scheduled scenes into the cache", "[ScenePrefetcher]")
+{
+    std::vector<std::string> built;
+    ScenePrefetcher prefetcher([&](const std::string& path)
+    {
+        built.push_back(path);
+        return std::make_shared<Scene>(path);
+    }, false);
+    SceneCache cache(1024 * 1024);
+
+    prefetcher.schedule({ "/A.json", "", "/B.json", "/A.json", "/C.json" }, 2, neverSkip);
+
+    CHECK(prefetcher.runIdleSlice());
+    CHECK(prefetcher.runIdleSlice());
+    CHECK_FALSE(prefetcher.runIdleSlice());
+    prefetcher.drainInto(cache);
+
+    // Empty and duplicate targets are skipped; the budget caps the rest.
+    REQUIRE(built == std::vector<std::string>{ "/A.json", "/B.json" });
+    CHECK(cache.contains("/A.json"));
+    CHECK(cache.contains("/B.json"));
+    CHECK(prefetcher.getStats().completed == 2);
+
+    prefetcher.noteLoaded("/A.json");
+    prefetcher.noteLoaded("/A.json");
+    CHECK(prefetcher.getStats().used == 1);
+}
+
+TEST_CASE("ScenePrefetcher drops work scheduled before an invalidate", "[ScenePrefetcher]")
+{
+    ScenePrefetcher prefetcher([](const std::string& path) { return std::make_shared<Scene>(path); }, false);
+    SceneCache cache(1024 * 1024);
+
+    prefetcher.schedule({ "/A.json", "/B.json" }, 4, neverSkip);
+    prefetcher.runIdleSlice();
+    prefetcher.invalidate();
+    CHECK_FALSE(prefetcher.runIdleSlice()); // /B.json is no longer pending
+    prefetcher.drainInto(cache);
+
+    CHECK_FALSE(cache.contains("/A.json"));
+    CHECK(prefetcher.getStats().dropped == 1);
+
+    // Work scheduled afterwards lands as usual.
+    prefetcher.schedule({ "/A.json" }, 4, neverSkip);
+    prefetcher.runIdleSlice();
+    prefetcher.drainInto(cache);
+    CHECK(cache.contains("/A.json"));
+}
+
+TEST_CASE("ScenePrefetcher stops building scenes the cache declines", "[ScenePrefetcher]")
+{
+    size_t builds = 0;
+    ScenePrefetcher prefetcher([&](const std::string& path)
+    {
+        builds++;
+        return std::make_shared<Scene>(path);
+    }, false);
+    SceneCache cache(1); // smaller than any scene
+
+    prefetcher.schedule({ "/A.json" }, 4, neverSkip);
+    prefetcher.runIdleSlice();
+    prefetcher.drainInto(cache);
+    CHECK_FALSE(cache.contains("/A.json"));
+    CHECK(prefetcher.getStats().completed == 0);
+    CHECK(prefetcher.getStats().dropped   == 1);
+
+    // Revisiting the parent does not rebuild it.
+    prefetcher.schedule({ "/A.json" }, 4, neverSkip);
+    CHECK_FALSE(prefetcher.runIdleSlice());
+    CHECK(builds == 1);
+
+    prefetcher.forgetDeclined();
+    prefetcher.schedule({ "/A.json" }, 4, neverSkip);
+    CHECK(prefetcher.runIdleSlice());
+}
+
+TEST_CASE("ScenePrefetcher does not count an evicted prefetch as used", "[ScenePrefetcher]")
+{
+    ScenePrefetcher prefetcher([](const std::string& path) { return std::make_shared<Scene>(path); }, false);
+    SceneCache cache(1024 * 1024);
+
+    prefetcher.schedule({ "/A.json" }, 4, neverSkip);
+    prefetcher.runIdleSlice();
+    prefetcher.drainInto(cache);
+    REQUIRE(prefetcher.getStats().completed == 1);
+
+    // Evicted, then built on demand: the later cache hit is not the prefetch's.
+    cache.clear();
+    prefetcher.noteBuilt("/A.json");
+    cache.insert("/A.json", std::make_shared<Scene>("/A.json"));
+    prefetcher.noteLoaded("/A.json");
+    CHECK(prefetcher.getStats().used == 0);
+}
+
+TEST_CASE("GameRunner idle prefetch makes the next tap a cache hit", "[ScenePrefetcher]")
+{
+    CountingFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    NullGraphicsRenderer renderer;
+    GameRunner runner(fileOp, renderer);
+    runner.enablePrefetch(4, false);
+
+    runner.loadScene(k_AveryRootPath);
+    CHECK(fileOp.loadCount(k_AveryDeskPath) == 0);
+
+    runner.idle();
+    runner.idle();
+    CHECK(fileOp.loadCount(k_AveryDeskPath)    == 1);
+    CHECK(fileOp.loadCount(k_AveryCabinetPath) == 1);
+
+    runner.loadScene(k_AveryDeskPath);
+    CHECK(fileOp.loadCount(k_AveryDeskPath) == 1);
+
+    auto stats = runner.getPrefetchStats();
+    CHECK(stats.completed == 2);
+    CHECK(stats.used      == 1);
+
+    SECTION("budget limits prefetches per scene")
+    {
+        runner.enablePrefetch(1, false);
+        runner.loadScene(k_AveryRootPath);
+        CHECK(runner.getPrefetchStats().scheduled <= 1);
+    }
+}
+
+TEST_CASE("GameRunner background prefetch builds targets on a worker thread", "[ScenePrefetcher]")
+{
+    CountingFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    NullGraphicsRenderer renderer;
+    GameRunner runner(fileOp, renderer);
+    runner.enablePrefetch(4, true);
+
+    runner.loadScene(k_AveryRootPath);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (runner.getPrefetchStats().completed < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        runner.idle();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(runner.getPrefetchStats().completed == 2);
+
+    runner.loadScene(k_AveryCabinetPath);
+    CHECK(fileOp.loadCount(k_AveryCabinetPath) == 1);
+    CHECK(runner.getPrefetchStats().used == 1);
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "SCENE/SceneFactory.h"
+#include "SCENE_VIEW/SceneView.h"
+#include "UTIL/AllocationCounter.h"
+#include "UTIL/TestFileOperator.h"
+#include "UTIL/NullGraphicsRenderer.h"
+
+static const std::string k_AveryRootPath = "/LOCATIONS/AVERY/ROOT/Avery_Full.json";
+static const std::string k_FileMenuPath  = "/LOCATIONS/AVERY/DESK/COMPUTER/FILE_MENU/File_Menu.json";
+
+// Touches every argument the way a real backend would, without allocating.
+class TouchingGraphicsRenderer : public NullGraphicsRenderer
+{
+public:
+    size_t calls = 0;
+    void drawImage(std::string_view path) override                          { calls += path.size(); }
+    void drawButton(std::string_view label, int, int, int, int) override    { calls += label.size(); }
+    void drawRect(int, int, int, int) override                              { calls++; }
+    void drawPolygon(const int16_t*, const int16_t*, int count) override    { calls += count; }
+};
+
+TEST_CASE("SceneView draw allocates nothing per frame", "[SceneView]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    auto scene = SceneFactory().build(fileOp.load(k_AveryRootPath));
+    auto menu  = SceneFactory().build(fileOp.load(k_FileMenuPath));
+    REQUIRE(scene);
+    REQUIRE(menu);
+
+    TouchingGraphicsRenderer renderer;
+    SceneView view(renderer);
+
+    // Warm-up frame, then measure steady state.
+    view.draw(*scene, true, true);
+    view.drawMenu(*menu);
+
+    AllocationCounter counter;
+    for (int frame = 0; frame < 100; ++frame)
+    {
+        view.draw(*scene, true, true);
+        view.draw(*menu, false);
+        view.drawMenu(*menu);
+    }
+    CHECK(counter.count() == 0);
+    CHECK(renderer.calls > 0);
+}
+
+// Records which image calls a frame makes.
+class ImageRecordingRenderer : public NullGraphicsRenderer
+{
+public:
+    std::vector<std::string> images;
+    void drawImage(std::string_view path) override { images.emplace_back(path); }
+    void drawProgressiveImage(std::string_view path, std::string_view loresPath) override
+    {
+        images.push_back(std::string(path) + " <- " + std::string(loresPath));
+    }
+};
+
+TEST_CASE("SceneView passes hi-res scenes their lores image to show first", "[SceneView]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    std::string json  = fileOp.load(k_AveryRootPath);
+    auto        lores = SceneFactory(false).build(json);
+    auto        hires = SceneFactory(true).build(json);
+    REQUIRE(lores);
+    REQUIRE(hires);
+    REQUIRE(hires->getPrimaryPath() != lores->getPrimaryPath());
+    CHECK(hires->getLoresPath() == lores->getPrimaryPath());
+    CHECK(lores->getLoresPath().empty());
+
+    ImageRecordingRenderer renderer;
+    SceneView view(renderer);
+    view.draw(*lores, false);
+    view.draw(*hires, false);
+    CHECK(renderer.images == std::vector<std::string>{
+        std::string(lores->getPrimaryPath()),
+        std::string(hires->getPrimaryPath()) + " <- " + std::string(lores->getPrimaryPath()) });
+}
+
+TEST_CASE("SceneView draw benchmark", "[SceneView][!benchmark]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    auto scene = SceneFactory().build(fileOp.load(k_AveryRootPath));
+    REQUIRE(scene);
+
+    TouchingGraphicsRenderer renderer;
+    SceneView view(renderer);
+    view.draw(*scene, true, true);
+
+    size_t allocations = 0;
+    BENCHMARK("draw with overlay and zone display")
+    {
+        AllocationCounter counter;
+        view.draw(*scene, true, true);
+        allocations += counter.count();
+        return renderer.calls;
+    };
+    CHECK(allocations == 0);
+}
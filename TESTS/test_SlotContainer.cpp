@@ -0,0 +1,55 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GAME_STATE/SlotContainer.h"
+
+TEST_CASE("SlotContainer packs named entries and reads them back", "[SlotContainer]")
+{
+    std::string binary("\0\x01\xFF note", 8);
+    std::string bytes = SlotContainer::pack({ { "Game_State.json", "{ \"currentMode\": \"locations\" }" },
+                                              { "NOTES_STATE/AVERY/Avery_Note.md", binary },
+                                              { "EMPTY", "" } });
+    REQUIRE(SlotContainer::isContainer(bytes));
+
+    SlotContainer container;
+    REQUIRE(container.open(bytes));
+    CHECK(container.names() == std::vector<std::string>{ "EMPTY", "Game_State.json",
+                                                         "NOTES_STATE/AVERY/Avery_Note.md" });
+    CHECK(container.get("Game_State.json") == "{ \"currentMode\": \"locations\" }");
+    CHECK(container.get("NOTES_STATE/AVERY/Avery_Note.md") == binary);
+    CHECK(container.contains("EMPTY"));
+    CHECK(container.get("EMPTY").empty());
+    CHECK_FALSE(container.contains("Delta.json"));
+
+    // Payloads follow the table of contents back to back, in name order.
+    std::string_view state = container.get("Game_State.json");
+    std::string_view note  = container.get("NOTES_STATE/AVERY/Avery_Note.md");
+    CHECK(state.data() + state.size() == note.data());
+    CHECK(bytes.compare(bytes.size() - note.size(), note.size(), binary) == 0);
+}
+
+TEST_CASE("SlotContainer rejects damaged bytes", "[SlotContainer]")
+{
+    std::string bytes = SlotContainer::pack({ { "Game_State.json", "{}" }, { "NOTES_STATE/A/A.md", "text" } });
+
+    SlotContainer container;
+    REQUIRE(container.open(bytes));
+
+    SECTION("a torn write")
+    {
+        CHECK_FALSE(container.open(bytes.substr(0, bytes.size() - 1)));
+    }
+
+    SECTION("a flipped payload byte")
+    {
+        bytes.back() ^= 0x20;
+        CHECK_FALSE(container.open(bytes));
+    }
+
+    SECTION("something else entirely")
+    {
+        CHECK_FALSE(SlotContainer::isContainer("{ \"currentMode\": \"locations\" }"));
+        CHECK_FALSE(container.open(""));
+    }
+
+    CHECK(container.names().empty());
+    CHECK_FALSE(container.contains("Game_State.json"));
+}
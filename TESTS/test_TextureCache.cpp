@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include "GRAPHICS_RENDERER/TextureCache.h"
+#include "GAME_RUNNER/GameRunner.h"
+#include "SCENE/Scene.h"
+#include "UTIL/TestFileOperator.h"
+#include "UTIL/NullGraphicsRenderer.h"
+#include <algorithm>
+
+static const std::string k_AveryRootPath    = "/LOCATIONS/AVERY/ROOT/Avery_Full.json";
+static const std::string k_AveryDeskPath    = "/LOCATIONS/AVERY/DESK/MAIN/Avery_Desk.json";
+static const std::string k_AveryCabinetPath = "/LOCATIONS/AVERY/CABLE_CABINET/MAIN/Avery_Cable_Cabinet.json";
+
+// A stand-in GPU handle: the id of the "upload".
+struct FakeTexture
+{
+    int id = 0;
+};
+
+struct ReleaseLog
+{
+    std::vector<int> released;
+    TextureCache<FakeTexture>::Release release()
+    {
+        return [this](FakeTexture& tex) { released.push_back(tex.id); };
+    }
+};
+
+TEST_CASE("TextureCache evicts least recently used textures past its budget", "[TextureCache]")
+{
+    ReleaseLog                log;
+    TextureCache<FakeTexture> cache(300, log.release());
+
+    cache.insert("/A.png", { 1 }, 100);
+    cache.insert("/B.png", { 2 }, 100);
+    cache.insert("/C.png", { 3 }, 100);
+    REQUIRE(cache.find("/A.png"));     // A is now the most recent; B the oldest
+    cache.insert("/D.png", { 4 }, 100);
+
+    CHECK(log.released == std::vector<int>{ 2 });
+    CHECK_FALSE(cache.contains("/B.png"));
+    CHECK(cache.find("/A.png")->id == 1);
+    CHECK(cache.find("/B.png") == nullptr);
+
+    auto stats = cache.getStats();
+    CHECK(stats.entries   == 3);
+    CHECK(stats.bytesUsed == 300);
+    CHECK(stats.evictions == 1);
+    CHECK(stats.hits      == 2);
+    CHECK(stats.misses    == 1);
+
+    SECTION("replacing a path releases the old texture")
+    {
+        cache.insert("/A.png", { 5 }, 100);
+        CHECK(log.released == std::vector<int>{ 2, 1 });
+        CHECK(cache.getStats().bytesUsed == 300);
+    }
+
+    SECTION("shrinking the budget evicts now")
+    {
+        cache.setBudget(100);
+        CHECK(cache.getStats().entries == 1);
+        CHECK(cache.contains("/A.png"));
+        CHECK(log.released.size() == 3);
+    }
+
+    SECTION("clear and destruction release everything once")
+    {
+        cache.clear();
+        CHECK(log.released.size() == 4);
+        CHECK(cache.getStats().bytesUsed == 0);
+    }
+}
+
+TEST_CASE("TextureCache keeps pinned and on-screen textures", "[TextureCache]")
+{
+    ReleaseLog log;
+    {
+        TextureCache<FakeTexture> cache(200, log.release());
+        cache.setPinned({ "/Parent.png", "/Child.png" });
+
+        cache.insert("/Parent.png", { 1 }, 100);
+        cache.insert("/Other.png",  { 2 }, 100);
+        cache.insert("/Child.png",  { 3 }, 100);
+        cache.insert("/Scene.png",  { 4 }, 100);
+
+        // Only the unpinned entry goes; the pinned ones hold the cache over budget.
+        CHECK(log.released == std::vector<int>{ 2 });
+        CHECK(cache.getStats().pinned == 2);
+        CHECK(cache.getStats().bytesUsed == 300);
+
+        // Unpinning lets the oldest go at once.
+        cache.setPinned({ "/Child.png" });
+        CHECK(log.released == std::vector<int>{ 2, 1 });
+        CHECK(cache.getStats().bytesUsed == 200);
+
+        // A texture larger than the budget stays while it is on screen.
+        cache.insert("/Huge.png", { 5 }, 1000);
+        CHECK(cache.contains("/Huge.png"));
+        CHECK(cache.contains("/Child.png"));
+        CHECK_FALSE(cache.contains("/Scene.png"));
+    }
+    CHECK(log.released.size() == 5);
+}
+
+// Records the pinned set GameRunner hands the renderer.
+class PinRecordingRenderer : public NullGraphicsRenderer
+{
+public:
+    std::vector<std::vector<std::string>> pins;
+    void pinImages(const std::vector<std::string>& paths) override { pins.push_back(paths); }
+};
+
+static bool pinned(const std::vector<std::string>& pins, std::string_view image)
+{
+    return std::find(pins.begin(), pins.end(), image) != pins.end();
+}
+
+TEST_CASE("GameRunner pins the active scene's parent and children images", "[TextureCache]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    PinRecordingRenderer renderer;
+    GameRunner           runner(fileOp, renderer);
+    runner.enablePrefetch(4, false);
+
+    SceneFactory factory;
+    auto root    = factory.build(fileOp.load(k_AveryRootPath));
+    auto desk    = factory.build(fileOp.load(k_AveryDeskPath));
+    auto cabinet = factory.build(fileOp.load(k_AveryCabinetPath));
+
+    runner.loadScene(k_AveryRootPath);
+    REQUIRE_FALSE(renderer.pins.empty());
+    CHECK(renderer.pins.back() == std::vector<std::string>{ std::string(root->getPrimaryPath()) });
+
+    // Children join the set as the prefetcher builds them.
+    runner.idle();
+    runner.idle();
+    runner.idle();
+    CHECK(pinned(renderer.pins.back(), desk->getPrimaryPath()));
+    CHECK(pinned(renderer.pins.back(), cabinet->getPrimaryPath()));
+
+    // From a child, the root is the parent.
+    runner.loadScene(k_AveryCabinetPath);
+    CHECK(renderer.pins.back().front() == cabinet->getPrimaryPath());
+    CHECK(pinned(renderer.pins.back(), root->getPrimaryPath()));
+
+    // Once prefetch settles, an unchanged set is not passed again.
+    for (int i = 0; i < 8; ++i) runner.idle();
+    size_t calls = renderer.pins.size();
+    runner.idle();
+    runner.loadScene(k_AveryCabinetPath);
+    CHECK(renderer.pins.size() == calls);
+}
+
+TEST_CASE("GameRunner pins a hi-res scene's lores image with it", "[TextureCache]")
+{
+    TestFileOperator fileOp;
+    fileOp.diskRoot = "KSC_DATA";
+    PinRecordingRenderer renderer;
+    GameRunner           runner(fileOp, renderer, "locations", "", "", true);
+
+    auto root = SceneFactory(true).build(fileOp.load(k_AveryRootPath));
+    REQUIRE_FALSE(root->getLoresPath().empty());
+
+    runner.loadScene(k_AveryRootPath);
+    REQUIRE_FALSE(renderer.pins.empty());
+    CHECK(renderer.pins.back() == std::vector<std::string>{ std::string(root->getPrimaryPath()),
+                                                            std::string(root->getLoresPath()) });
+}
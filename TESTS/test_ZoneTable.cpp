@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+#include "SCENE/Scene.h"
+#include "ZONE/ZoneTable.h"
+#include <random>
+
+TEST_CASE("ZoneTable packs zones and reads them back", "[ZoneTable]")
+{
+    Scene scene("TableScene");
+    Zone rect(scene, Zone::Bounds(10, 20, 100, 50), "Rect", "/rect.json", "", "Open");
+    Zone tri(scene, Zone::Bounds(10, 10, 40, 30), "Tri", "/rect.json", "/NOTES/tri.md");
+    tri.setPolygon({ { 10, 10 }, { 50, 10 }, { 30, 40 } });
+
+    ZoneTable table;
+    table.add(rect);
+    table.add(tri);
+
+    REQUIRE(table.size() == 2);
+
+    SECTION("strings and bounds")
+    {
+        CHECK(table[0].getZoneID()     == "Rect");
+        CHECK(table[0].getSceneID()    == "TableScene");
+        CHECK(table[0].getTarget()     == "/rect.json");
+        CHECK(table[0].getNoteTarget() == "");
+        CHECK(table[0].getLabel()      == "Open");
+        CHECK(table[1].getZoneID()     == "Tri");
+        CHECK(table[1].getNoteTarget() == "/NOTES/tri.md");
+        CHECK(table[0].getBounds().mW  == 100);
+        CHECK(table[1].getBounds().mH  == 30);
+    }
+
+    SECTION("polygons")
+    {
+        CHECK_FALSE(table[0].hasPolygon());
+        REQUIRE(table[1].hasPolygon());
+        CHECK(table[1].getPolygon().toPolygon() == tri.getPolygon());
+        CHECK(table[1].getPolygon().x(2) == 30);
+        CHECK(table[1].getPolygon().y(2) == 40);
+    }
+
+    SECTION("repeated strings are interned once")
+    {
+        CHECK(table[0].getTarget().data() == table[1].getTarget().data());
+        CHECK(table[0].getSceneID().data() == table[1].getSceneID().data());
+    }
+
+    SECTION("many strings, added out of order, keep their own indices")
+    {
+        // Descending, then repeated, ids exercise inserts before existing entries.
+        for (int i = 500; i > 0; --i)
+            table.add(Zone(scene, Zone::Bounds(0, 0, 1, 1), "Zone" + std::to_string(i), "/rect.json"));
+        for (int i = 1; i <= 500; i += 7)
+            table.add(Zone(scene, Zone::Bounds(0, 0, 1, 1), "Zone" + std::to_string(i)));
+
+        REQUIRE(table.size() == 2 + 500 + 72);
+        for (int i = 500; i > 0; --i)
+            REQUIRE(table[2 + 500 - i].getZoneID() == "Zone" + std::to_string(i));
+        CHECK(table[2 + 500].getZoneID().data() == table[2 + 499].getZoneID().data()); // "Zone1"
+        CHECK(table[2 + 500].getTarget().empty());
+        CHECK(table[0].getZoneID() == "Rect");
+    }
+
+    SECTION("iteration visits zones in order")
+    {
+        std::vector<std::string> ids;
+        for (const auto& zone : table)
+            ids.emplace_back(zone.getZoneID());
+        CHECK(ids == std::vector<std::string>{ "Rect", "Tri" });
+    }
+}
+
+TEST_CASE("ZoneTable containsPoint matches Zone containsPoint", "[ZoneTable]")
+{
+    Scene scene("Synthetic");
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> coord(-20, 340);
+    std::uniform_int_distribution<int> vertexCount(3, 12);
+
+    std::vector<Zone> zones;
+    ZoneTable table;
+    for (int z = 0; z < 16; ++z)
+    {
+        Zone::Polygon poly;
+        int n = vertexCount(rng);
+        for (int v = 0; v < n; ++v)
+            poly.push_back({ coord(rng), coord(rng) * 3 / 4 });
+        Zone zone(scene, Zone::Bounds(coord(rng) / 2, coord(rng) / 2, 200, 150), "Z" + std::to_string(z));
+        if (z % 4 != 0) zone.setPolygon(std::move(poly));
+        table.add(zone);
+        zones.push_back(std::move(zone));
+    }
+
+    int mismatches = 0;
+    for (size_t i = 0; i < zones.size(); ++i)
+        for (int y = -10; y <= 250; y += 3)
+            for (int x = -10; x <= 330; x += 3)
+                if (table.containsPoint(i, x, y) != zones[i].containsPoint(x, y))
+                    mismatches++;
+    CHECK(mismatches == 0);
+}